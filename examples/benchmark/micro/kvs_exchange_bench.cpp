@@ -0,0 +1,222 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "atl/util/pm/pmi_resizable_rt/pmi_resizable_simple_internal.h"
+
+/*
+   startup address exchange over local internal KVS: every rank process publishes
+   ep_count fake EP names and then reads names of all ranks,
+   compares one KVS request per name with single bulk request per rank,
+   usage: kvs_exchange_bench [max_rank_count] [ep_count] [name_len]
+*/
+
+#define DEFAULT_MAX_RANK_COUNT (16)
+#define DEFAULT_EP_COUNT       (4)
+#define DEFAULT_NAME_LEN       (56) /* encoded value has to fit into MAX_KVS_VAL_LENGTH */
+#define PROC_MULTIPLIER        (1000)
+#define BENCH_KEY              "bench-fiaddr"
+#define KVS_ADDR_LEN           (256) /* same as ccl::kvs::address_max_size */
+
+struct rank_result_t {
+    double per_key_usec;
+    double bulk_usec;
+    size_t errors;
+};
+
+static char get_name_byte(int proc_idx, size_t byte_idx) {
+    return (char)((proc_idx * 31 + byte_idx * 7) & 0xFF);
+}
+
+static size_t check_names(const std::vector<int>& proc_idxs,
+                          const std::vector<char>& names,
+                          size_t name_len) {
+    size_t errors = 0;
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        for (size_t byte_idx = 0; byte_idx < name_len; byte_idx++) {
+            if (names[idx * name_len + byte_idx] != get_name_byte(proc_idxs[idx], byte_idx)) {
+                errors++;
+                break;
+            }
+        }
+    }
+    return errors;
+}
+
+static double get_usec(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+static rank_result_t run_rank(int rank_count,
+                              int rank,
+                              std::shared_ptr<internal_kvs> kvs,
+                              size_t ep_count,
+                              size_t name_len) {
+    rank_result_t result{};
+    char key[] = BENCH_KEY;
+    pmi_resizable_simple_internal pmi(rank_count, { rank }, kvs);
+
+    if (pmi.pmrt_init() != ATL_STATUS_SUCCESS) {
+        fprintf(stderr, "rank %d: pmrt_init failed\n", rank);
+        exit(1);
+    }
+
+    std::vector<char> name(name_len);
+    for (size_t ep_idx = 0; ep_idx < ep_count; ep_idx++) {
+        int proc_idx = rank * PROC_MULTIPLIER + ep_idx;
+        for (size_t byte_idx = 0; byte_idx < name_len; byte_idx++) {
+            name[byte_idx] = get_name_byte(proc_idx, byte_idx);
+        }
+        pmi.pmrt_kvs_put(key, proc_idx, name.data(), name_len);
+    }
+
+    std::vector<int> proc_idxs;
+    for (int peer = 0; peer < rank_count; peer++) {
+        for (size_t ep_idx = 0; ep_idx < ep_count; ep_idx++) {
+            proc_idxs.push_back(peer * PROC_MULTIPLIER + ep_idx);
+        }
+    }
+    std::vector<char> names(proc_idxs.size() * name_len);
+
+    pmi.pmrt_barrier();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        pmi.pmrt_kvs_get(key, proc_idxs[idx], names.data() + idx * name_len, name_len);
+    }
+    result.per_key_usec = get_usec(start);
+    result.errors += check_names(proc_idxs, names, name_len);
+
+    std::fill(names.begin(), names.end(), 0);
+
+    pmi.pmrt_barrier();
+    start = std::chrono::steady_clock::now();
+    pmi.pmrt_kvs_get_bulk(key, proc_idxs, names.data(), name_len);
+    result.bulk_usec = get_usec(start);
+    result.errors += check_names(proc_idxs, names, name_len);
+
+    pmi.pmrt_barrier();
+    return result;
+}
+
+/* rank 0 runs main KVS server, other ranks are forked before any KVS thread is started */
+static void run_case(int rank_count, size_t ep_count, size_t name_len) {
+    int addr_pipe[2], result_pipe[2];
+    if (pipe(addr_pipe) || pipe(result_pipe)) {
+        perror("pipe");
+        exit(1);
+    }
+
+    std::vector<pid_t> pids;
+    for (int rank = 1; rank < rank_count; rank++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            std::vector<char> addr(KVS_ADDR_LEN);
+            if (read(addr_pipe[0], addr.data(), addr.size()) != (ssize_t)addr.size()) {
+                exit(1);
+            }
+            std::shared_ptr<internal_kvs> kvs(new internal_kvs());
+            kvs->kvs_init(addr.data());
+            rank_result_t result = run_rank(rank_count, rank, kvs, ep_count, name_len);
+            if (write(result_pipe[1], &result, sizeof(result)) != sizeof(result)) {
+                exit(1);
+            }
+            exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    std::vector<char> addr(KVS_ADDR_LEN);
+    std::shared_ptr<internal_kvs> kvs(new internal_kvs());
+    kvs->kvs_main_server_address_reserve(addr.data());
+    kvs->kvs_init(addr.data());
+    for (int rank = 1; rank < rank_count; rank++) {
+        if (write(addr_pipe[1], addr.data(), addr.size()) != (ssize_t)addr.size()) {
+            exit(1);
+        }
+    }
+
+    rank_result_t max_result = run_rank(rank_count, 0, kvs, ep_count, name_len);
+    for (int rank = 1; rank < rank_count; rank++) {
+        rank_result_t result;
+        if (read(result_pipe[0], &result, sizeof(result)) != sizeof(result)) {
+            exit(1);
+        }
+        max_result.per_key_usec = std::max(max_result.per_key_usec, result.per_key_usec);
+        max_result.bulk_usec = std::max(max_result.bulk_usec, result.bulk_usec);
+        max_result.errors += result.errors;
+    }
+
+    /* KVS server has to outlive clients */
+    for (auto pid : pids) {
+        waitpid(pid, nullptr, 0);
+    }
+
+    printf("%10d %10zu %16.1f %16.1f %10.2f %10s\n",
+           rank_count,
+           rank_count * ep_count,
+           max_result.per_key_usec,
+           max_result.bulk_usec,
+           max_result.per_key_usec / max_result.bulk_usec,
+           max_result.errors ? "FAILED" : "PASSED");
+    fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    int max_rank_count = (argc > 1) ? atoi(argv[1]) : DEFAULT_MAX_RANK_COUNT;
+    size_t ep_count = (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_EP_COUNT;
+    size_t name_len = (argc > 3) ? strtoul(argv[3], nullptr, 10) : DEFAULT_NAME_LEN;
+
+    if (max_rank_count < 2 || ep_count == 0 || ep_count >= PROC_MULTIPLIER ||
+        name_len * 2 >= MAX_KVS_VAL_LENGTH) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    printf("%10s %10s %16s %16s %10s %10s\n",
+           "ranks",
+           "names",
+           "per_key_usec",
+           "bulk_usec",
+           "speedup",
+           "check");
+    fflush(stdout);
+
+    for (int rank_count = 2; rank_count <= max_rank_count; rank_count *= 2) {
+        /* separate process per case to get fresh KVS server */
+        pid_t pid = fork();
+        if (pid == 0) {
+            run_case(rank_count, ep_count, name_len);
+            exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            fprintf(stderr, "case with %d ranks failed\n", rank_count);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "atl/util/pm/pmi_resizable_rt/pmi_resizable/kvs/internal_kvs_server.hpp"
+
+/*
+   load test for internal KVS server: each client thread opens own connection
+   and goes through put, batch put, get, batch get and barrier phases,
+   phases are separated by KVS barrier and timed by client 0,
+   usage: kvs_server_load_bench [client_count] [keys_per_client] [peers_per_client]
+*/
+
+#define DEFAULT_CLIENT_COUNT     (2000)
+#define DEFAULT_KEYS_PER_CLIENT  (4)
+#define DEFAULT_PEERS_PER_CLIENT (4)
+#define BARRIER_ITERS            (10)
+#define KVS_ADDR_LEN             (256)
+
+#define BENCH_BARRIER   "bench_barrier"
+#define BENCH_NAME      "bench_name"
+#define BENCH_NAME_BULK "bench_name_bulk"
+
+enum phase_t { PHASE_PUT, PHASE_PUT_BATCH, PHASE_GET, PHASE_GET_BATCH, PHASE_BARRIER, PHASE_COUNT };
+
+static const char* phase_names[PHASE_COUNT] = { "put", "put_batch", "get", "get_batch", "barrier" };
+
+struct bench_config {
+    size_t client_count;
+    size_t keys_per_client;
+    size_t peers_per_client;
+    std::string host;
+    std::string port;
+};
+
+static std::atomic<size_t> errors{ 0 };
+static double phase_usec[PHASE_COUNT];
+
+static std::string get_key(size_t client_idx, size_t key_idx) {
+    return std::to_string(client_idx) + "-" + std::to_string(key_idx);
+}
+
+static std::string get_val(size_t client_idx, size_t key_idx) {
+    return "val-" + std::to_string(client_idx * 7919 + key_idx);
+}
+
+static int connect_to_server(const bench_config& config) {
+    struct addrinfo hints {};
+    struct addrinfo* res = nullptr;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(config.host.c_str(), config.port.c_str(), &hints, &res) || !res) {
+        return -1;
+    }
+
+    int sock = socket(res->ai_family, SOCK_STREAM, 0);
+    while (sock >= 0 && connect(sock, res->ai_addr, res->ai_addrlen) < 0) {
+        if (errno != EINTR && errno != EAGAIN && errno != ECONNREFUSED) {
+            close(sock);
+            sock = -1;
+        }
+    }
+    freeaddrinfo(res);
+
+    if (sock >= 0) {
+        int nodelay = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+    return sock;
+}
+
+static bool request(int sock, const kvs_msg_t& msg, kvs_msg_t* answer = nullptr) {
+    if (kvs_msg_send(sock, msg) != KVS_STATUS_SUCCESS)
+        return false;
+    if (answer && kvs_msg_recv(sock, *answer) != KVS_STATUS_SUCCESS)
+        return false;
+    return true;
+}
+
+static bool barrier(int sock) {
+    kvs_msg_t answer;
+    return request(sock, kvs_msg_t(AM_BARRIER, { BENCH_BARRIER, "", "" }), &answer);
+}
+
+static void run_client(const bench_config& config, size_t client_idx) {
+    int sock = connect_to_server(config);
+    if (sock < 0) {
+        fprintf(stderr, "client %zu: can't connect to server\n", client_idx);
+        errors++;
+        return;
+    }
+
+    bool is_ok = request(sock,
+                         kvs_msg_t(AM_BARRIER_REGISTER,
+                                   { BENCH_BARRIER, "", std::to_string(config.client_count) })) &&
+                 barrier(sock);
+
+    std::vector<std::string> peer_keys;
+    std::vector<std::string> expected_vals;
+    for (size_t peer = 1; peer <= config.peers_per_client; peer++) {
+        size_t peer_idx = (client_idx + peer) % config.client_count;
+        for (size_t key_idx = 0; key_idx < config.keys_per_client; key_idx++) {
+            peer_keys.push_back(get_key(peer_idx, key_idx));
+            expected_vals.push_back(get_val(peer_idx, key_idx));
+        }
+    }
+
+    for (int phase = 0; phase < PHASE_COUNT && is_ok; phase++) {
+        auto start = std::chrono::steady_clock::now();
+        switch (phase) {
+            case PHASE_PUT:
+                for (size_t key_idx = 0; key_idx < config.keys_per_client && is_ok; key_idx++) {
+                    is_ok = request(sock,
+                                    kvs_msg_t(AM_PUT,
+                                              { BENCH_NAME,
+                                                get_key(client_idx, key_idx),
+                                                get_val(client_idx, key_idx) }));
+                }
+                break;
+            case PHASE_PUT_BATCH: {
+                kvs_msg_t msg(AM_PUT_BATCH, { BENCH_NAME_BULK });
+                for (size_t key_idx = 0; key_idx < config.keys_per_client; key_idx++) {
+                    msg.fields.push_back(get_key(client_idx, key_idx));
+                    msg.fields.push_back(get_val(client_idx, key_idx));
+                }
+                is_ok = request(sock, msg);
+                break;
+            }
+            case PHASE_GET:
+                for (size_t idx = 0; idx < peer_keys.size() && is_ok; idx++) {
+                    kvs_msg_t answer;
+                    is_ok = request(
+                        sock, kvs_msg_t(AM_GET_VAL, { BENCH_NAME, peer_keys[idx] }), &answer);
+                    if (is_ok &&
+                        (answer.fields.size() != 1 || answer.fields[0] != expected_vals[idx]))
+                        errors++;
+                }
+                break;
+            case PHASE_GET_BATCH: {
+                kvs_msg_t msg(AM_GET_BATCH, { BENCH_NAME_BULK });
+                msg.fields.insert(msg.fields.end(), peer_keys.begin(), peer_keys.end());
+                kvs_msg_t answer;
+                is_ok = request(sock, msg, &answer);
+                if (is_ok && answer.fields != expected_vals)
+                    errors++;
+                break;
+            }
+            case PHASE_BARRIER:
+                for (size_t iter = 0; iter < BARRIER_ITERS - 1 && is_ok; iter++) {
+                    is_ok = barrier(sock);
+                }
+                break;
+        }
+        is_ok = is_ok && barrier(sock);
+        if (client_idx == 0) {
+            phase_usec[phase] = std::chrono::duration<double, std::micro>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+        }
+    }
+
+    if (!is_ok) {
+        fprintf(stderr, "client %zu: request failed\n", client_idx);
+        errors++;
+    }
+    close(sock);
+}
+
+int main(int argc, char** argv) {
+    bench_config config;
+    config.client_count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : DEFAULT_CLIENT_COUNT;
+    config.keys_per_client = (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_KEYS_PER_CLIENT;
+    config.peers_per_client = (argc > 3) ? strtoul(argv[3], nullptr, 10) : DEFAULT_PEERS_PER_CLIENT;
+
+    if (config.client_count == 0 || config.peers_per_client > config.client_count) {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    std::vector<char> addr(KVS_ADDR_LEN);
+    internal_kvs kvs;
+    if (kvs.kvs_main_server_address_reserve(addr.data()) != KVS_STATUS_SUCCESS ||
+        kvs.kvs_init(addr.data()) != KVS_STATUS_SUCCESS) {
+        fprintf(stderr, "can't start kvs server\n");
+        return 1;
+    }
+
+    /* address is in <ip>_<port> format, port is kept in network byte order */
+    std::string addr_str(addr.data());
+    size_t delim = addr_str.rfind('_');
+    config.host = addr_str.substr(0, delim);
+    config.port = std::to_string(ntohs(strtoul(addr_str.c_str() + delim + 1, nullptr, 10)));
+
+    printf("clients %zu, keys_per_client %zu, peers_per_client %zu, server %s\n",
+           config.client_count,
+           config.keys_per_client,
+           config.peers_per_client,
+           (config.host + ":" + config.port).c_str());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    clients.reserve(config.client_count);
+    for (size_t client_idx = 0; client_idx < config.client_count; client_idx++) {
+        clients.emplace_back(run_client, std::cref(config), client_idx);
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    double total_usec =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    size_t phase_ops[PHASE_COUNT] = {
+        config.client_count * config.keys_per_client,
+        config.client_count,
+        config.client_count * config.keys_per_client * config.peers_per_client,
+        config.client_count,
+        BARRIER_ITERS,
+    };
+
+    printf("%12s %12s %16s %16s\n", "phase", "requests", "usec", "requests/sec");
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        printf("%12s %12zu %16.1f %16.1f\n",
+               phase_names[phase],
+               phase_ops[phase],
+               phase_usec[phase],
+               phase_ops[phase] * 1e6 / phase_usec[phase]);
+    }
+    printf("total %.1f usec, %s\n", total_usec, errors ? "FAILED" : "PASSED");
+
+    kvs.kvs_finalize();
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "oneapi/ccl.hpp"
+#include "common/utils/memcpy.hpp"
+
+/*
+   reports bandwidth of ccl::memcpy strategies,
+   usage: memcpy_bench [max_bytes] [min_bytes]
+*/
+
+#define ALIGNMENT        (64)
+#define BYTES_PER_POINT  (1024UL * 1024 * 1024)
+#define MIN_ITERS        (4)
+#define DEFAULT_MIN_SIZE (4096UL)
+#define DEFAULT_MAX_SIZE (256UL * 1024 * 1024)
+
+typedef void (*memcpy_fn)(void*, const void*, size_t);
+
+static void memcpy_auto(void* dst, const void* src, size_t size) {
+    ccl::memcpy(dst, src, size, ccl::memcpy_strategy::automatic);
+}
+
+static void memcpy_regular(void* dst, const void* src, size_t size) {
+    ccl::memcpy(dst, src, size, ccl::memcpy_strategy::regular);
+}
+
+double measure(memcpy_fn fn, char* dst, const char* src, size_t size) {
+    size_t iters = std::max(BYTES_PER_POINT / size, size_t(MIN_ITERS));
+
+    /* warmup */
+    fn(dst, src, size);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t iter = 0; iter < iters; iter++) {
+        fn(dst, src, size);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double sec = std::chrono::duration<double>(end - start).count();
+    return (double)size * iters / sec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_size = (argc > 1) ? strtoul(argv[1], nullptr, 10) : DEFAULT_MAX_SIZE;
+    size_t min_size = (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_MIN_SIZE;
+
+    if (!min_size || min_size > max_size) {
+        printf("unexpected sizes: min %zu, max %zu\n", min_size, max_size);
+        return -1;
+    }
+
+    /* sets nontemporal threshold from LLC size or CCL_MEMCPY_NONTEMPORAL_THRESHOLD */
+    ccl::init();
+
+    char* src = static_cast<char*>(aligned_alloc(ALIGNMENT, max_size + ALIGNMENT));
+    char* dst = static_cast<char*>(aligned_alloc(ALIGNMENT, max_size + ALIGNMENT));
+    if (!src || !dst) {
+        printf("failed to allocate %zu bytes\n", max_size);
+        return -1;
+    }
+    memset(src, 1, max_size);
+    memset(dst, 0, max_size);
+
+    std::vector<std::pair<const char*, memcpy_fn>> fns = {
+        { ccl::memcpy_strategy_to_str(ccl::memcpy_strategy::regular), memcpy_regular },
+        { ccl::memcpy_strategy_to_str(ccl::memcpy_strategy::nontemporal),
+          ccl::memcpy_nontemporal },
+        { ccl::memcpy_strategy_to_str(ccl::memcpy_strategy::automatic), memcpy_auto }
+    };
+
+    printf("nontemporal threshold: %zu bytes\n", ccl::memcpy_get_nontemporal_threshold());
+    printf("%14s", "#bytes");
+    for (auto& fn : fns) {
+        printf("%14s", fn.first);
+    }
+    printf("    (GB/s)\n");
+
+    for (size_t size = min_size; size <= max_size; size *= 2) {
+        printf("%14zu", size);
+        for (auto& fn : fns) {
+            printf("%14.2f", measure(fn.second, dst, src, size));
+        }
+        printf("\n");
+    }
+
+    if (memcmp(dst, src, max_size)) {
+        printf("FAILED: unexpected data in destination buffer\n");
+        return -1;
+    }
+
+    free(src);
+    free(dst);
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/utils/mpsc_queue.hpp"
+#include "common/utils/spinlock.hpp"
+
+/*
+   stress test for schedule submission: N submitter threads add elems
+   while single progress thread scans the active elems and completes them,
+   compares spinlock guarded vector (previous bin storage) with lock-free intake,
+   usage: sched_queue_bench [max_submitter_count] [elems_per_submitter]
+*/
+
+#define DEFAULT_MAX_SUBMITTER_COUNT    (8)
+#define DEFAULT_ELEMS_PER_SUBMITTER    (200000)
+#define PROGRESS_ITERS_BEFORE_COMPLETE (4)
+
+struct elem_t {
+    elem_t* next = nullptr;
+    size_t progress_iters = 0;
+};
+
+/* every call takes lock as ccl_sched_list did */
+class locked_list {
+public:
+    void add(elem_t* elem) {
+        std::lock_guard<ccl_spinlock> lock(guard);
+        elems.push_back(elem);
+    }
+    size_t size() {
+        std::lock_guard<ccl_spinlock> lock(guard);
+        return elems.size();
+    }
+    elem_t* get(size_t idx) {
+        std::lock_guard<ccl_spinlock> lock(guard);
+        return elems[idx];
+    }
+    void remove(size_t idx) {
+        std::lock_guard<ccl_spinlock> lock(guard);
+        std::swap(elems[idx], elems.back());
+        elems.pop_back();
+    }
+
+private:
+    ccl_spinlock guard;
+    std::vector<elem_t*> elems;
+};
+
+/* producers push into intake, consumer drains into private vector */
+class intake_list {
+public:
+    void add(elem_t* elem) {
+        intake.push(elem);
+    }
+    size_t size() {
+        intake.drain([this](elem_t* elem) {
+            elems.push_back(elem);
+        });
+        return elems.size();
+    }
+    elem_t* get(size_t idx) {
+        return elems[idx];
+    }
+    void remove(size_t idx) {
+        std::swap(elems[idx], elems.back());
+        elems.pop_back();
+    }
+
+private:
+    ccl_mpsc_queue<elem_t, &elem_t::next> intake;
+    std::vector<elem_t*> elems;
+};
+
+/* returns millions of completed elems per second */
+template <class list_t>
+double measure(size_t submitter_count, size_t elems_per_submitter) {
+    list_t list;
+    size_t total_count = submitter_count * elems_per_submitter;
+    std::vector<elem_t> elems(total_count);
+    std::atomic<bool> start_flag{ false };
+
+    std::vector<std::thread> submitters;
+    for (size_t idx = 0; idx < submitter_count; idx++) {
+        submitters.emplace_back([&, idx]() {
+            while (!start_flag.load(std::memory_order_acquire)) {
+            }
+            for (size_t elem_idx = 0; elem_idx < elems_per_submitter; elem_idx++) {
+                list.add(&elems[idx * elems_per_submitter + elem_idx]);
+            }
+        });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    start_flag.store(true, std::memory_order_release);
+
+    size_t completed_count = 0;
+    while (completed_count < total_count) {
+        size_t size = list.size();
+        for (size_t idx = 0; idx < size;) {
+            elem_t* elem = list.get(idx);
+            if (++elem->progress_iters == PROGRESS_ITERS_BEFORE_COMPLETE) {
+                list.remove(idx);
+                size--;
+                completed_count++;
+            }
+            else {
+                idx++;
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (auto& t : submitters) {
+        t.join();
+    }
+
+    for (auto& elem : elems) {
+        if (elem.progress_iters != PROGRESS_ITERS_BEFORE_COMPLETE) {
+            printf("FAILED: unexpected progress_iters %zu\n", elem.progress_iters);
+            exit(-1);
+        }
+    }
+
+    double sec = std::chrono::duration<double>(end - start).count();
+    return total_count / sec / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_submitter_count =
+        (argc > 1) ? strtoul(argv[1], nullptr, 10) : DEFAULT_MAX_SUBMITTER_COUNT;
+    size_t elems_per_submitter =
+        (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_ELEMS_PER_SUBMITTER;
+
+    if (!max_submitter_count || !elems_per_submitter) {
+        printf("unexpected args: submitters %zu, elems %zu\n",
+               max_submitter_count,
+               elems_per_submitter);
+        return -1;
+    }
+
+    printf("%14s%14s%14s    (M elems/s)\n", "#submitters", "spinlock", "intake");
+    for (size_t count = 1; count <= max_submitter_count; count *= 2) {
+        double locked = measure<locked_list>(count, elems_per_submitter);
+        double intake = measure<intake_list>(count, elems_per_submitter);
+        printf("%14zu%14.2f%14.2f\n", count, locked, intake);
+    }
+
+    return 0;
+}
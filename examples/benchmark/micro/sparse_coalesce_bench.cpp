@@ -0,0 +1,198 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "coll/algorithms/sparse_allreduce/sparse_index_map.hpp"
+
+/*
+   compares index coalescing engines of sparse allreduce:
+   std::map with vector of offsets per index (previous implementation)
+   and flat open addressing map with CSR groups and radix sorted output,
+   both produce sorted unique indices with summed value rows,
+   usage: sparse_coalesce_bench [index_count] [value_dim]
+*/
+
+#define DEFAULT_INDEX_COUNT (1000000UL)
+#define DEFAULT_VALUE_DIM   (16UL)
+#define ITERS               (5)
+#define RESERVE_SIZE        (16)
+
+typedef int64_t index_t;
+
+struct result_t {
+    std::vector<index_t> indices;
+    std::vector<float> values;
+};
+
+static void add_row(const float* in, float* inout, size_t dim) {
+    for (size_t k = 0; k < dim; k++) {
+        inout[k] += in[k];
+    }
+}
+
+static void coalesce_map(const std::vector<index_t>& indices,
+                         const std::vector<float>& values,
+                         size_t dim,
+                         result_t& result) {
+    std::map<size_t, std::vector<size_t>> iv_map;
+    for (size_t i = 0; i < indices.size(); i++) {
+        auto it = iv_map.find(indices[i]);
+        if (it == iv_map.end()) {
+            std::vector<size_t> tmp = { i * dim };
+            tmp.reserve(RESERVE_SIZE);
+            iv_map.emplace(indices[i], tmp);
+        }
+        else {
+            it->second.push_back(i * dim);
+        }
+    }
+
+    result.indices.resize(iv_map.size());
+    result.values.resize(iv_map.size() * dim);
+
+    size_t idx = 0;
+    for (auto& it : iv_map) {
+        result.indices[idx] = it.first;
+        float* dst = result.values.data() + idx * dim;
+        std::copy(values.data() + it.second[0], values.data() + it.second[0] + dim, dst);
+        for (size_t k = 1; k < it.second.size(); k++) {
+            add_row(values.data() + it.second[k], dst, dim);
+        }
+        idx++;
+    }
+}
+
+static void coalesce_flat(const std::vector<index_t>& indices,
+                          const std::vector<float>& values,
+                          size_t dim,
+                          result_t& result) {
+    ccl_sparse_index_map iv_map;
+    ccl_sparse_index_groups groups;
+    sparse_group_indices(indices.data(), indices.size(), dim, iv_map, groups);
+
+    std::vector<size_t> positions = iv_map.sorted_positions();
+    result.indices.resize(positions.size());
+    result.values.resize(positions.size() * dim);
+
+    for (size_t idx = 0; idx < positions.size(); idx++) {
+        size_t pos = positions[idx];
+        size_t offset = iv_map.offset(pos);
+        result.indices[idx] = iv_map.key(pos);
+        float* dst = result.values.data() + idx * dim;
+        std::copy(values.data() + offset, values.data() + offset + dim, dst);
+        if (groups.starts.empty())
+            continue;
+        for (size_t k = groups.starts[pos] + 1; k < groups.starts[pos + 1]; k++) {
+            add_row(values.data() + groups.offsets[k], dst, dim);
+        }
+    }
+}
+
+/* returns milliseconds per call */
+template <class fn_t>
+double measure(fn_t fn,
+               const std::vector<index_t>& indices,
+               const std::vector<float>& values,
+               size_t dim,
+               result_t& result) {
+    fn(indices, values, dim, result);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t iter = 0; iter < ITERS; iter++) {
+        fn(indices, values, dim, result);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / ITERS;
+}
+
+/*
+   uniform: few duplicates over large range
+   zipf:    power-law frequencies typical for embedding lookups, ids are scrambled
+   dense:   each index repeats about 16 times
+*/
+static std::vector<index_t> generate(const char* distribution, size_t count) {
+    std::mt19937_64 gen(count);
+    std::uniform_real_distribution<double> real(0.0, 1.0);
+    std::vector<index_t> indices(count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!strcmp(distribution, "uniform")) {
+            indices[i] = gen() % (count * 10);
+        }
+        else if (!strcmp(distribution, "zipf")) {
+            uint64_t rank = static_cast<uint64_t>(std::pow(double(count * 4), real(gen)));
+            indices[i] = (rank * 0x9E3779B97F4A7C15ull) >> 24;
+        }
+        else {
+            indices[i] = gen() % std::max(count / 16, 1UL);
+        }
+    }
+
+    return indices;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : DEFAULT_INDEX_COUNT;
+    size_t dim = (argc > 2) ? strtoul(argv[2], nullptr, 10) : DEFAULT_VALUE_DIM;
+
+    if (!count || !dim) {
+        printf("unexpected args: index_count %zu, value_dim %zu\n", count, dim);
+        return -1;
+    }
+
+    std::vector<float> values(count * dim);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<float>(i % 7);
+    }
+
+    printf("index_count %zu, value_dim %zu\n", count, dim);
+    printf("%12s%12s%14s%14s%10s    (ms per coalesce)\n",
+           "#dist",
+           "#unique",
+           "std::map",
+           "flat",
+           "speedup");
+
+    for (const char* distribution : { "uniform", "zipf", "dense" }) {
+        std::vector<index_t> indices = generate(distribution, count);
+
+        result_t map_result, flat_result;
+        double map_time = measure(coalesce_map, indices, values, dim, map_result);
+        double flat_time = measure(coalesce_flat, indices, values, dim, flat_result);
+
+        if (map_result.indices != flat_result.indices || map_result.values != flat_result.values) {
+            printf("FAILED: results differ for %s distribution\n", distribution);
+            return -1;
+        }
+
+        printf("%12s%12zu%14.2f%14.2f%10.2f\n",
+               distribution,
+               flat_result.indices.size(),
+               map_time,
+               flat_time,
+               map_time / flat_time);
+    }
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "base.hpp"
+
+/*
+ * runs all ranks as threads of a single process, no launcher is needed:
+ * CCL_ATL_TRANSPORT=sim ./sim_transport [size]
+ */
+
+#define DEFAULT_SIZE 4
+
+void check_allreduce(const ccl::communicator& comm, size_t count) {
+    std::vector<float> send_buf(count, static_cast<float>(comm.rank() + 1));
+    std::vector<float> recv_buf(count, 0);
+    float expected = (static_cast<float>(comm.size()) + 1) / 2 * static_cast<float>(comm.size());
+
+    ccl::allreduce(send_buf.data(), recv_buf.data(), count, ccl::reduction::sum, comm).wait();
+
+    for (size_t idx = 0; idx < count; idx++) {
+        ASSERT(recv_buf[idx] == expected,
+               "allreduce: rank %d, idx %zu, expected %f, got %f",
+               comm.rank(),
+               idx,
+               expected,
+               recv_buf[idx]);
+    }
+}
+
+void check_broadcast(const ccl::communicator& comm, size_t count) {
+    int root = comm.size() - 1;
+    std::vector<int> buf(count, (comm.rank() == root) ? root : -1);
+
+    ccl::broadcast(buf.data(), count, root, comm).wait();
+
+    for (size_t idx = 0; idx < count; idx++) {
+        ASSERT(buf[idx] == root,
+               "broadcast: rank %d, idx %zu, expected %d, got %d",
+               comm.rank(),
+               idx,
+               root,
+               buf[idx]);
+    }
+}
+
+void check_alltoall(const ccl::communicator& comm) {
+    std::vector<int> send_buf(comm.size());
+    std::vector<int> recv_buf(comm.size(), -1);
+
+    for (int idx = 0; idx < comm.size(); idx++) {
+        send_buf[idx] = comm.rank() * comm.size() + idx;
+    }
+
+    ccl::alltoall(send_buf.data(), recv_buf.data(), 1, comm).wait();
+
+    for (int idx = 0; idx < comm.size(); idx++) {
+        int expected = idx * comm.size() + comm.rank();
+        ASSERT(recv_buf[idx] == expected,
+               "alltoall: rank %d, idx %d, expected %d, got %d",
+               comm.rank(),
+               idx,
+               expected,
+               recv_buf[idx]);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int size = (argc > 1) ? atoi(argv[1]) : DEFAULT_SIZE;
+    if (size <= 0) {
+        fprintf(stderr, "unexpected size %d\n", size);
+        return -1;
+    }
+
+    ccl::init();
+
+    /* ranks meet inside of the process, kvs is only needed for communicator creation API */
+    auto kvs = ccl::create_main_kvs();
+
+    std::atomic<size_t> failed_ranks{ 0 };
+    std::vector<std::thread> threads;
+
+    for (int rank = 0; rank < size; rank++) {
+        threads.emplace_back([&, rank]() {
+            try {
+                auto comm = ccl::create_communicator(size, rank, kvs);
+
+                PRINT_BY_ROOT(comm, "transport: sim, size: %d", comm.size());
+
+                for (size_t idx = 0; idx < MSG_SIZE_COUNT; idx++) {
+                    size_t count = 1u << (START_MSG_SIZE_POWER + idx);
+                    check_allreduce(comm, count);
+                    check_broadcast(comm, count);
+                }
+                check_alltoall(comm);
+
+                ccl::barrier(comm);
+            }
+            catch (ccl::exception& e) {
+                fprintf(stderr, "rank %d: ccl exception:\n%s\n", rank, e.what());
+                failed_ranks++;
+            }
+            catch (std::exception& e) {
+                fprintf(stderr, "rank %d: exception:\n%s\n", rank, e.what());
+                failed_ranks++;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed_ranks) {
+        PRINT("FAILED");
+        return -1;
+    }
+
+    PRINT("PASSED");
+    return 0;
+}
@@ -1494,6 +1494,39 @@ sparse_allreduce(const IndexBufferType* send_ind_buf,
                  const ccl::vector_class<ccl::event>& deps = {});
 
 /** @} */ // end of sparse_allreduce
+
+/******************** METRICS ********************/
+
+/** @defgroup metrics
+ * @{
+ */
+/** @} */ // end of metrics
+
+/**
+ * \ingroup metrics
+ * \brief Retrieves runtime metrics of collective operations from all communicators
+ *        together with cache, fusion and worker statistics.
+ *        Collection is controlled by CCL_METRICS and enabled by default
+ * @return metrics
+ */
+metrics CCL_API get_metrics();
+
+/**
+ * \ingroup metrics
+ * \brief Retrieves runtime metrics of collective operations from the communicator
+ *        together with cache, fusion and worker statistics
+ * @param comm the communicator for which metrics are retrieved
+ * @return metrics
+ */
+metrics CCL_API get_metrics(const communicator& comm);
+
+/**
+ * \ingroup metrics
+ * \brief Resets statistics of collective operations,
+ *        cache, fusion and worker counters are accumulated since library initialization
+ */
+void CCL_API reset_metrics();
+
 } // namespace preview
 
 using namespace v1;
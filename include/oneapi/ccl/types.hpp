@@ -116,6 +116,43 @@ typedef struct {
     string_class cl_backend_name;
 } library_version;
 
+/**
+ * Statistics of collective operations with the same type,
+ * selected algorithm and message size bucket
+ */
+typedef struct {
+    string_class coll_name;
+    string_class algo_name;
+    size_t size_bucket; /* upper bound of message size in bytes, power of two */
+    size_t count;
+    size_t bytes;
+    double min_time_usec;
+    double max_time_usec;
+    double avg_time_usec;
+    double p50_time_usec;
+    double p90_time_usec;
+    double p99_time_usec;
+    /* non-empty latency buckets: upper bound in usec and number of operations */
+    vector_class<pair_class<double, size_t>> latency_histogram;
+} coll_metrics;
+
+/**
+ * Runtime metrics of the library
+ */
+typedef struct {
+    string_class transport;
+    vector_class<coll_metrics> colls;
+    size_t sched_cache_hits;
+    size_t sched_cache_misses;
+    size_t sched_cache_evictions;
+    size_t buffer_cache_hits;
+    size_t buffer_cache_misses;
+    size_t fused_ops;
+    size_t fused_bytes;
+    size_t fused_scheds;
+    vector_class<double> worker_busy_time_usec;
+} metrics;
+
 typedef struct {
     const char* match_id;
     const size_t offset;
@@ -168,6 +205,8 @@ typedef void (*sparse_allreduce_alloc_fn)(size_t,
 } // namespace v1
 
 using v1::library_version;
+using v1::coll_metrics;
+using v1::metrics;
 using v1::fn_context;
 using v1::reduction_fn;
 using v1::ccl_empty_attr;
@@ -21,6 +21,7 @@
 #include "atl/atl_base_comm.hpp"
 #include "atl/ofi/atl_ofi_comm.hpp"
 #include "atl/ofi/atl_ofi.hpp"
+#include "atl/sim/atl_sim_comm.hpp"
 #include "atl/util/pm/pm_rt.h"
 #include "exec/exec.hpp"
 
@@ -135,6 +136,9 @@ std::shared_ptr<atl_base_comm> atl_comm_manager::create_comm(int total_rank_coun
             atl_comm = std::shared_ptr<atl_base_comm>(new atl_mpi_comm(total_rank_count, ranks, k));
             break;
 #endif // CCL_ENABLE_MPI
+        case ccl_atl_sim:
+            atl_comm = std::shared_ptr<atl_base_comm>(new atl_sim_comm(total_rank_count, ranks, k));
+            break;
         default: LOG_ERROR("Unsupported yet"); break;
     }
     return atl_comm;
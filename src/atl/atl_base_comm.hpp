@@ -19,6 +19,7 @@
 #include <mutex>
 #include <list>
 #include <vector>
+#include <sys/uio.h>
 
 #include "atl/atl_def.h"
 #include "common/comm/atl_tag.hpp"
@@ -63,6 +64,24 @@ public:
                               uint64_t tag,
                               atl_req_t* req) = 0;
 
+    /* send/recv of single message gathered from/scattered to several buffers */
+    virtual atl_status_t sendv(size_t ep_idx,
+                               const struct iovec* iov,
+                               size_t iov_count,
+                               int dst_proc_idx,
+                               uint64_t tag,
+                               atl_req_t* req) = 0;
+
+    virtual atl_status_t recvv(size_t ep_idx,
+                               const struct iovec* iov,
+                               size_t iov_count,
+                               int src_proc_idx,
+                               uint64_t tag,
+                               atl_req_t* req) = 0;
+
+    /* max iov_count supported by sendv/recvv, 0 if they are not supported */
+    virtual size_t get_iov_limit() = 0;
+
     virtual atl_status_t probe(size_t ep_idx,
                                int src_proc_idx,
                                uint64_t tag,
@@ -161,6 +180,10 @@ public:
 
     virtual int get_host_color() = 0;
 
+    int get_local_size() const {
+        return coord.local_count;
+    }
+
     virtual std::shared_ptr<atl_base_comm> comm_split(int color) = 0;
 
     virtual std::vector<int> get_rank2rank_map() = 0;
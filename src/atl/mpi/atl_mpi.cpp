@@ -247,6 +247,91 @@ atl_status_t atl_mpi::recv(atl_mpi_ep_t& ep,
     return RET2ATL(ret);
 }
 
+/*
+   iov is described by derived datatype with absolute addresses,
+   block length is int so iov entries larger than INT_MAX are split into several blocks
+*/
+static int atl_mpi_create_iov_type(const struct iovec* iov,
+                                   size_t iov_count,
+                                   MPI_Datatype* iov_type) {
+    const size_t max_block_len = std::numeric_limits<int>::max();
+
+    std::vector<int> lens;
+    std::vector<MPI_Aint> displs;
+    lens.reserve(iov_count);
+    displs.reserve(iov_count);
+
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        MPI_Aint addr;
+        MPI_Get_address(iov[idx].iov_base, &addr);
+        for (size_t offset = 0; offset < iov[idx].iov_len; offset += max_block_len) {
+            lens.push_back(static_cast<int>(std::min(max_block_len, iov[idx].iov_len - offset)));
+            displs.push_back(addr + static_cast<MPI_Aint>(offset));
+        }
+    }
+
+    if (lens.size() > max_block_len)
+        return MPI_ERR_COUNT;
+
+    int ret = MPI_Type_create_hindexed(
+        static_cast<int>(lens.size()), lens.data(), displs.data(), MPI_CHAR, iov_type);
+    if (ret != MPI_SUCCESS)
+        return ret;
+
+    return MPI_Type_commit(iov_type);
+}
+
+atl_status_t atl_mpi::sendv(atl_mpi_ep_t& ep,
+                            const struct iovec* iov,
+                            size_t iov_count,
+                            int dst_proc_idx,
+                            uint64_t tag,
+                            atl_req_t* req) {
+    atl_mpi_req_t* mpi_req = ((atl_mpi_req_t*)req->internal);
+
+    init_req(req);
+
+    MPI_Datatype iov_type;
+    int ret = atl_mpi_create_iov_type(iov, iov_count, &iov_type);
+    if (ret != MPI_SUCCESS)
+        return RET2ATL(ret);
+
+    ret = MPI_Isend(
+        MPI_BOTTOM, 1, iov_type, dst_proc_idx, (int)tag, ep.mpi_comm, &mpi_req->native_req);
+
+    /* datatype is kept by MPI until completion of the request */
+    MPI_Type_free(&iov_type);
+
+    check_ep(ep);
+
+    return RET2ATL(ret);
+}
+
+atl_status_t atl_mpi::recvv(atl_mpi_ep_t& ep,
+                            const struct iovec* iov,
+                            size_t iov_count,
+                            int src_proc_idx,
+                            uint64_t tag,
+                            atl_req_t* req) {
+    atl_mpi_req_t* mpi_req = ((atl_mpi_req_t*)req->internal);
+
+    init_req(req);
+
+    MPI_Datatype iov_type;
+    int ret = atl_mpi_create_iov_type(iov, iov_count, &iov_type);
+    if (ret != MPI_SUCCESS)
+        return RET2ATL(ret);
+
+    ret = MPI_Irecv(
+        MPI_BOTTOM, 1, iov_type, src_proc_idx, (int)tag, ep.mpi_comm, &mpi_req->native_req);
+
+    MPI_Type_free(&iov_type);
+
+    check_ep(ep);
+
+    return RET2ATL(ret);
+}
+
 atl_status_t atl_mpi::probe(atl_mpi_ep_t& ep,
                             int src_proc_idx,
                             uint64_t tag,
@@ -81,6 +81,24 @@ public:
                       uint64_t tag,
                       atl_req_t* req);
 
+    atl_status_t sendv(atl_mpi_ep_t& ep,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int dst_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req);
+
+    atl_status_t recvv(atl_mpi_ep_t& ep,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req);
+
+    size_t get_iov_limit() {
+        return std::numeric_limits<int>::max();
+    }
+
     atl_status_t probe(atl_mpi_ep_t& ep,
                        int src_proc_idx,
                        uint64_t tag,
@@ -54,34 +54,127 @@ void atl_ofi::fi_cache::push(size_t idx, fid_mr* mr) {
 }
 
 atl_ofi::mr_cache::~mr_cache() {
-    if (!cache.empty()) {
-        LOG_WARN("mr cache is not empty, size: ", cache.size());
+    if (!regions.empty()) {
+        LOG_WARN("mr cache is not empty, size: ", regions.size());
         clear();
     }
 }
 
 void atl_ofi::mr_cache::clear() {
-    LOG_DEBUG("mr cache size: ", cache.size());
-    for (auto& key_value : cache) {
-        fi_close(&key_value.second->fid);
+    LOG_DEBUG("mr cache size: ", regions.size());
+    if (hit_count || miss_count) {
+        LOG_INFO("mr cache: hits ",
+                 hit_count,
+                 ", misses ",
+                 miss_count,
+                 ", evictions ",
+                 eviction_count,
+                 ", invalidations ",
+                 invalidation_count,
+                 ", cached bytes ",
+                 cached_bytes);
     }
-    cache.clear();
+
+    for (auto& key_value : regions) {
+        fi_close(&key_value.first->fid);
+    }
+    regions.clear();
+    intervals.clear();
+    lru.clear();
+    cached_bytes = 0;
+
+    hit_count = miss_count = eviction_count = invalidation_count = 0;
 }
 
 void atl_ofi::mr_cache::get(fid_domain* domain, void* buf, size_t bytes, fid_mr** mr) {
     CCL_THROW_IF_NOT(domain);
     CCL_THROW_IF_NOT(mr);
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(domain, buf, bytes);
-        auto key_value = cache.find(key);
-        if (key_value != cache.end()) {
-            *mr = key_value->second;
-            LOG_DEBUG("loaded from mr cache: buf: ", buf, ", bytes: ", bytes);
-            return;
+    uintptr_t start = reinterpret_cast<uintptr_t>(buf);
+    uintptr_t end = start + bytes;
+
+    if (!ccl::global_data::env().enable_atl_cache) {
+        reg(domain, buf, bytes, mr);
+        regions.emplace(*mr, region_t{ domain, start, end, 0, 1, false, lru.end() });
+        return;
+    }
+
+    alloc_info_t info;
+    get_alloc_info(buf, bytes, &info);
+
+    fid_mr* cached_mr = find(domain, start, end);
+    if (cached_mr && regions.at(cached_mr).alloc_id != info.id) {
+        /* memory was freed and allocated again after registration */
+        LOG_DEBUG("invalidate mr cache region for buf: ", buf, ", bytes: ", bytes);
+        uncache(cached_mr);
+        invalidation_count++;
+        cached_mr = nullptr;
+    }
+
+    if (cached_mr) {
+        region_t& region = regions.at(cached_mr);
+        region.ref_count++;
+        if (region.lru_it != lru.begin()) {
+            lru.splice(lru.begin(), lru, region.lru_it);
         }
+        hit_count++;
+        *mr = cached_mr;
+        LOG_DEBUG("loaded from mr cache: buf: ", buf, ", bytes: ", bytes);
+        return;
+    }
+
+    miss_count++;
+
+    /* register the whole device allocation to serve requests to its other parts */
+    size_t max_bytes = ccl::global_data::env().atl_cache_max_bytes;
+    if (info.id && (!max_bytes || info.size <= max_bytes)) {
+        start = std::min(start, info.base);
+        end = std::max(end, info.base + info.size);
+    }
+
+    insert(domain, start, end, info, mr);
+}
+
+void atl_ofi::mr_cache::push(fid_mr* mr) {
+    CCL_THROW_IF_NOT(mr);
+
+    auto it = regions.find(mr);
+    CCL_THROW_IF_NOT(it != regions.end(), "unknown mr ", mr);
+
+    region_t& region = it->second;
+    CCL_THROW_IF_NOT(region.ref_count > 0, "unexpected ref_count for mr ", mr);
+    region.ref_count--;
+
+    if (!region.ref_count && !region.is_cached) {
+        fi_close(&mr->fid);
+        regions.erase(it);
     }
+}
+
+void atl_ofi::mr_cache::get_alloc_info(void* buf, size_t bytes, alloc_info_t* info) {
+    info->base = reinterpret_cast<uintptr_t>(buf);
+    info->size = bytes;
+    info->id = 0;
+
+#ifdef CCL_ENABLE_OFI_HMEM
+    atl_ofi_ze_data& ze_data = global_data.ze_data;
+    ze_memory_allocation_properties_t alloc_props = ccl::ze::default_alloc_props;
+    ze_device_handle_t alloc_dev = nullptr;
+    ZE_CALL(zeMemGetAllocProperties, (ze_data.context, buf, &alloc_props, &alloc_dev));
 
+    if (alloc_props.type != ZE_MEMORY_TYPE_UNKNOWN) {
+        void* base = nullptr;
+        size_t size = 0;
+        ZE_CALL(zeMemGetAddressRange, (ze_data.context, buf, &base, &size));
+
+        info->base = reinterpret_cast<uintptr_t>(base);
+        info->size = size;
+        info->id = alloc_props.id;
+    }
+#endif // CCL_ENABLE_OFI_HMEM
+}
+
+void atl_ofi::mr_cache::reg(fid_domain* domain, void* buf, size_t bytes, fid_mr** mr) {
     struct fi_mr_attr mr_attr;
     struct iovec iov;
 
@@ -143,21 +236,117 @@ void atl_ofi::mr_cache::get(fid_domain* domain, void* buf, size_t bytes, fid_mr*
                            bytes,
                            ", iface: ",
                            mr_attr.iface));
+}
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(domain, buf, bytes);
-        LOG_DEBUG("inserted to mr cache: buf: ", buf, ", bytes: ", bytes);
-        cache.insert({ std::move(key), *mr });
+fid_mr* atl_ofi::mr_cache::find(fid_domain* domain, uintptr_t start, uintptr_t end) {
+    auto it = intervals.upper_bound(interval_key_t(domain, start));
+    if (it == intervals.begin()) {
+        return nullptr;
     }
+
+    --it;
+    if (it->first.first != domain) {
+        return nullptr;
+    }
+
+    const region_t& region = regions.at(it->second);
+    if (!region.alloc_id) {
+        /* host memory can not be tracked, so its region is reused for the same range only */
+        return (region.start == start && region.end == end) ? it->second : nullptr;
+    }
+
+    return (region.end >= end) ? it->second : nullptr;
 }
 
-void atl_ofi::mr_cache::push(fid_mr* mr) {
-    CCL_THROW_IF_NOT(mr);
-    if (ccl::global_data::env().enable_atl_cache) {
-        /* do nothing, all mem regions will be closed in clear() */
-        return;
+void atl_ofi::mr_cache::insert(fid_domain* domain,
+                               uintptr_t start,
+                               uintptr_t end,
+                               const alloc_info_t& info,
+                               fid_mr** mr) {
+    /*
+     * merge with overlapping and adjacent regions of the same device allocation,
+     * other overlapping regions are replaced
+     */
+    auto it = intervals.lower_bound(interval_key_t(domain, start));
+    if (it != intervals.begin()) {
+        auto prev_it = std::prev(it);
+        if (prev_it->first.first == domain && regions.at(prev_it->second).end >= start) {
+            it = prev_it;
+        }
+    }
+
+    while (it != intervals.end() && it->first.first == domain && it->first.second <= end) {
+        fid_mr* cached_mr = it->second;
+        const region_t& region = regions.at(cached_mr);
+        ++it;
+
+        if (info.id && region.alloc_id == info.id) {
+            start = std::min(start, region.start);
+            end = std::max(end, region.end);
+        }
+        else if (region.start < end && region.end > start) {
+            if (region.alloc_id != info.id) {
+                /* address range can not belong to two live allocations */
+                invalidation_count++;
+            }
+        }
+        else {
+            continue;
+        }
+        uncache(cached_mr);
+    }
+
+    reg(domain, reinterpret_cast<void*>(start), end - start, mr);
+
+    lru.push_front(*mr);
+    regions.emplace(*mr, region_t{ domain, start, end, info.id, 1, true, lru.begin() });
+    intervals.emplace(interval_key_t(domain, start), *mr);
+    cached_bytes += end - start;
+
+    LOG_DEBUG("inserted to mr cache: start: ",
+              reinterpret_cast<void*>(start),
+              ", bytes: ",
+              end - start,
+              ", regions: ",
+              intervals.size());
+
+    evict();
+}
+
+void atl_ofi::mr_cache::uncache(fid_mr* mr) {
+    auto it = regions.find(mr);
+    CCL_THROW_IF_NOT(it != regions.end() && it->second.is_cached, "unexpected mr ", mr);
+
+    region_t& region = it->second;
+    intervals.erase(interval_key_t(region.domain, region.start));
+    lru.erase(region.lru_it);
+    region.lru_it = lru.end();
+    region.is_cached = false;
+    cached_bytes -= region.end - region.start;
+
+    /* region in use will be closed on completion of the last operation */
+    if (!region.ref_count) {
+        fi_close(&mr->fid);
+        regions.erase(it);
+    }
+}
+
+void atl_ofi::mr_cache::evict() {
+    size_t capacity = ccl::global_data::env().atl_cache_capacity;
+    size_t max_bytes = ccl::global_data::env().atl_cache_max_bytes;
+
+    auto lru_it = lru.end();
+    while (((capacity && intervals.size() > capacity) || (max_bytes && cached_bytes > max_bytes)) &&
+           (lru_it != lru.begin())) {
+        --lru_it;
+        fid_mr* cached_mr = *lru_it;
+        if (regions.at(cached_mr).ref_count)
+            continue;
+
+        lru_it = std::next(lru_it);
+        uncache(cached_mr);
+        eviction_count++;
     }
-    fi_close(&mr->fid);
 }
 
 // atl_ofi
@@ -224,6 +413,12 @@ atl_status_t atl_ofi::init(int* argc,
     ctx->ep_count = attr->in.ep_count;
     eps.resize(attr->in.ep_count);
 
+    if (ccl::global_data::env().enable_atl_lazy_connect) {
+        ofi_ctx->lazy_connect = new atl_ofi_lazy_connect_t;
+        ofi_ctx->lazy_connect->pmi = pmi;
+    }
+    ofi_ctx->stripe_threshold = ccl::global_data::env().mnic_stripe_threshold;
+
     ctx->coord.global_count = pmi->get_size();
     ctx->coord.global_idx = pmi->get_rank();
 
@@ -381,7 +576,15 @@ atl_status_t atl_ofi::init(int* argc,
             ofi_ep->active_prov_idxs[ofi_ep->active_prov_count] = ofi_ctx->shm_prov_idx;
             ofi_ep->active_prov_count++;
         }
-        if (open_nw_provs) {
+        if (open_nw_provs && ofi_ctx->stripe_threshold && ofi_ctx->nw_prov_count > 1) {
+            /* stripes of large messages complete on all NW providers */
+            for (idx = 0; idx < ofi_ctx->nw_prov_count; idx++) {
+                ofi_ep->active_prov_idxs[ofi_ep->active_prov_count] =
+                    ofi_ctx->nw_prov_first_idx + (ep_idx + idx) % ofi_ctx->nw_prov_count;
+                ofi_ep->active_prov_count++;
+            }
+        }
+        else if (open_nw_provs) {
             ofi_ep->active_prov_idxs[ofi_ep->active_prov_count] =
                 ofi_ctx->nw_prov_first_idx + ep_idx % ofi_ctx->nw_prov_count;
             ofi_ep->active_prov_count++;
@@ -434,6 +637,8 @@ atl_status_t atl_ofi::init(int* argc,
         LOG_INFO("  mnic_offset: ", to_string(ofi_ctx->mnic_offset));
         LOG_INFO("  max_retry_count: ", ofi_ctx->max_retry_count);
         LOG_INFO("  progress_mode: ", ofi_ctx->progress_mode);
+        LOG_INFO("  lazy_connect: ", (ofi_ctx->lazy_connect != nullptr));
+        LOG_INFO("  stripe_threshold: ", ofi_ctx->stripe_threshold);
 #ifdef CCL_ENABLE_OFI_HMEM
         LOG_INFO("  hmem: ", ofi_ctx->enable_hmem);
 #endif // CCL_ENABLE_OFI_HMEM
@@ -489,6 +694,30 @@ atl_status_t atl_ofi::finalize() {
 
     for (idx = 0; idx < ofi_ctx->prov_count; idx++) {
         atl_ofi_prov_t* prov = &ofi_ctx->provs[idx];
+        if (ctx->coord.global_idx == 0) {
+            size_t tx_bytes = 0, rx_bytes = 0;
+            for (size_t ep_idx = 0; ep_idx < ctx->ep_count; ep_idx++) {
+                tx_bytes += prov->eps[ep_idx].tx_bytes;
+                rx_bytes += prov->eps[ep_idx].rx_bytes;
+            }
+            LOG_INFO("prov ",
+                     atl_ofi_get_nic_name(prov->info),
+                     ": tx_bytes ",
+                     tx_bytes,
+                     ", rx_bytes ",
+                     rx_bytes);
+        }
+        if (ofi_ctx->lazy_connect && ctx->coord.global_idx == 0) {
+            LOG_INFO("prov ",
+                     atl_ofi_get_nic_name(prov->info),
+                     ": lazily resolved ",
+                     prov->lazy_resolved_count,
+                     " of ",
+                     prov->proc_count,
+                     " peers, addr table ",
+                     atl_ofi_prov_get_addr_table_bytes(ctx, prov),
+                     " bytes");
+        }
         atl_ofi_prov_destroy(ctx, prov);
     }
 
@@ -508,6 +737,7 @@ atl_status_t atl_ofi::finalize() {
         }
     }
 
+    delete ofi_ctx->lazy_connect;
     free(ofi_ctx);
 
     return RET2ATL(ret);
@@ -549,6 +779,10 @@ atl_status_t atl_ofi::update(std::shared_ptr<ipmi> pmi) {
     }
     atl_ofi_print_coord(coord);
 
+    if (ofi_ctx->lazy_connect) {
+        ofi_ctx->lazy_connect->pmi = pmi;
+    }
+
     for (prov_idx = 0; prov_idx < ofi_ctx->prov_count; prov_idx++) {
         ret = atl_ofi_prov_eps_connect(ofi_ctx, prov_idx, pmi);
         if (ret)
@@ -624,8 +858,24 @@ atl_status_t atl_ofi::send(atl_ep_t* ep,
     atl_ofi_prov_t* prov;
     atl_ofi_prov_ep_t* prov_ep;
     atl_ofi_req_t* ofi_req;
+    atl_ofi_ctx_t* ofi_ctx = container_of(ep->ctx, atl_ofi_ctx_t, ctx);
 
     prov = atl_ofi_get_prov(ep, dst_proc_idx, len);
+
+    size_t stripe_size;
+    size_t stripe_count = atl_ofi_get_stripe_count(ofi_ctx, prov, len, &stripe_size);
+    if (stripe_count > 1) {
+        return atl_post_stripes(ep,
+                                const_cast<void*>(buf),
+                                len,
+                                dst_proc_idx,
+                                tag,
+                                req,
+                                stripe_count,
+                                stripe_size,
+                                true /* is_send */);
+    }
+
     prov_ep = &(prov->eps[ep->idx]);
 
     atl_ofi_init_req(req, prov_ep, prov_ep->tx);
@@ -650,6 +900,7 @@ atl_status_t atl_ofi::send(atl_ep_t* ep,
     msg.data = 0;
 
     ATL_OFI_RETRY(fi_tsendmsg(prov_ep->tx, &msg, 0), ep, ret);
+    prov_ep->tx_bytes += len;
 
     return RET2ATL(ret);
 }
@@ -665,8 +916,24 @@ atl_status_t atl_ofi::recv(atl_ep_t* ep,
     atl_ofi_prov_t* prov;
     atl_ofi_prov_ep_t* prov_ep;
     atl_ofi_req_t* ofi_req;
+    atl_ofi_ctx_t* ofi_ctx = container_of(ep->ctx, atl_ofi_ctx_t, ctx);
 
     prov = atl_ofi_get_prov(ep, src_proc_idx, len);
+
+    size_t stripe_size;
+    size_t stripe_count = atl_ofi_get_stripe_count(ofi_ctx, prov, len, &stripe_size);
+    if (stripe_count > 1) {
+        return atl_post_stripes(ep,
+                                buf,
+                                len,
+                                src_proc_idx,
+                                tag,
+                                req,
+                                stripe_count,
+                                stripe_size,
+                                false /* is_send */);
+    }
+
     prov_ep = &(prov->eps[ep->idx]);
 
     atl_ofi_init_req(req, prov_ep, prov_ep->rx);
@@ -691,10 +958,209 @@ atl_status_t atl_ofi::recv(atl_ep_t* ep,
     msg.data = 0;
 
     ATL_OFI_RETRY(fi_trecvmsg(prov_ep->rx, &msg, 0), ep, ret);
+    prov_ep->rx_bytes += len;
+
+    return RET2ATL(ret);
+}
+
+atl_status_t atl_ofi::atl_post_stripes(atl_ep_t* ep,
+                                       void* buf,
+                                       size_t len,
+                                       int peer_proc_idx,
+                                       uint64_t tag,
+                                       atl_req_t* req,
+                                       size_t stripe_count,
+                                       size_t stripe_size,
+                                       bool is_send) {
+    ssize_t ret = FI_SUCCESS;
+    atl_ofi_ctx_t* ofi_ctx = container_of(ep->ctx, atl_ofi_ctx_t, ctx);
+
+    CCL_THROW_IF_NOT(stripe_count <= ofi_ctx->nw_prov_count,
+                     "unexpected stripe_count ",
+                     stripe_count,
+                     ", nw_prov_count ",
+                     ofi_ctx->nw_prov_count);
+
+    /* parent request has no own OFI operation, it is completed by the last stripe */
+    atl_ofi_init_req(req, nullptr, nullptr);
+
+    atl_ofi_req_t* ofi_req = ((atl_ofi_req_t*)req->internal);
+    ofi_req->mr = nullptr;
+    ofi_req->recv_len = 0;
+    ofi_req->stripes = new atl_ofi_req_t[stripe_count]();
+    ofi_req->stripe_count = stripe_count;
+    ofi_req->pending_stripe_count = stripe_count;
+
+    LOG_DEBUG("post ",
+              (is_send) ? "send" : "recv",
+              " stripes: len ",
+              len,
+              ", stripe_count ",
+              stripe_count,
+              ", stripe_size ",
+              stripe_size,
+              ", peer ",
+              peer_proc_idx,
+              ", tag ",
+              tag);
+
+    for (size_t idx = 0; idx < stripe_count; idx++) {
+        /* stripe idx goes through NW provider idx on both sides */
+        atl_ofi_prov_t* prov = &(ofi_ctx->provs[ofi_ctx->nw_prov_first_idx + idx]);
+        atl_ofi_prov_ep_t* prov_ep = &(prov->eps[ep->idx]);
+        atl_ofi_req_t* stripe = &(ofi_req->stripes[idx]);
+
+        size_t offset = idx * stripe_size;
+        size_t stripe_len = std::min(stripe_size, len - offset);
+
+        CCL_THROW_IF_NOT(stripe_len <= prov->max_msg_size,
+                         "stripe_len (",
+                         stripe_len,
+                         ") is greater than max_msg_size (",
+                         prov->max_msg_size,
+                         "), prov_idx ",
+                         prov->idx);
+
+        stripe->prov_ep = prov_ep;
+        stripe->fi_ep = (is_send) ? prov_ep->tx : prov_ep->rx;
+        stripe->comp_state = ATL_OFI_COMP_POSTED;
+        stripe->parent = ofi_req;
+
+        void* stripe_buf = static_cast<char*>(buf) + offset;
+        cache.get(ep->idx, prov->domain, stripe_buf, stripe_len, &stripe->mr);
+        void* desc = (stripe->mr) ? fi_mr_desc(stripe->mr) : nullptr;
+
+        struct iovec iov;
+        iov.iov_base = stripe_buf;
+        iov.iov_len = stripe_len;
+
+        struct fi_msg_tagged msg;
+        msg.desc = &desc;
+        msg.msg_iov = &iov;
+        msg.iov_count = 1;
+        msg.tag = tag;
+        msg.ignore = 0;
+        msg.addr = atl_ofi_get_addr(ep->ctx, prov, peer_proc_idx, ep->idx);
+        msg.context = &stripe->fi_ctx;
+        msg.data = 0;
+
+        if (is_send) {
+            ATL_OFI_RETRY(fi_tsendmsg(prov_ep->tx, &msg, 0), ep, ret);
+            prov_ep->tx_bytes += stripe_len;
+        }
+        else {
+            ATL_OFI_RETRY(fi_trecvmsg(prov_ep->rx, &msg, 0), ep, ret);
+            prov_ep->rx_bytes += stripe_len;
+        }
+
+        if (ret != FI_SUCCESS)
+            break;
+    }
+
+    return RET2ATL(ret);
+}
+
+atl_status_t atl_ofi::sendv(atl_ep_t* ep,
+                            const struct iovec* iov,
+                            size_t iov_count,
+                            int dst_proc_idx,
+                            uint64_t tag,
+                            atl_req_t* req) {
+    ssize_t ret;
+
+    atl_ofi_prov_t* prov;
+    atl_ofi_prov_ep_t* prov_ep;
+    atl_ofi_req_t* ofi_req;
+
+    size_t len = 0;
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        len += iov[idx].iov_len;
+    }
+
+    prov = atl_ofi_get_prov(ep, dst_proc_idx, len);
+    prov_ep = &(prov->eps[ep->idx]);
+
+    /* iov_limit is 0 when provider requires memory descriptors, see atl_ofi_prov_init */
+    if (iov_count > prov->iov_limit)
+        return ATL_STATUS_UNSUPPORTED;
+
+    atl_ofi_init_req(req, prov_ep, prov_ep->tx);
+
+    ofi_req = ((atl_ofi_req_t*)req->internal);
+    ofi_req->mr = nullptr;
+
+    struct fi_msg_tagged msg;
+    msg.desc = nullptr;
+    msg.msg_iov = iov;
+    msg.iov_count = iov_count;
+    msg.tag = tag;
+    msg.ignore = 0;
+    msg.addr = atl_ofi_get_addr(ep->ctx, prov, dst_proc_idx, ep->idx);
+    msg.context = &ofi_req->fi_ctx;
+    msg.data = 0;
+
+    ATL_OFI_RETRY(fi_tsendmsg(prov_ep->tx, &msg, 0), ep, ret);
+    prov_ep->tx_bytes += len;
+
+    return RET2ATL(ret);
+}
+
+atl_status_t atl_ofi::recvv(atl_ep_t* ep,
+                            const struct iovec* iov,
+                            size_t iov_count,
+                            int src_proc_idx,
+                            uint64_t tag,
+                            atl_req_t* req) {
+    ssize_t ret;
+
+    atl_ofi_prov_t* prov;
+    atl_ofi_prov_ep_t* prov_ep;
+    atl_ofi_req_t* ofi_req;
+
+    size_t len = 0;
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        len += iov[idx].iov_len;
+    }
+
+    prov = atl_ofi_get_prov(ep, src_proc_idx, len);
+    prov_ep = &(prov->eps[ep->idx]);
+
+    /* iov_limit is 0 when provider requires memory descriptors, see atl_ofi_prov_init */
+    if (iov_count > prov->iov_limit)
+        return ATL_STATUS_UNSUPPORTED;
+
+    atl_ofi_init_req(req, prov_ep, prov_ep->rx);
+
+    ofi_req = ((atl_ofi_req_t*)req->internal);
+    ofi_req->mr = nullptr;
+
+    struct fi_msg_tagged msg;
+    msg.desc = nullptr;
+    msg.msg_iov = iov;
+    msg.iov_count = iov_count;
+    msg.tag = tag;
+    msg.ignore = 0;
+    msg.addr = atl_ofi_get_addr(ep->ctx, prov, src_proc_idx, ep->idx);
+    msg.context = &ofi_req->fi_ctx;
+    msg.data = 0;
+
+    ATL_OFI_RETRY(fi_trecvmsg(prov_ep->rx, &msg, 0), ep, ret);
+    prov_ep->rx_bytes += len;
 
     return RET2ATL(ret);
 }
 
+size_t atl_ofi::get_iov_limit() {
+    atl_ofi_ctx_t* ofi_ctx = container_of(ctx, atl_ofi_ctx_t, ctx);
+
+    size_t iov_limit = std::numeric_limits<size_t>::max();
+    for (size_t idx = 0; idx < ofi_ctx->prov_count; idx++) {
+        iov_limit = std::min(iov_limit, ofi_ctx->provs[idx].iov_limit);
+    }
+
+    return iov_limit;
+}
+
 atl_status_t atl_ofi::probe(atl_ep_t* ep,
                             int src_proc_idx,
                             uint64_t tag,
@@ -908,6 +1374,23 @@ atl_status_t atl_ofi::cancel(atl_ep_t* ep, atl_req_t* req) {
     ret = ATL_STATUS_SUCCESS;
     ofi_req = ((atl_ofi_req_t*)req->internal);
 
+    if (ofi_req->stripes) {
+        for (size_t idx = 0; idx < ofi_req->stripe_count; idx++) {
+            atl_ofi_req_t* stripe = &(ofi_req->stripes[idx]);
+            if (stripe->comp_state == ATL_OFI_COMP_COMPLETED)
+                continue;
+            ret = fi_cancel(&stripe->fi_ep->fid, &stripe->fi_ctx);
+            if (ret == 0) {
+                ret = atl_ofi_wait_cancel_cq(stripe->prov_ep->cq);
+                if (ret)
+                    return RET2ATL(ret);
+            }
+        }
+        delete[] ofi_req->stripes;
+        ofi_req->stripes = nullptr;
+        return ATL_STATUS_SUCCESS;
+    }
+
     ret = fi_cancel(&ofi_req->fi_ep->fid, &ofi_req->fi_ctx);
     if (ret == 0) {
         return RET2ATL(atl_ofi_wait_cancel_cq(ofi_req->prov_ep->cq));
@@ -1017,10 +1500,19 @@ void atl_ofi::atl_process_comps(atl_ep_t* ep, struct fi_cq_tagged_entry* entries
     atl_ofi_req_t* comp_ofi_req;
     for (idx = 0; idx < ret; idx++) {
         comp_ofi_req = container_of(entries[idx].op_context, atl_ofi_req_t, fi_ctx);
+
+        if (entries[idx].flags & FI_RECV) {
+            comp_ofi_req->recv_len = entries[idx].len;
+        }
+
         switch (comp_ofi_req->comp_state) {
             case ATL_OFI_COMP_POSTED:
                 comp_ofi_req->comp_state = ATL_OFI_COMP_COMPLETED;
                 cache.push(ep->idx, comp_ofi_req->mr);
+                if (comp_ofi_req->parent) {
+                    /* may release memory of stripe */
+                    atl_ofi_complete_stripe(comp_ofi_req);
+                }
                 break;
             case ATL_OFI_COMP_COMPLETED: break;
             case ATL_OFI_COMP_PEEK_STARTED:
@@ -1028,9 +1520,5 @@ void atl_ofi::atl_process_comps(atl_ep_t* ep, struct fi_cq_tagged_entry* entries
                 break;
             default: CCL_THROW("unexpected completion state ", comp_ofi_req->comp_state); break;
         }
-
-        if (entries[idx].flags & FI_RECV) {
-            comp_ofi_req->recv_len = entries[idx].len;
-        }
     }
 }
@@ -15,12 +15,13 @@
 */
 #pragma once
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <rdma/fi_domain.h>
 #include <unordered_map>
 
 #include "atl_ofi_helper.hpp"
-#include "common/utils/hash.hpp"
 
 class atl_ofi {
 public:
@@ -60,6 +61,22 @@ public:
                       uint64_t tag,
                       atl_req_t* req);
 
+    atl_status_t sendv(atl_ep_t* ep,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int dst_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req);
+
+    atl_status_t recvv(atl_ep_t* ep,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req);
+
+    size_t get_iov_limit();
+
     atl_status_t probe(atl_ep_t* ep, int src_proc_idx, uint64_t tag, int* found, size_t* recv_len);
 
     atl_status_t read(atl_ep_t* ep,
@@ -100,10 +117,26 @@ private:
     atl_status_t atl_ep_progress(atl_ep_t* ep);
     void atl_process_comps(atl_ep_t* ep, struct fi_cq_tagged_entry* entries, ssize_t ret);
     atl_status_t atl_prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep);
+    atl_status_t atl_post_stripes(atl_ep_t* ep,
+                                  void* buf,
+                                  size_t len,
+                                  int peer_proc_idx,
+                                  uint64_t tag,
+                                  atl_req_t* req,
+                                  size_t stripe_count,
+                                  size_t stripe_size,
+                                  bool is_send);
 
     atl_ctx_t* ctx = nullptr;
     std::vector<atl_ep_t*> eps;
 
+    /*
+     * Registration cache keyed by address range.
+     * Cached regions of one domain do not overlap, so request hits
+     * if it is covered by the closest region which starts at or below the request.
+     * Host regions can not be validated by allocation id and hit on exact match only.
+     * Regions referenced by in-flight operations are closed only after their completion.
+     */
     class mr_cache {
     public:
         mr_cache() = default;
@@ -114,11 +147,49 @@ private:
         void push(fid_mr* mr);
 
     private:
+        struct alloc_info_t {
+            uintptr_t base;
+            size_t size;
+            /* identifier of device allocation, 0 for host memory */
+            uint64_t id;
+        };
+
+        struct region_t {
+            fid_domain* domain;
+            uintptr_t start;
+            uintptr_t end;
+            uint64_t alloc_id;
+            size_t ref_count;
+            bool is_cached;
+            std::list<fid_mr*>::iterator lru_it;
+        };
+
+        using interval_key_t = typename std::pair<fid_domain*, uintptr_t>;
+
+        void get_alloc_info(void* buf, size_t bytes, alloc_info_t* info);
+        void reg(fid_domain* domain, void* buf, size_t bytes, fid_mr** mr);
+        fid_mr* find(fid_domain* domain, uintptr_t start, uintptr_t end);
+        void insert(fid_domain* domain,
+                    uintptr_t start,
+                    uintptr_t end,
+                    const alloc_info_t& info,
+                    fid_mr** mr);
+        void uncache(fid_mr* mr);
+        void evict();
+
         size_t mr_key = 0;
 
-        using key_t = typename std::tuple<fid_domain*, void*, size_t>;
-        using value_t = fid_mr*;
-        std::unordered_multimap<key_t, value_t, ccl::utils::tuple_hash> cache{};
+        /* all open regions, including in-use regions removed from cache */
+        std::unordered_map<fid_mr*, region_t> regions{};
+        /* cached regions ordered by domain and start address */
+        std::map<interval_key_t, fid_mr*> intervals{};
+        std::list<fid_mr*> lru{};
+        size_t cached_bytes = 0;
+
+        size_t hit_count = 0;
+        size_t miss_count = 0;
+        size_t eviction_count = 0;
+        size_t invalidation_count = 0;
     };
 
     class fi_cache {
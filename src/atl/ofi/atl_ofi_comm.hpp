@@ -75,6 +75,30 @@ public:
         return transport->recv(eps[ep_idx], buf, len, rank2rank_map[src_proc_idx], tag, req);
     }
 
+    atl_status_t sendv(size_t ep_idx,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int dst_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req) override {
+        return transport->sendv(
+            eps[ep_idx], iov, iov_count, rank2rank_map[dst_proc_idx], tag, req);
+    }
+
+    atl_status_t recvv(size_t ep_idx,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req) override {
+        return transport->recvv(
+            eps[ep_idx], iov, iov_count, rank2rank_map[src_proc_idx], tag, req);
+    }
+
+    size_t get_iov_limit() override {
+        return transport->get_iov_limit();
+    }
+
     atl_status_t probe(size_t ep_idx,
                        int src_proc_idx,
                        uint64_t tag,
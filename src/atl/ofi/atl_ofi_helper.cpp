@@ -178,10 +178,115 @@ atl_ofi_prov_t* atl_ofi_get_prov(atl_ep_t* ep, int peer_proc_idx, size_t msg_siz
     return &(ofi_ctx->provs[prov_idx]);
 }
 
+size_t atl_ofi_get_stripe_count(atl_ofi_ctx_t* ofi_ctx,
+                                atl_ofi_prov_t* prov,
+                                size_t msg_size,
+                                size_t* stripe_size) {
+    *stripe_size = msg_size;
+
+    if (prov->is_shm || !ofi_ctx->stripe_threshold || ofi_ctx->nw_prov_count < 2 ||
+        msg_size < ofi_ctx->stripe_threshold) {
+        return 1;
+    }
+
+    /* sender and receiver derive the same stripes from message size */
+    *stripe_size = ccl_aligned_sz(
+        (msg_size + ofi_ctx->nw_prov_count - 1) / ofi_ctx->nw_prov_count, CACHELINE_SIZE);
+    return (msg_size + *stripe_size - 1) / *stripe_size;
+}
+
 fi_addr_t atl_ofi_get_addr(atl_ctx_t* ctx, atl_ofi_prov_t* prov, int proc_idx, size_t ep_idx) {
+    if (prov->lazy_addr_table) {
+        fi_addr_t* addrs = prov->lazy_addr_table[proc_idx - prov->first_proc_idx].load(
+            std::memory_order_acquire);
+        if (!addrs) {
+            atl_ofi_ctx_t* ofi_ctx = container_of(ctx, atl_ofi_ctx_t, ctx);
+            addrs = atl_ofi_prov_resolve_addr(ofi_ctx, prov, proc_idx);
+        }
+        return addrs[ep_idx];
+    }
     return *(prov->addr_table + ((ctx->ep_count * (proc_idx - prov->first_proc_idx)) + ep_idx));
 }
 
+fi_addr_t* atl_ofi_prov_resolve_addr(atl_ofi_ctx_t* ofi_ctx, atl_ofi_prov_t* prov, int proc_idx) {
+    CCL_THROW_IF_NOT(ofi_ctx->lazy_connect, "lazy connect is not enabled");
+
+    atl_ctx_t* ctx = &(ofi_ctx->ctx);
+    size_t named_ep_count = (prov->sep ? 1 : ctx->ep_count);
+
+    std::lock_guard<std::mutex> lock(ofi_ctx->lazy_connect->mutex);
+
+    auto& entry = prov->lazy_addr_table[proc_idx - prov->first_proc_idx];
+    fi_addr_t* addrs = entry.load(std::memory_order_relaxed);
+    if (addrs) {
+        /* resolved by another worker */
+        return addrs;
+    }
+
+    std::vector<int> ep_name_idxs;
+    for (size_t ep_idx = 0; ep_idx < named_ep_count; ep_idx++) {
+        ep_name_idxs.push_back(proc_idx * ATL_OFI_PMI_PROC_MULTIPLIER +
+                               prov->idx * ATL_OFI_PMI_PROV_MULTIPLIER + ep_idx);
+    }
+
+    std::vector<char> ep_names(named_ep_count * prov->addr_len);
+    atl_status_t ret = ofi_ctx->lazy_connect->pmi->pmrt_kvs_get_bulk(
+        (char*)ATL_OFI_FI_ADDR_PM_KEY, ep_name_idxs, ep_names.data(), prov->addr_len);
+    CCL_THROW_IF_NOT(ret == ATL_STATUS_SUCCESS, "failed to get names of proc ", proc_idx);
+
+    addrs = new fi_addr_t[ctx->ep_count];
+    int insert_count =
+        fi_av_insert(prov->av, ep_names.data(), named_ep_count, addrs, 0, nullptr);
+    CCL_THROW_IF_NOT(insert_count == (int)named_ep_count,
+                     "unexpected av_insert results for proc ",
+                     proc_idx,
+                     ": expected ",
+                     named_ep_count,
+                     " got ",
+                     insert_count);
+
+    if (prov->sep) {
+        fi_addr_t base_addr = addrs[0];
+        for (size_t ep_idx = 0; ep_idx < ctx->ep_count; ep_idx++) {
+            addrs[ep_idx] = fi_rx_addr(base_addr, ep_idx, prov->rx_ctx_bits);
+        }
+    }
+
+    prov->lazy_resolved_count++;
+    entry.store(addrs, std::memory_order_release);
+
+    LOG_DEBUG("resolved proc ",
+              proc_idx,
+              ", prov ",
+              atl_ofi_get_nic_name(prov->info),
+              ", resolved ",
+              prov->lazy_resolved_count,
+              " of ",
+              prov->proc_count);
+
+    return addrs;
+}
+
+size_t atl_ofi_prov_get_addr_table_bytes(atl_ctx_t* ctx, atl_ofi_prov_t* prov) {
+    if (prov->lazy_addr_table) {
+        return prov->proc_count * sizeof(std::atomic<fi_addr_t*>) +
+               prov->lazy_resolved_count * ctx->ep_count * sizeof(fi_addr_t);
+    }
+    return (prov->addr_table) ? prov->proc_count * ctx->ep_count * sizeof(fi_addr_t) : 0;
+}
+
+static void atl_ofi_prov_free_lazy_addr_table(atl_ofi_prov_t* prov) {
+    if (!prov->lazy_addr_table)
+        return;
+
+    for (size_t idx = 0; idx < prov->proc_count; idx++) {
+        delete[] prov->lazy_addr_table[idx].load();
+    }
+    delete[] prov->lazy_addr_table;
+    prov->lazy_addr_table = nullptr;
+    prov->lazy_resolved_count = 0;
+}
+
 atl_status_t atl_ofi_get_local_proc_coord(atl_ofi_ctx_t* ofi_ctx, std::shared_ptr<ipmi> pmi) {
     CCL_THROW_IF_NOT(ofi_ctx, "ofi_ctx is null");
 
@@ -191,6 +296,7 @@ atl_status_t atl_ofi_get_local_proc_coord(atl_ofi_ctx_t* ofi_ctx, std::shared_pt
     int i;
     int local_idx = 0, local_count = 0;
     char* all_hostnames = nullptr;
+    std::vector<int> hostname_idxs;
     char my_hostname[ATL_MAX_HOSTNAME_LEN] = { 0 };
     size_t my_hostname_len = 0;
     int my_global_proc_idx = coord->global_idx;
@@ -233,14 +339,14 @@ atl_status_t atl_ofi_get_local_proc_coord(atl_ofi_ctx_t* ofi_ctx, std::shared_pt
     }
 
     for (i = 0; i < coord->global_count; i++) {
-        ret = pmi->pmrt_kvs_get((char*)ATL_OFI_HOSTNAME_PM_KEY,
-                                i * ATL_OFI_PMI_PROC_MULTIPLIER,
-                                all_hostnames + i * ATL_MAX_HOSTNAME_LEN,
-                                ATL_MAX_HOSTNAME_LEN);
-        if (ret) {
-            LOG_ERROR("pmrt_kvs_get: ret: ", ret);
-            goto fn_err;
-        }
+        hostname_idxs.push_back(i * ATL_OFI_PMI_PROC_MULTIPLIER);
+    }
+
+    ret = pmi->pmrt_kvs_get_bulk(
+        (char*)ATL_OFI_HOSTNAME_PM_KEY, hostname_idxs, all_hostnames, ATL_MAX_HOSTNAME_LEN);
+    if (ret) {
+        LOG_ERROR("pmrt_kvs_get_bulk: ret: ", ret);
+        goto fn_err;
     }
 
     for (i = 0; i < coord->global_count; i++) {
@@ -285,6 +391,7 @@ atl_status_t atl_ofi_prov_update_addr_table(atl_ofi_ctx_t* ofi_ctx,
     size_t addr_idx = 0;
     char* ep_names_table;
     size_t ep_names_table_len;
+    std::vector<int> ep_name_idxs;
 
     size_t named_ep_count = (prov->sep ? 1 : ctx->ep_count);
 
@@ -300,6 +407,16 @@ atl_status_t atl_ofi_prov_update_addr_table(atl_ofi_ctx_t* ofi_ctx,
     if (proc_count == 0)
         return ATL_STATUS_SUCCESS;
 
+    atl_ofi_prov_free_lazy_addr_table(prov);
+    prov->proc_count = proc_count;
+
+    if (ofi_ctx->lazy_connect) {
+        /* names are read and inserted into AV on first communication with peer */
+        prov->lazy_addr_table = new std::atomic<fi_addr_t*>[proc_count]();
+        ATL_CHECK_STATUS(pmi->pmrt_barrier(), "barrier failed");
+        return ATL_STATUS_SUCCESS;
+    }
+
     LOG_DEBUG("name ",
               atl_ofi_get_nic_name(prov->info),
               ", is_shm ",
@@ -343,28 +460,20 @@ atl_status_t atl_ofi_prov_update_addr_table(atl_ofi_ctx_t* ofi_ctx,
         }
 
         for (j = 0; j < named_ep_count; j++) {
-            ret = pmi->pmrt_kvs_get(
-                (char*)ATL_OFI_FI_ADDR_PM_KEY,
-                i * ATL_OFI_PMI_PROC_MULTIPLIER + prov_idx * ATL_OFI_PMI_PROV_MULTIPLIER + j,
-                ep_names_table + addr_idx * prov->addr_len,
-                prov->addr_len);
-
-            if (ret) {
-                LOG_ERROR("kvs_get error: ret ",
-                          ret,
-                          ", proc_idx ",
-                          i,
-                          ", ep_idx ",
-                          j,
-                          ", addr_idx ",
-                          addr_idx);
-                goto err_ep_names;
-            }
-
-            addr_idx++;
+            ep_name_idxs.push_back(i * ATL_OFI_PMI_PROC_MULTIPLIER +
+                                   prov_idx * ATL_OFI_PMI_PROV_MULTIPLIER + j);
         }
     }
 
+    /* fetch all names with single request instead of one request per EP */
+    ret = pmi->pmrt_kvs_get_bulk(
+        (char*)ATL_OFI_FI_ADDR_PM_KEY, ep_name_idxs, ep_names_table, prov->addr_len);
+    if (ret) {
+        LOG_ERROR("kvs_get error: ret ", ret, ", addr_count ", ep_name_idxs.size());
+        goto err_ep_names;
+    }
+    addr_idx = ep_name_idxs.size();
+
     LOG_DEBUG(
         "kvs_get: ep_count ", named_ep_count, ", proc_count ", proc_count, ", got ", addr_idx);
 
@@ -499,6 +608,7 @@ atl_status_t atl_ofi_prov_eps_connect(atl_ofi_ctx_t* ofi_ctx,
     atl_ofi_prov_t* prov = &(ofi_ctx->provs[prov_idx]);
     size_t named_ep_count = (prov->sep ? 1 : ctx->ep_count);
     atl_proc_coord_t* coord = &(ctx->coord);
+    auto connect_start = std::chrono::steady_clock::now();
 
     prov->addr_len = 0;
     prov->first_proc_idx =
@@ -527,6 +637,19 @@ atl_status_t atl_ofi_prov_eps_connect(atl_ofi_ctx_t* ofi_ctx,
 
     ret = atl_ofi_prov_update_addr_table(ofi_ctx, prov_idx, pmi);
 
+    if (coord->global_idx == 0) {
+        LOG_INFO("prov ",
+                 atl_ofi_get_nic_name(prov->info),
+                 ": connect time ",
+                 std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                           connect_start)
+                     .count(),
+                 " usec, addr table ",
+                 atl_ofi_prov_get_addr_table_bytes(ctx, prov),
+                 " bytes, lazy_connect ",
+                 (ofi_ctx->lazy_connect != nullptr));
+    }
+
     return RET2ATL(ret);
 }
 
@@ -558,6 +681,7 @@ void atl_ofi_prov_destroy(atl_ctx_t* ctx, atl_ofi_prov_t* prov) {
 
     free(prov->eps);
     free(prov->addr_table);
+    atl_ofi_prov_free_lazy_addr_table(prov);
 
     if (prov->sep)
         fi_close(&prov->sep->fid);
@@ -954,6 +1078,7 @@ atl_status_t atl_ofi_prov_init(atl_ctx_t* ctx,
         LOG_INFO("  tx_ctx_cnt: ", info->domain_attr->tx_ctx_cnt);
         LOG_INFO("  max_ep_tx_ctx: ", info->domain_attr->max_ep_tx_ctx);
         LOG_INFO("  max_msg_size: ", info->ep_attr->max_msg_size);
+        LOG_INFO("  iov_limit: ", info->tx_attr->iov_limit, "/", info->rx_attr->iov_limit);
     }
 
     prov->info = fi_dupinfo(info);
@@ -964,6 +1089,10 @@ atl_status_t atl_ofi_prov_init(atl_ctx_t* ctx,
     }
 
     prov->max_msg_size = info->ep_attr->max_msg_size;
+    /* sendv/recvv don't register iov buffers, disable them when memory descriptors are required */
+    prov->iov_limit = ((info->domain_attr->mr_mode & FI_MR_LOCAL) || ofi_ctx->enable_hmem)
+                          ? 0
+                          : std::min(info->tx_attr->iov_limit, info->rx_attr->iov_limit);
 
     ATL_OFI_CALL(fi_fabric(info->fabric_attr, &prov->fabric, nullptr), ret, goto err);
 
@@ -1394,9 +1523,29 @@ err:
 }
 
 void atl_ofi_init_req(atl_req_t* req, atl_ofi_prov_ep_t* prov_ep, struct fid_ep* fi_ep) {
+    static_assert(sizeof(atl_ofi_req_t) <= sizeof(atl_req_t) - offsetof(atl_req_t, internal),
+                  "unexpected size of atl_ofi_req_t");
     atl_ofi_req_t* ofi_req = ((atl_ofi_req_t*)req->internal);
     ofi_req->prov_ep = prov_ep;
     ofi_req->fi_ep = fi_ep;
     ofi_req->comp_state = ATL_OFI_COMP_POSTED;
+    ofi_req->parent = nullptr;
+    ofi_req->stripes = nullptr;
+    ofi_req->stripe_count = 0;
+    ofi_req->pending_stripe_count = 0;
     req->is_completed = 0;
 }
+
+void atl_ofi_complete_stripe(atl_ofi_req_t* stripe) {
+    atl_ofi_req_t* parent = stripe->parent;
+    CCL_THROW_IF_NOT(parent->pending_stripe_count > 0, "unexpected stripe completion");
+
+    parent->recv_len += stripe->recv_len;
+    parent->pending_stripe_count--;
+
+    if (parent->pending_stripe_count == 0) {
+        delete[] parent->stripes;
+        parent->stripes = nullptr;
+        parent->comp_state = ATL_OFI_COMP_COMPLETED;
+    }
+}
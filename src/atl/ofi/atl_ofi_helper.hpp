@@ -15,9 +15,12 @@
 */
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
 #include <dlfcn.h>
 #include <inttypes.h>
 #include <math.h>
+#include <mutex>
 #include <rdma/fabric.h>
 #include <rdma/fi_cm.h>
 #include <rdma/fi_tagged.h>
@@ -62,7 +65,7 @@
 #define ATL_OFI_MAX_NW_PROV_COUNT   1024
 #define ATL_OFI_MAX_PROV_COUNT      (ATL_OFI_MAX_NW_PROV_COUNT + 1) /* NW and SHM providers */
 #define ATL_OFI_MAX_ACTIVE_PROV_COUNT \
-    2 /* by current scheme each EP may use only SHM and 1 NW prov */
+    ATL_OFI_MAX_PROV_COUNT /* SHM and 1 NW prov, or SHM and all NW provs with striping */
 #define ATL_OFI_SHM_PROV_NAME "shm"
 
 #define ATL_OFI_MAX_ZE_DEV_COUNT 1024
@@ -167,6 +170,10 @@ typedef struct {
     struct fid_ep* rx;
     struct fid_cq* cq;
     atl_ofi_prov_ep_name_t name;
+
+    /* bytes posted through send/recv path */
+    size_t tx_bytes;
+    size_t rx_bytes;
 } atl_ofi_prov_ep_t;
 
 typedef struct {
@@ -179,6 +186,7 @@ typedef struct {
 
     int is_shm;
     size_t max_msg_size;
+    size_t iov_limit;
 
     /* used only in case of SEP supported */
     struct fid_ep* sep;
@@ -188,6 +196,11 @@ typedef struct {
     fi_addr_t* addr_table;
     size_t addr_len;
     int first_proc_idx;
+    size_t proc_count;
+
+    /* lazy connect only: table[0..proc_count] -> [0..ep_count], filled on first use */
+    std::atomic<fi_addr_t*>* lazy_addr_table;
+    size_t lazy_resolved_count;
 } atl_ofi_prov_t;
 
 typedef struct {
@@ -199,6 +212,14 @@ typedef struct {
 
 } atl_ofi_ep_t;
 
+/* state of on-demand peer address resolution, see CCL_ATL_LAZY_CONNECT */
+typedef struct atl_ofi_lazy_connect {
+    /* names of peers are read from KVS with the same PMI which published them */
+    std::shared_ptr<ipmi> pmi;
+    /* serializes PMI access and AV insertion from different workers */
+    std::mutex mutex;
+} atl_ofi_lazy_connect_t;
+
 typedef struct {
     atl_ctx_t ctx;
     pm_rt_desc_t* pm_rt;
@@ -215,15 +236,23 @@ typedef struct {
     size_t mnic_count;
     atl_mnic_offset_t mnic_offset;
     int enable_hmem;
+    atl_ofi_lazy_connect_t* lazy_connect;
+    size_t stripe_threshold;
 } atl_ofi_ctx_t;
 
-typedef struct {
+typedef struct atl_ofi_req {
     struct fi_context fi_ctx;
     atl_ofi_prov_ep_t* prov_ep;
     struct fid_ep* fi_ep;
     atl_ofi_comp_state_t comp_state;
     size_t recv_len;
     struct fid_mr* mr;
+
+    /* striped request: one stripe per NW provider, completed by the last stripe */
+    struct atl_ofi_req* parent;
+    struct atl_ofi_req* stripes;
+    size_t stripe_count;
+    size_t pending_stripe_count;
 } atl_ofi_req_t;
 
 #ifdef CCL_ENABLE_OFI_HMEM
@@ -276,6 +305,12 @@ std::string atl_ofi_get_short_nic_name(const struct fi_info* prov);
 std::string atl_ofi_get_nic_name(const struct fi_info* prov);
 atl_ofi_prov_t* atl_ofi_get_prov(atl_ep_t* ep, int peer_proc_idx, size_t msg_size);
 fi_addr_t atl_ofi_get_addr(atl_ctx_t* ctx, atl_ofi_prov_t* prov, int proc_idx, size_t ep_idx);
+size_t atl_ofi_get_stripe_count(atl_ofi_ctx_t* ofi_ctx,
+                                atl_ofi_prov_t* prov,
+                                size_t msg_size,
+                                size_t* stripe_size);
+fi_addr_t* atl_ofi_prov_resolve_addr(atl_ofi_ctx_t* ofi_ctx, atl_ofi_prov_t* prov, int proc_idx);
+size_t atl_ofi_prov_get_addr_table_bytes(atl_ctx_t* ctx, atl_ofi_prov_t* prov);
 atl_status_t atl_ofi_get_local_proc_coord(atl_ofi_ctx_t* ofi_ctx, std::shared_ptr<ipmi> pmi);
 atl_status_t atl_ofi_prov_update_addr_table(atl_ofi_ctx_t* ofi_ctx,
                                             size_t prov_idx,
@@ -310,3 +345,4 @@ atl_status_t atl_ofi_open_nw_provs(atl_ctx_t* ctx,
                                    atl_attr_t* attr,
                                    std::shared_ptr<ipmi> pmi);
 void atl_ofi_init_req(atl_req_t* req, atl_ofi_prov_ep_t* prov_ep, struct fid_ep* fi_ep);
+void atl_ofi_complete_stripe(atl_ofi_req_t* stripe);
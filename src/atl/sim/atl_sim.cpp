@@ -0,0 +1,395 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "atl/sim/atl_sim.hpp"
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+
+static size_t atl_sim_iov_len(const struct iovec* iov, size_t iov_count) {
+    size_t len = 0;
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        len += iov[idx].iov_len;
+    }
+    return len;
+}
+
+static void atl_sim_gather(const struct iovec* iov, size_t iov_count, char* dst) {
+    for (size_t idx = 0; idx < iov_count; idx++) {
+        memcpy(dst, iov[idx].iov_base, iov[idx].iov_len);
+        dst += iov[idx].iov_len;
+    }
+}
+
+static size_t atl_sim_copy(const struct iovec* src_iov,
+                           size_t src_iov_count,
+                           const struct iovec* dst_iov,
+                           size_t dst_iov_count,
+                           uint64_t tag) {
+    size_t copied = 0;
+    size_t src_idx = 0, src_offset = 0;
+    size_t dst_idx = 0, dst_offset = 0;
+
+    while (src_idx < src_iov_count && dst_idx < dst_iov_count) {
+        size_t bytes = std::min(src_iov[src_idx].iov_len - src_offset,
+                                dst_iov[dst_idx].iov_len - dst_offset);
+        memcpy(static_cast<char*>(dst_iov[dst_idx].iov_base) + dst_offset,
+               static_cast<const char*>(src_iov[src_idx].iov_base) + src_offset,
+               bytes);
+        copied += bytes;
+        src_offset += bytes;
+        dst_offset += bytes;
+        if (src_offset == src_iov[src_idx].iov_len) {
+            src_idx++;
+            src_offset = 0;
+        }
+        if (dst_offset == dst_iov[dst_idx].iov_len) {
+            dst_idx++;
+            dst_offset = 0;
+        }
+    }
+
+    size_t len = atl_sim_iov_len(src_iov, src_iov_count);
+    if (copied < len) {
+        LOG_ERROR("message truncated: tag ", tag, ", len ", len, ", recv buffer len ", copied);
+    }
+
+    return copied;
+}
+
+static atl_sim_req_t* atl_sim_get_req(atl_req_t* req) {
+    static_assert(sizeof(atl_sim_req_t) <= sizeof(atl_req_t) - offsetof(atl_req_t, internal),
+                  "unexpected size of atl_sim_req_t");
+    return reinterpret_cast<atl_sim_req_t*>(req->internal);
+}
+
+atl_sim_fabric::atl_sim_fabric(int size) : size(size) {
+    auto& env = ccl::global_data::env();
+
+    ranks_per_node = static_cast<int>(env.sim_ranks_per_node);
+
+    links[link_intra].latency = env.sim_intra_latency;
+    links[link_intra].bytes_per_ns = env.sim_intra_bandwidth / 1000.0;
+    links[link_inter].latency = env.sim_latency;
+    links[link_inter].bytes_per_ns = env.sim_bandwidth / 1000.0;
+
+    nics.reserve(size);
+    for (int idx = 0; idx < size; idx++) {
+        nics.emplace_back(new nic_t());
+    }
+}
+
+uint64_t atl_sim_fabric::get_time() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t atl_sim_fabric::get_delivery_time(int src, int dst, size_t bytes) {
+    int link_idx = (get_node_idx(src) == get_node_idx(dst)) ? link_intra : link_inter;
+    const link_t& link = links[link_idx];
+
+    uint64_t xfer_time =
+        (link.bytes_per_ns > 0) ? static_cast<uint64_t>(bytes / link.bytes_per_ns) : 0;
+    uint64_t now = get_time();
+    uint64_t tx_end_time, rx_end_time;
+
+    {
+        nic_t& nic = *nics[src];
+        std::lock_guard<ccl_spinlock> lock(nic.guard);
+        tx_end_time = std::max(now, nic.tx_free_time[link_idx]) + xfer_time;
+        nic.tx_free_time[link_idx] = tx_end_time;
+    }
+
+    {
+        nic_t& nic = *nics[dst];
+        std::lock_guard<ccl_spinlock> lock(nic.guard);
+        rx_end_time =
+            std::max(tx_end_time + link.latency, nic.rx_free_time[link_idx] + xfer_time);
+        nic.rx_free_time[link_idx] = rx_end_time;
+    }
+
+    return rx_end_time;
+}
+
+atl_sim_world::atl_sim_world(std::shared_ptr<atl_sim_fabric> fabric, std::vector<int> fabric_ranks)
+        : fabric(fabric),
+          fabric_ranks(std::move(fabric_ranks)),
+          split_counts(this->fabric_ranks.size(), 0) {
+    mailboxes.reserve(this->fabric_ranks.size());
+    for (size_t idx = 0; idx < this->fabric_ranks.size(); idx++) {
+        mailboxes.emplace_back(new mailbox_t());
+    }
+}
+
+std::shared_ptr<atl_sim_world> atl_sim_world::join(int size, int rank) {
+    struct pending_world_t {
+        std::shared_ptr<atl_sim_world> world;
+        int joined = 0;
+    };
+
+    static std::mutex join_mutex;
+    static std::condition_variable join_cond;
+    /* (size, rank) -> number of worlds joined by rank */
+    static std::map<std::pair<int, int>, size_t> join_counts;
+    /* (size, join index) -> world which is not joined by all ranks yet */
+    static std::map<std::pair<int, size_t>, pending_world_t> pending_worlds;
+
+    CCL_THROW_IF_NOT(rank >= 0 && rank < size, "unexpected rank ", rank, ", size ", size);
+
+    std::unique_lock<std::mutex> lock(join_mutex);
+
+    auto key = std::make_pair(size, join_counts[std::make_pair(size, rank)]++);
+    auto& pending = pending_worlds[key];
+    if (!pending.world) {
+        std::vector<int> fabric_ranks(size);
+        for (int idx = 0; idx < size; idx++) {
+            fabric_ranks[idx] = idx;
+        }
+        pending.world = std::make_shared<atl_sim_world>(std::make_shared<atl_sim_fabric>(size),
+                                                        fabric_ranks);
+    }
+
+    auto world = pending.world;
+    if (++pending.joined == size) {
+        pending_worlds.erase(key);
+        join_cond.notify_all();
+    }
+    else {
+        join_cond.wait(lock, [&key]() {
+            return pending_worlds.find(key) == pending_worlds.end();
+        });
+    }
+
+    return world;
+}
+
+std::shared_ptr<atl_sim_world> atl_sim_world::split(int rank, int color, int* new_rank) {
+    int size = get_size();
+
+    std::unique_lock<std::mutex> lock(split_mutex);
+
+    size_t split_idx = split_counts[rank]++;
+    split_t& split = splits[split_idx];
+    if (split.colors.empty()) {
+        split.colors.resize(size);
+    }
+    split.colors[rank] = color;
+
+    if (++split.arrived == size) {
+        std::map<int, std::vector<int>> color_ranks;
+        for (int idx = 0; idx < size; idx++) {
+            color_ranks[split.colors[idx]].push_back(fabric_ranks[idx]);
+        }
+        for (auto& it : color_ranks) {
+            split.worlds[it.first] = std::make_shared<atl_sim_world>(fabric, it.second);
+        }
+        split_cond.notify_all();
+    }
+    else {
+        split_cond.wait(lock, [&split, size]() {
+            return split.arrived == size;
+        });
+    }
+
+    *new_rank = static_cast<int>(
+        std::count(split.colors.begin(), split.colors.begin() + rank, color));
+    auto world = split.worlds[color];
+
+    if (++split.departed == size) {
+        splits.erase(split_idx);
+    }
+
+    return world;
+}
+
+atl_status_t atl_sim_world::send(int src,
+                                 int dst,
+                                 uint64_t tag,
+                                 const struct iovec* iov,
+                                 size_t iov_count,
+                                 atl_req_t* req) {
+    size_t len = atl_sim_iov_len(iov, iov_count);
+    uint64_t ready_time = fabric->get_delivery_time(fabric_ranks[src], fabric_ranks[dst], len);
+
+    mailbox_t& mailbox = *mailboxes[dst];
+    {
+        std::lock_guard<ccl_spinlock> lock(mailbox.guard);
+
+        auto it = mailbox.posted.find(std::make_pair(src, tag));
+        if (it != mailbox.posted.end()) {
+            posted_recv_t posted = std::move(it->second.front());
+            it->second.pop_front();
+            if (it->second.empty()) {
+                mailbox.posted.erase(it);
+            }
+
+            atl_sim_req_t* recv_req = atl_sim_get_req(posted.req);
+            recv_req->len =
+                atl_sim_copy(iov, iov_count, posted.iov.data(), posted.iov.size(), tag);
+            recv_req->ready_time = ready_time;
+            recv_req->is_matched = 1;
+        }
+        else {
+            message_t message;
+            message.data.resize(len);
+            message.ready_time = ready_time;
+            atl_sim_gather(iov, iov_count, message.data.data());
+            mailbox.unexpected[std::make_pair(src, tag)].push_back(std::move(message));
+        }
+    }
+
+    /* sender's request is accessed by sender's rank only */
+    req->is_completed = 0;
+    atl_sim_req_t* sim_req = atl_sim_get_req(req);
+    sim_req->len = len;
+    sim_req->ready_time = ready_time;
+    sim_req->src = src;
+    sim_req->tag = tag;
+    sim_req->is_matched = 1;
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_world::recv(int dst,
+                                 int src,
+                                 uint64_t tag,
+                                 const struct iovec* iov,
+                                 size_t iov_count,
+                                 atl_req_t* req) {
+    req->is_completed = 0;
+    atl_sim_req_t* sim_req = atl_sim_get_req(req);
+    sim_req->src = src;
+    sim_req->tag = tag;
+
+    mailbox_t& mailbox = *mailboxes[dst];
+    std::lock_guard<ccl_spinlock> lock(mailbox.guard);
+
+    auto key = std::make_pair(src, tag);
+    auto it = mailbox.unexpected.find(key);
+    if (it != mailbox.unexpected.end()) {
+        message_t message = std::move(it->second.front());
+        it->second.pop_front();
+        if (it->second.empty()) {
+            mailbox.unexpected.erase(it);
+        }
+
+        struct iovec message_iov = { message.data.data(), message.data.size() };
+        sim_req->len = atl_sim_copy(&message_iov, 1, iov, iov_count, tag);
+        sim_req->ready_time = message.ready_time;
+        sim_req->is_matched = 1;
+    }
+    else {
+        sim_req->len = 0;
+        sim_req->ready_time = 0;
+        sim_req->is_matched = 0;
+
+        posted_recv_t posted;
+        posted.req = req;
+        posted.iov.assign(iov, iov + iov_count);
+        mailbox.posted[key].push_back(std::move(posted));
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_world::probe(int dst, int src, uint64_t tag, int* found, size_t* recv_len) {
+    *found = 0;
+
+    mailbox_t& mailbox = *mailboxes[dst];
+    std::lock_guard<ccl_spinlock> lock(mailbox.guard);
+
+    auto it = mailbox.unexpected.find(std::make_pair(src, tag));
+    if (it != mailbox.unexpected.end() &&
+        it->second.front().ready_time <= atl_sim_fabric::get_time()) {
+        *found = 1;
+        if (recv_len) {
+            *recv_len = it->second.front().data.size();
+        }
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_world::check(int rank, atl_req_t* req) {
+    if (req->is_completed) {
+        return ATL_STATUS_SUCCESS;
+    }
+
+    atl_sim_req_t* sim_req = atl_sim_get_req(req);
+    uint64_t ready_time;
+
+    {
+        /* receiver's request is matched by sender under receiver's lock */
+        std::lock_guard<ccl_spinlock> lock(mailboxes[rank]->guard);
+        if (!sim_req->is_matched) {
+            return ATL_STATUS_SUCCESS;
+        }
+        ready_time = sim_req->ready_time;
+    }
+
+    if (atl_sim_fabric::get_time() >= ready_time) {
+        req->is_completed = 1;
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_world::cancel(int rank, atl_req_t* req) {
+    atl_sim_req_t* sim_req = atl_sim_get_req(req);
+
+    mailbox_t& mailbox = *mailboxes[rank];
+    std::lock_guard<ccl_spinlock> lock(mailbox.guard);
+
+    auto it = mailbox.posted.find(std::make_pair(sim_req->src, sim_req->tag));
+    if (it != mailbox.posted.end()) {
+        auto& queue = it->second;
+        queue.erase(std::remove_if(queue.begin(),
+                                   queue.end(),
+                                   [req](const posted_recv_t& posted) {
+                                       return posted.req == req;
+                                   }),
+                    queue.end());
+        if (queue.empty()) {
+            mailbox.posted.erase(it);
+        }
+    }
+
+    req->is_completed = 1;
+
+    return ATL_STATUS_SUCCESS;
+}
+
+void atl_sim_world::get_proc_coord(int rank, atl_proc_coord_t* coord) const {
+    int node_idx = fabric->get_node_idx(fabric_ranks[rank]);
+
+    coord->global_idx = rank;
+    coord->global_count = get_size();
+    coord->local_idx = 0;
+    coord->local_count = 0;
+    for (int idx = 0; idx < get_size(); idx++) {
+        if (fabric->get_node_idx(fabric_ranks[idx]) == node_idx) {
+            if (idx == rank) {
+                coord->local_idx = coord->local_count;
+            }
+            coord->local_count++;
+        }
+    }
+    coord->hostname_hash = std::hash<std::string>{}("sim_node_" + std::to_string(node_idx));
+}
@@ -0,0 +1,170 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sys/uio.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "atl/atl_def.h"
+#include "common/utils/spinlock.hpp"
+
+/*
+ * Simulated transport: all ranks are threads of a single process
+ * and messages are passed through per-rank in-memory mailboxes.
+ *
+ * Delivery time of every message is computed by a simple link model:
+ * each rank owns a NIC which serializes outgoing and incoming messages
+ * (bytes / bandwidth) and the message reaches the peer after link latency.
+ * Ranks are grouped into simulated nodes, intra- and inter-node links
+ * have separate parameters (see CCL_ATL_SIM_* environment variables).
+ * Operation is not reported as completed before its modeled delivery time.
+ */
+
+typedef struct {
+    uint64_t ready_time;
+    size_t len;
+    int is_matched;
+    int src;
+    uint64_t tag;
+} atl_sim_req_t;
+
+class atl_sim_fabric {
+public:
+    atl_sim_fabric(int size);
+
+    atl_sim_fabric(const atl_sim_fabric& other) = delete;
+    atl_sim_fabric& operator=(const atl_sim_fabric& other) = delete;
+
+    int get_size() const {
+        return size;
+    }
+
+    int get_node_idx(int fabric_rank) const {
+        return fabric_rank / ranks_per_node;
+    }
+
+    uint64_t get_delivery_time(int src, int dst, size_t bytes);
+
+    static uint64_t get_time();
+
+private:
+    enum link_type { link_intra = 0, link_inter = 1, link_count = 2 };
+
+    struct link_t {
+        uint64_t latency;
+        double bytes_per_ns;
+    };
+
+    struct nic_t {
+        ccl_spinlock guard;
+        uint64_t tx_free_time[link_count] = {};
+        uint64_t rx_free_time[link_count] = {};
+    };
+
+    int size;
+    int ranks_per_node;
+    link_t links[link_count];
+    std::vector<std::unique_ptr<nic_t>> nics;
+};
+
+/* group of simulated ranks which exchange messages, one per ATL communicator */
+class atl_sim_world {
+public:
+    atl_sim_world(std::shared_ptr<atl_sim_fabric> fabric, std::vector<int> fabric_ranks);
+
+    atl_sim_world(const atl_sim_world& other) = delete;
+    atl_sim_world& operator=(const atl_sim_world& other) = delete;
+
+    /* blocks until all ranks of top-level world of given size join it */
+    static std::shared_ptr<atl_sim_world> join(int size, int rank);
+
+    /* collective over all ranks of the world, similar to MPI_Comm_split */
+    std::shared_ptr<atl_sim_world> split(int rank, int color, int* new_rank);
+
+    atl_status_t send(int src,
+                      int dst,
+                      uint64_t tag,
+                      const struct iovec* iov,
+                      size_t iov_count,
+                      atl_req_t* req);
+    atl_status_t recv(int dst,
+                      int src,
+                      uint64_t tag,
+                      const struct iovec* iov,
+                      size_t iov_count,
+                      atl_req_t* req);
+    atl_status_t probe(int dst, int src, uint64_t tag, int* found, size_t* recv_len);
+    atl_status_t check(int rank, atl_req_t* req);
+    atl_status_t cancel(int rank, atl_req_t* req);
+
+    int get_size() const {
+        return static_cast<int>(fabric_ranks.size());
+    }
+
+    const std::vector<int>& get_fabric_ranks() const {
+        return fabric_ranks;
+    }
+
+    void get_proc_coord(int rank, atl_proc_coord_t* coord) const;
+
+private:
+    using match_key_t = std::pair<int, uint64_t>;
+
+    struct match_key_hasher {
+        size_t operator()(const match_key_t& key) const {
+            return std::hash<uint64_t>()(key.second) ^ (std::hash<int>()(key.first) << 1);
+        }
+    };
+
+    struct message_t {
+        std::vector<char> data;
+        uint64_t ready_time;
+    };
+
+    struct posted_recv_t {
+        atl_req_t* req;
+        std::vector<struct iovec> iov;
+    };
+
+    struct mailbox_t {
+        ccl_spinlock guard;
+        std::unordered_map<match_key_t, std::deque<message_t>, match_key_hasher> unexpected;
+        std::unordered_map<match_key_t, std::deque<posted_recv_t>, match_key_hasher> posted;
+    };
+
+    struct split_t {
+        std::vector<int> colors;
+        int arrived = 0;
+        int departed = 0;
+        std::map<int, std::shared_ptr<atl_sim_world>> worlds;
+    };
+
+    std::shared_ptr<atl_sim_fabric> fabric;
+    std::vector<int> fabric_ranks;
+    std::vector<std::unique_ptr<mailbox_t>> mailboxes;
+
+    std::mutex split_mutex;
+    std::condition_variable split_cond;
+    std::vector<size_t> split_counts;
+    std::map<size_t, split_t> splits;
+};
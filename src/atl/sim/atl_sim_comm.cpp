@@ -0,0 +1,116 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "atl/sim/atl_sim_comm.hpp"
+#include "exec/exec.hpp"
+
+atl_sim_comm::atl_sim_comm(int total_rank_count,
+                           const std::vector<int>& ranks,
+                           std::shared_ptr<ikvs_wrapper> k) {
+    /* all ranks are in the same process, so KVS is not needed for rendezvous */
+    CCL_THROW_IF_NOT(ranks.size() == 1,
+                     "sim transport supports single rank per communicator object, got ",
+                     ranks.size());
+
+    world = atl_sim_world::join(total_rank_count, ranks[0]);
+
+    parent_rank = rank = ranks[0];
+    parent_size = size = total_rank_count;
+
+    rank2rank_map.resize(size);
+    for (int i = 0; i < size; i++) {
+        rank2rank_map[i] = i;
+    }
+
+    init_transport();
+}
+
+atl_sim_comm::atl_sim_comm(atl_sim_comm* parent, int color) {
+    parent_rank = parent->parent_rank;
+    parent_size = parent->parent_size;
+
+    world = parent->world->split(parent->rank, color, &rank);
+    size = world->get_size();
+    rank2rank_map = world->get_fabric_ranks();
+
+    init_transport();
+}
+
+void atl_sim_comm::init_transport() {
+    static std::mutex memory_mutex;
+    std::lock_guard<std::mutex> lock(memory_mutex);
+
+    if (!attr.out.tag_bits) {
+        attr.out.enable_shm = 0;
+        attr.out.enable_rma = 0;
+        attr.out.enable_hmem = 0;
+        attr.out.mnic_type = ATL_MNIC_NONE;
+        attr.out.mnic_count = 1;
+        attr.out.tag_bits = 64;
+        attr.out.max_tag = 0xFFFFFFFFFFFFFFFF;
+        attr.out.max_order_waw_size = 0;
+
+        if (rank == 0) {
+            print_atl_attrs();
+        }
+    }
+
+    world->get_proc_coord(rank, &coord);
+    threads_per_process = 1;
+    ranks_per_process = 1;
+
+    init_tag();
+
+    /* simulated ranks share the process, so workers are started once using all its cores */
+    if (!executor->are_workers_started()) {
+        executor->start_workers(0, 1);
+    }
+}
+
+std::shared_ptr<atl_base_comm> atl_sim_comm::comm_split(int color) {
+    return std::shared_ptr<atl_base_comm>(new atl_sim_comm(this, color));
+}
+
+atl_status_t atl_sim_comm::mr_reg(const void* buf, size_t len, atl_mr_t** mr) {
+    atl_mr_t* sim_mr = new atl_mr_t();
+    sim_mr->buf = const_cast<void*>(buf);
+    sim_mr->len = len;
+    sim_mr->local_key = 0;
+    sim_mr->remote_key = 0;
+    *mr = sim_mr;
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_comm::mr_dereg(atl_mr_t* mr) {
+    delete mr;
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_sim_comm::wait(size_t ep_idx, atl_req_t* req) {
+    atl_status_t ret = ATL_STATUS_SUCCESS;
+
+    while (!req->is_completed && (ret == ATL_STATUS_SUCCESS)) {
+        ret = check(ep_idx, req);
+    }
+
+    return ret;
+}
+
+atl_status_t atl_sim_comm::wait_all(size_t ep_idx, atl_req_t* req, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        ATL_CHECK_STATUS(wait(ep_idx, &req[i]), "wait failed");
+    }
+    return ATL_STATUS_SUCCESS;
+}
@@ -0,0 +1,263 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "atl/atl_base_comm.hpp"
+#include "atl/sim/atl_sim.hpp"
+
+class atl_sim_comm : public atl_base_comm {
+public:
+    ~atl_sim_comm() override = default;
+    atl_sim_comm(int total_rank_count,
+                 const std::vector<int>& ranks,
+                 std::shared_ptr<ikvs_wrapper> k);
+
+    atl_status_t main_addr_reserve(char* main_addr) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t finalize() override {
+        return ATL_STATUS_SUCCESS;
+    }
+
+    atl_status_t update() override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t wait_notification() override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t set_resize_function(atl_resize_fn_t fn) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t mr_reg(const void* buf, size_t len, atl_mr_t** mr) override;
+
+    atl_status_t mr_dereg(atl_mr_t* mr) override;
+
+    atl_status_t send(size_t ep_idx,
+                      const void* buf,
+                      size_t len,
+                      int dst_proc_idx,
+                      uint64_t tag,
+                      atl_req_t* req) override {
+        struct iovec iov = { const_cast<void*>(buf), len };
+        return sendv(ep_idx, &iov, 1, dst_proc_idx, tag, req);
+    }
+
+    atl_status_t recv(size_t ep_idx,
+                      void* buf,
+                      size_t len,
+                      int src_proc_idx,
+                      uint64_t tag,
+                      atl_req_t* req) override {
+        struct iovec iov = { buf, len };
+        return recvv(ep_idx, &iov, 1, src_proc_idx, tag, req);
+    }
+
+    atl_status_t sendv(size_t ep_idx,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int dst_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req) override {
+        return world->send(rank,
+                           dst_proc_idx,
+                           this->tag->strip_comm_id(tag),
+                           iov,
+                           iov_count,
+                           req);
+    }
+
+    atl_status_t recvv(size_t ep_idx,
+                       const struct iovec* iov,
+                       size_t iov_count,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       atl_req_t* req) override {
+        return world->recv(rank,
+                           src_proc_idx,
+                           this->tag->strip_comm_id(tag),
+                           iov,
+                           iov_count,
+                           req);
+    }
+
+    size_t get_iov_limit() override {
+        return iov_limit;
+    }
+
+    atl_status_t probe(size_t ep_idx,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       int* found,
+                       size_t* recv_len) override {
+        return world->probe(rank,
+                            src_proc_idx,
+                            this->tag->strip_comm_id(tag),
+                            found,
+                            recv_len);
+    }
+
+    atl_status_t allgatherv(size_t ep_idx,
+                            const void* send_buf,
+                            size_t send_len,
+                            void* recv_buf,
+                            const int* recv_lens,
+                            const int* offsets,
+                            atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t allreduce(size_t ep_idx,
+                           const void* send_buf,
+                           void* recv_buf,
+                           size_t len,
+                           atl_datatype_t dtype,
+                           atl_reduction_t op,
+                           atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t alltoall(size_t ep_idx,
+                          const void* send_buf,
+                          void* recv_buf,
+                          int len,
+                          atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t alltoallv(size_t ep_idx,
+                           const void* send_buf,
+                           const int* send_lens,
+                           const int* send_offsets,
+                           void* recv_buf,
+                           const int* recv_lens,
+                           const int* recv_offsets,
+                           atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t barrier(size_t ep_idx, atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t bcast(size_t ep_idx, void* buf, size_t len, int root, atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t reduce(size_t ep_idx,
+                        const void* send_buf,
+                        void* recv_buf,
+                        size_t len,
+                        int root,
+                        atl_datatype_t dtype,
+                        atl_reduction_t op,
+                        atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t reduce_scatter(size_t ep_idx,
+                                const void* send_buf,
+                                void* recv_buf,
+                                size_t recv_len,
+                                atl_datatype_t dtype,
+                                atl_reduction_t op,
+                                atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t read(size_t ep_idx,
+                      void* buf,
+                      size_t len,
+                      atl_mr_t* mr,
+                      uint64_t addr,
+                      uintptr_t remote_key,
+                      int dst_proc_idx,
+                      atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t write(size_t ep_idx,
+                       const void* buf,
+                       size_t len,
+                       atl_mr_t* mr,
+                       uint64_t addr,
+                       uintptr_t remote_key,
+                       int dst_proc_idx,
+                       atl_req_t* req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t wait(size_t ep_idx, atl_req_t* req) override;
+
+    atl_status_t wait_all(size_t ep_idx, atl_req_t* req, size_t count) override;
+
+    atl_status_t cancel(size_t ep_idx, atl_req_t* req) override {
+        return world->cancel(rank, req);
+    }
+
+    atl_status_t poll(size_t ep_idx) override {
+        return ATL_STATUS_SUCCESS;
+    }
+
+    atl_status_t check(size_t ep_idx, atl_req_t* req) override {
+        return world->check(rank, req);
+    }
+
+    size_t get_threads_per_process() override {
+        return threads_per_process;
+    }
+
+    size_t get_ranks_per_process() override {
+        return ranks_per_process;
+    }
+
+    int get_rank() override {
+        return rank;
+    }
+
+    int get_size() override {
+        return size;
+    }
+
+    int get_r2r_color() override {
+        return coord.local_idx;
+    }
+
+    int get_host_color() override {
+        return coord.hostname_hash;
+    }
+
+    size_t get_id() override {
+        return 0;
+    }
+
+    std::shared_ptr<atl_base_comm> comm_split(int color) override;
+
+    std::vector<int> get_rank2rank_map() override {
+        return rank2rank_map;
+    }
+
+private:
+    static const size_t iov_limit = 1024;
+
+    std::shared_ptr<atl_sim_world> world;
+
+    atl_sim_comm(atl_sim_comm* parent, int color);
+    void init_transport();
+};
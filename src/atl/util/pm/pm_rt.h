@@ -146,6 +146,8 @@ static inline atl_status_t pmrt_kvs_get(pm_rt_desc_t *pmrt_desc,
 #endif
 
 #ifdef __cplusplus
+#include <vector>
+
 class ipmi {
 public:
     virtual ~ipmi() noexcept(false){};
@@ -174,6 +176,25 @@ public:
                                       void *kvs_val,
                                       size_t kvs_val_len) = 0;
 
+    /**
+     * Gets values put by pmrt_kvs_put with kvs_key for every index from proc_idxs,
+     * i-th value is stored at kvs_vals + i * kvs_val_len.
+     * Runtimes which can access KVS in batches fetch all values in one request.
+     */
+    virtual atl_status_t pmrt_kvs_get_bulk(char *kvs_key,
+                                           const std::vector<int> &proc_idxs,
+                                           void *kvs_vals,
+                                           size_t kvs_val_len) {
+        for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+            ATL_CHECK_STATUS(pmrt_kvs_get(kvs_key,
+                                          proc_idxs[idx],
+                                          static_cast<char *>(kvs_vals) + idx * kvs_val_len,
+                                          kvs_val_len),
+                             "failed to get value");
+        }
+        return ATL_STATUS_SUCCESS;
+    }
+
     virtual int get_rank() = 0;
 
     virtual int get_size() = 0;
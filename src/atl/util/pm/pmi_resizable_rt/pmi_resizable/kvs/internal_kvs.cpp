@@ -18,6 +18,7 @@
 #include <ifaddrs.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <mutex>
 #include <pthread.h>
 #include <stdio.h>
@@ -33,120 +34,94 @@
 #include "common/log/log.hpp"
 #include "util/pm/pmi_resizable_rt/pmi_resizable/request_wrappers_k8s.hpp"
 
+kvs_status_t internal_kvs::kvs_request(const kvs_msg_t& request, kvs_msg_t* answer) {
+    if (!client_op_sock) {
+        LOG_ERROR("client: socket is closed, mode ", request.mode);
+        return KVS_STATUS_FAILURE;
+    }
+
+    /* request and answer are kept together when kvs is used from several threads */
+    std::lock_guard<std::mutex> lock(client_memory_mutex);
+    KVS_CHECK_STATUS(kvs_msg_send(client_op_sock, request), "client: failed to send request");
+    if (answer) {
+        KVS_CHECK_STATUS(kvs_msg_recv(client_op_sock, *answer), "client: failed to recv answer");
+        if (answer->mode != request.mode) {
+            LOG_ERROR("client: unexpected answer mode ", answer->mode, ", expected ", request.mode);
+            return KVS_STATUS_FAILURE;
+        }
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
 kvs_status_t internal_kvs::kvs_set_value(const char* kvs_name,
                                          const char* kvs_key,
                                          const char* kvs_val) {
-    kvs_request_t request;
-    request.mode = AM_PUT;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-    kvs_str_copy(request.val, kvs_val, MAX_KVS_VAL_LENGTH);
-
-    DO_RW_OP(write,
-             client_op_sock,
-             &request,
-             sizeof(kvs_request_t),
-             client_memory_mutex,
-             "client: put_key_value");
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_PUT, { kvs_name, kvs_key, kvs_val }), nullptr),
+                     "client: put_key_value");
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t internal_kvs::kvs_set_values(const char* kvs_name,
+                                          const std::vector<std::string>& kvs_keys,
+                                          const std::vector<std::string>& kvs_vals) {
+    if (kvs_keys.size() != kvs_vals.size()) {
+        LOG_ERROR("client: keys count ", kvs_keys.size(), " != values count ", kvs_vals.size());
+        return KVS_STATUS_FAILURE;
+    }
 
+    kvs_msg_t request(AM_PUT_BATCH, { kvs_name });
+    request.fields.reserve(1 + kvs_keys.size() * 2);
+    for (size_t idx = 0; idx < kvs_keys.size(); idx++) {
+        request.fields.push_back(kvs_keys[idx]);
+        request.fields.push_back(kvs_vals[idx]);
+    }
+    KVS_CHECK_STATUS(kvs_request(request, nullptr), "client: put_key_values");
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_set_size(const char* kvs_name,
                                         const char* kvs_key,
                                         const char* kvs_val) {
-    kvs_request_t request;
-    request.mode = AM_SET_SIZE;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-    kvs_str_copy(request.val, kvs_val, MAX_KVS_VAL_LENGTH);
-
-    DO_RW_OP(write,
-             client_op_sock,
-             &request,
-             sizeof(kvs_request_t),
-             client_memory_mutex,
-             "client: set_size");
-
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_SET_SIZE, { kvs_name, kvs_key, kvs_val }), nullptr),
+                     "client: set_size");
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_barrier_register(const char* kvs_name,
                                                 const char* kvs_key,
                                                 const char* kvs_val) {
-    kvs_request_t request;
-    request.mode = AM_BARRIER_REGISTER;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-    kvs_str_copy(request.val, kvs_val, MAX_KVS_VAL_LENGTH);
-
-    DO_RW_OP(write,
-             client_op_sock,
-             &request,
-             sizeof(kvs_request_t),
-             client_memory_mutex,
-             "client: barrier_register");
-
+    KVS_CHECK_STATUS(
+        kvs_request(kvs_msg_t(AM_BARRIER_REGISTER, { kvs_name, kvs_key, kvs_val }), nullptr),
+        "client: barrier_register");
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_barrier(const char* kvs_name,
                                        const char* kvs_key,
                                        const char* kvs_val) {
-    kvs_request_t request;
-    int is_done;
-
-    request.mode = AM_BARRIER;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-    kvs_str_copy(request.val, kvs_val, MAX_KVS_VAL_LENGTH);
-
-    DO_RW_OP(
-        write, client_op_sock, &request, sizeof(request), client_memory_mutex, "client: barrier");
-
-    DO_RW_OP(read,
-             client_op_sock,
-             &is_done,
-             sizeof(is_done),
-             client_memory_mutex,
-             "client: barrier read data");
+    kvs_msg_t answer;
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_BARRIER, { kvs_name, kvs_key, kvs_val }), &answer),
+                     "client: barrier");
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_remove_name_key(const char* kvs_name, const char* kvs_key) {
-    kvs_request_t request;
-    request.mode = AM_REMOVE;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-
-    DO_RW_OP(write,
-             client_op_sock,
-             &request,
-             sizeof(kvs_request_t),
-             client_memory_mutex,
-             "client: remove_key");
-
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_REMOVE, { kvs_name, kvs_key }), nullptr),
+                     "client: remove_key");
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_register(const char* kvs_name, const char* kvs_key, char* kvs_val) {
-    kvs_request_t request;
-    request.mode = AM_INTERNAL_REGISTER;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
-    kvs_str_copy(request.val, kvs_val, MAX_KVS_VAL_LENGTH);
+    kvs_msg_t answer;
+    KVS_CHECK_STATUS(
+        kvs_request(kvs_msg_t(AM_INTERNAL_REGISTER, { kvs_name, kvs_key, kvs_val }), &answer),
+        "client: register");
     memset(kvs_val, 0, MAX_KVS_VAL_LENGTH);
-
-    DO_RW_OP(
-        write, client_op_sock, &request, sizeof(request), client_memory_mutex, "client: register");
-
-    DO_RW_OP(read,
-             client_op_sock,
-             &request,
-             sizeof(request),
-             client_memory_mutex,
-             "client: register read data");
-    kvs_str_copy(kvs_val, request.val, MAX_KVS_VAL_LENGTH);
+    if (answer.fields.size() != 1) {
+        LOG_ERROR("client: unexpected register answer");
+        return KVS_STATUS_FAILURE;
+    }
+    kvs_str_copy(kvs_val, answer.fields[0].c_str(), MAX_KVS_VAL_LENGTH);
 
     return KVS_STATUS_SUCCESS;
 }
@@ -154,51 +129,48 @@ kvs_status_t internal_kvs::kvs_register(const char* kvs_name, const char* kvs_ke
 kvs_status_t internal_kvs::kvs_get_value_by_name_key(const char* kvs_name,
                                                      const char* kvs_key,
                                                      char* kvs_val) {
-    kvs_request_t request;
-    request.mode = AM_GET_VAL;
-    size_t is_exist = 0;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-    kvs_str_copy(request.key, kvs_key, MAX_KVS_KEY_LENGTH);
+    kvs_msg_t answer;
     memset(kvs_val, 0, MAX_KVS_VAL_LENGTH);
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_GET_VAL, { kvs_name, kvs_key }), &answer),
+                     "client: get_value");
+    if (!answer.fields.empty()) {
+        kvs_str_copy(kvs_val, answer.fields[0].c_str(), MAX_KVS_VAL_LENGTH);
+    }
 
-    DO_RW_OP(
-        write, client_op_sock, &request, sizeof(request), client_memory_mutex, "client: get_value");
-
-    DO_RW_OP(read,
-             client_op_sock,
-             &is_exist,
-             sizeof(is_exist),
-             client_memory_mutex,
-             "client: get_value is_exist");
+    return KVS_STATUS_SUCCESS;
+}
 
-    if (is_exist) {
-        DO_RW_OP(read,
-                 client_op_sock,
-                 &request,
-                 sizeof(request),
-                 client_memory_mutex,
-                 "client: get_value read data");
-        kvs_str_copy(kvs_val, request.val, MAX_KVS_VAL_LENGTH);
+kvs_status_t internal_kvs::kvs_get_values_by_name_keys(const char* kvs_name,
+                                                       const std::vector<std::string>& kvs_keys,
+                                                       std::vector<std::string>& kvs_vals) {
+    kvs_msg_t request(AM_GET_BATCH, { kvs_name });
+    request.fields.insert(request.fields.end(), kvs_keys.begin(), kvs_keys.end());
+
+    kvs_msg_t answer;
+    KVS_CHECK_STATUS(kvs_request(request, &answer), "client: get_values");
+    if (answer.fields.size() != kvs_keys.size()) {
+        LOG_ERROR("client: unexpected values count ",
+                  answer.fields.size(),
+                  ", expected ",
+                  kvs_keys.size());
+        return KVS_STATUS_FAILURE;
     }
+    kvs_vals = std::move(answer.fields);
 
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t internal_kvs::kvs_get_count_names(const char* kvs_name, int& count_names) {
     count_names = 0;
-    kvs_request_t request;
-    request.mode = AM_GET_COUNT;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-
-    DO_RW_OP(
-        write, client_op_sock, &request, sizeof(request), client_memory_mutex, "client: get_count");
-
-    DO_RW_OP(read,
-             client_op_sock,
-             &count_names,
-             sizeof(count_names),
-             client_memory_mutex,
-             "client: get_count read data");
+    kvs_msg_t answer;
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_GET_COUNT, { kvs_name }), &answer),
+                     "client: get_count");
+    if (answer.fields.size() != 1) {
+        LOG_ERROR("client: unexpected get_count answer");
+        return KVS_STATUS_FAILURE;
+    }
+    KVS_CHECK_STATUS(safe_strtol(answer.fields[0].c_str(), count_names),
+                     "failed to convert count_names");
 
     return KVS_STATUS_SUCCESS;
 }
@@ -209,36 +181,15 @@ kvs_status_t internal_kvs::kvs_get_keys_values_by_name(const char* kvs_name,
                                                        size_t& count) {
     count = 0;
     size_t i;
-    kvs_request_t request;
-    std::vector<kvs_request_t> answers;
-
-    request.mode = AM_GET_KEYS_VALUES;
-    kvs_str_copy(request.name, kvs_name, MAX_KVS_NAME_LENGTH);
-
-    DO_RW_OP(write,
-             client_op_sock,
-             &request,
-             sizeof(kvs_request_t),
-             client_memory_mutex,
-             "client: get_keys_values");
-
-    DO_RW_OP(read,
-             client_op_sock,
-             &count,
-             sizeof(size_t),
-             client_memory_mutex,
-             "client: get_keys_values read size");
+    kvs_msg_t answer;
 
+    KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_GET_KEYS_VALUES, { kvs_name }), &answer),
+                     "client: get_keys_values");
+
+    count = answer.fields.size() / 2;
     if (count == 0)
         return KVS_STATUS_SUCCESS;
 
-    answers.resize(count);
-    DO_RW_OP(read,
-             client_op_sock,
-             answers.data(),
-             sizeof(kvs_request_t) * count,
-             client_memory_mutex,
-             "client: get_keys_values read data");
     if (kvs_keys != nullptr) {
         if (*kvs_keys != nullptr)
             free(*kvs_keys);
@@ -254,7 +205,7 @@ kvs_status_t internal_kvs::kvs_get_keys_values_by_name(const char* kvs_name,
                 LOG_ERROR("Memory allocation failed");
                 return KVS_STATUS_FAILURE;
             }
-            kvs_str_copy((*kvs_keys)[i], answers[i].key, MAX_KVS_KEY_LENGTH);
+            kvs_str_copy((*kvs_keys)[i], answer.fields[2 * i].c_str(), MAX_KVS_KEY_LENGTH);
         }
     }
     if (kvs_values != nullptr) {
@@ -272,7 +223,7 @@ kvs_status_t internal_kvs::kvs_get_keys_values_by_name(const char* kvs_name,
                 LOG_ERROR("Memory allocation failed");
                 return KVS_STATUS_FAILURE;
             }
-            kvs_str_copy((*kvs_values)[i], answers[i].val, MAX_KVS_VAL_LENGTH);
+            kvs_str_copy((*kvs_values)[i], answer.fields[2 * i + 1].c_str(), MAX_KVS_VAL_LENGTH);
         }
     }
 
@@ -285,22 +236,14 @@ kvs_status_t internal_kvs::kvs_get_replica_size(size_t& replica_size) {
         return request_k8s_get_replica_size(replica_size);
     }
     else {
-        kvs_request_t request;
-        request.mode = AM_GET_REPLICA;
-
-        DO_RW_OP(write,
-                 client_op_sock,
-                 &request,
-                 sizeof(kvs_request_t),
-                 client_memory_mutex,
-                 "client: get_replica");
-
-        DO_RW_OP(read,
-                 client_op_sock,
-                 &replica_size,
-                 sizeof(size_t),
-                 client_memory_mutex,
-                 "client: get_replica read size");
+        kvs_msg_t answer;
+        KVS_CHECK_STATUS(kvs_request(kvs_msg_t(AM_GET_REPLICA), &answer), "client: get_replica");
+        if (answer.fields.size() != 1) {
+            LOG_ERROR("client: unexpected get_replica answer");
+            return KVS_STATUS_FAILURE;
+        }
+        KVS_CHECK_STATUS(safe_strtol(answer.fields[0].c_str(), replica_size),
+                         "failed to convert replica_size");
     }
     return KVS_STATUS_SUCCESS;
 }
@@ -703,6 +646,10 @@ kvs_status_t internal_kvs::kvs_init(const char* main_addr) {
         return KVS_STATUS_FAILURE;
     }
 
+    /* requests are small and latency bound */
+    int nodelay = 1;
+    setsockopt(client_op_sock, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
     if (strstr(main_host_ip, local_host_ip) && local_port == main_port) {
         is_master = 1;
     }
@@ -712,26 +659,15 @@ kvs_status_t internal_kvs::kvs_init(const char* main_addr) {
 }
 
 kvs_status_t internal_kvs::kvs_finalize(void) {
-    kvs_request_t request;
+    kvs_msg_t answer;
     close(client_op_sock);
     client_op_sock = 0;
     if (kvs_thread != 0) {
         void* exit_code;
-        bool is_stop;
         int err;
-        request.mode = AM_FINALIZE;
-        DO_RW_OP(write,
-                 client_control_sock,
-                 &request,
-                 sizeof(request),
-                 client_memory_mutex,
-                 "client: finalize start");
-        DO_RW_OP(read,
-                 client_control_sock,
-                 &is_stop,
-                 sizeof(is_stop),
-                 client_memory_mutex,
-                 "client: finalize complete");
+        KVS_CHECK_STATUS(kvs_msg_send(client_control_sock, kvs_msg_t(AM_FINALIZE)),
+                         "client: finalize start");
+        KVS_CHECK_STATUS(kvs_msg_recv(client_control_sock, answer), "client: finalize complete");
 
         err = pthread_join(kvs_thread, &exit_code);
         if (err) {
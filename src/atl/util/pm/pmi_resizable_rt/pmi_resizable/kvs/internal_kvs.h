@@ -20,9 +20,13 @@
 #include <mutex>
 #include <netinet/ip.h>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "ikvs_wrapper.h"
 
+struct kvs_msg;
+
 class isockaddr {
 public:
     virtual in_port_t get_sin_port() = 0;
@@ -44,12 +48,22 @@ public:
                                const char* kvs_key,
                                const char* kvs_val) override;
 
+    /* puts all pairs with single request */
+    kvs_status_t kvs_set_values(const char* kvs_name,
+                                const std::vector<std::string>& kvs_keys,
+                                const std::vector<std::string>& kvs_vals);
+
     kvs_status_t kvs_remove_name_key(const char* kvs_name, const char* kvs_key) override;
 
     kvs_status_t kvs_get_value_by_name_key(const char* kvs_name,
                                            const char* kvs_key,
                                            char* kvs_val) override;
 
+    /* gets values of all keys with single request, value is empty if key is absent */
+    kvs_status_t kvs_get_values_by_name_keys(const char* kvs_name,
+                                             const std::vector<std::string>& kvs_keys,
+                                             std::vector<std::string>& kvs_vals);
+
     kvs_status_t kvs_register(const char* kvs_name, const char* kvs_key, char* kvs_val);
 
     kvs_status_t kvs_set_size(const char* kvs_name, const char* kvs_key, const char* kvs_val);
@@ -85,6 +99,7 @@ public:
     static const char SCOPE_ID_DELIM = '%';
 
 private:
+    kvs_status_t kvs_request(const kvs_msg& request, kvs_msg* answer);
     kvs_status_t init_main_server_by_string(const char* main_addr);
     kvs_status_t init_main_server_by_env();
     kvs_status_t init_main_server_by_k8s();
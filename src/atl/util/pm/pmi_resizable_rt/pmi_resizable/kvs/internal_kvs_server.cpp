@@ -16,32 +16,145 @@
 #include <algorithm>
 #include <arpa/inet.h>
 #include <cerrno>
+#include <fcntl.h>
 #include <list>
 #include <map>
-#include <mutex>
-#include <poll.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <unistd.h>
 #include <memory>
+#include <unordered_map>
 
 #include "common/log/log.hpp"
 #include "internal_kvs_server.hpp"
 
+void kvs_msg::serialize(std::string& buf) const {
+    kvs_msg_header_t header{};
+    header.mode = mode;
+    header.field_count = fields.size();
+    for (const auto& field : fields) {
+        header.body_len += sizeof(uint32_t) + field.size();
+    }
+
+    size_t offset = buf.size();
+    buf.resize(offset + sizeof(header) + header.body_len);
+    char* ptr = &buf[offset];
+    memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+    for (const auto& field : fields) {
+        uint32_t field_len = field.size();
+        memcpy(ptr, &field_len, sizeof(field_len));
+        ptr += sizeof(field_len);
+        memcpy(ptr, field.data(), field_len);
+        ptr += field_len;
+    }
+}
+
+kvs_status_t kvs_msg::deserialize(const char* buf, size_t buf_len, size_t& consumed) {
+    consumed = 0;
+    kvs_msg_header_t header;
+    if (buf_len < sizeof(header)) {
+        return KVS_STATUS_SUCCESS;
+    }
+    memcpy(&header, buf, sizeof(header));
+    if (header.body_len > KVS_MAX_MSG_BODY_LENGTH) {
+        LOG_ERROR("too long message body: ", header.body_len);
+        return KVS_STATUS_FAILURE;
+    }
+    if (buf_len < sizeof(header) + header.body_len) {
+        return KVS_STATUS_SUCCESS;
+    }
+
+    const char* ptr = buf + sizeof(header);
+    const char* end = ptr + header.body_len;
+    mode = static_cast<kvs_access_mode_t>(header.mode);
+    fields.resize(header.field_count);
+    for (auto& field : fields) {
+        uint32_t field_len;
+        if (end - ptr < (ptrdiff_t)sizeof(field_len)) {
+            LOG_ERROR("malformed message, mode ", header.mode);
+            return KVS_STATUS_FAILURE;
+        }
+        memcpy(&field_len, ptr, sizeof(field_len));
+        ptr += sizeof(field_len);
+        if (end - ptr < (ptrdiff_t)field_len) {
+            LOG_ERROR("malformed message, mode ", header.mode);
+            return KVS_STATUS_FAILURE;
+        }
+        field.assign(ptr, field_len);
+        ptr += field_len;
+    }
+    consumed = sizeof(header) + header.body_len;
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t kvs_msg_send(int fd, const kvs_msg_t& msg) {
+    std::string buf;
+    msg.serialize(buf);
+    size_t shift = 0;
+    while (shift != buf.size()) {
+        ssize_t res = write(fd, buf.data() + shift, buf.size() - shift);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG_ERROR("write error: ", strerror(errno), ", mode ", msg.mode);
+            return KVS_STATUS_FAILURE;
+        }
+        shift += res;
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+static kvs_status_t kvs_read_full(int fd, char* buf, size_t size) {
+    size_t shift = 0;
+    while (shift != size) {
+        ssize_t res = read(fd, buf + shift, size - shift);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG_ERROR("read error: ", strerror(errno));
+            return KVS_STATUS_FAILURE;
+        }
+        if (res == 0) {
+            LOG_ERROR("connection is closed, size ", size, ", shift ", shift);
+            return KVS_STATUS_FAILURE;
+        }
+        shift += res;
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t kvs_msg_recv(int fd, kvs_msg_t& msg) {
+    kvs_msg_header_t header;
+    KVS_CHECK_STATUS(kvs_read_full(fd, (char*)&header, sizeof(header)), "failed to read header");
+    if (header.body_len > KVS_MAX_MSG_BODY_LENGTH) {
+        LOG_ERROR("too long message body: ", header.body_len);
+        return KVS_STATUS_FAILURE;
+    }
+
+    std::string buf(sizeof(header) + header.body_len, '\0');
+    memcpy(&buf[0], &header, sizeof(header));
+    KVS_CHECK_STATUS(kvs_read_full(fd, &buf[sizeof(header)], header.body_len),
+                     "failed to read body");
+
+    size_t consumed = 0;
+    KVS_CHECK_STATUS(msg.deserialize(buf.data(), buf.size(), consumed), "failed to parse message");
+    return KVS_STATUS_SUCCESS;
+}
+
 class server {
 public:
     server() = default;
     kvs_status_t run(void*);
-    kvs_status_t check_finalize(bool& to_finalize);
-    kvs_status_t make_client_request(int& socket);
-    kvs_status_t try_to_connect_new();
 
 private:
-    struct clients_info {
-        int socket;
-        bool in_barrier;
-        clients_info(int sock, bool barrier) : socket(sock), in_barrier(barrier) {}
+    struct connection {
+        std::string in_buf;
+        std::string out_buf;
+        size_t out_offset = 0;
     };
     struct proc_info {
         std::string rank;
@@ -59,31 +172,52 @@ private:
         std::list<socket_info> sockets;
         std::map<std::string, std::list<proc_info>> processes;
     };
+    /* counting barrier, arrival is O(1), all clients are released when last one arrives */
     struct barrier_info {
         size_t global_size = 0;
         size_t local_size = 0;
-        std::list<std::shared_ptr<clients_info>> clients;
+        size_t arrived_count = 0;
+        std::unordered_map<int, bool> clients; /* socket -> is in barrier */
     };
-    enum fd_indexes { FDI_LISTENER = 0, FDI_CONTROL = 1, FDI_LAST = 2 };
 
-    kvs_request_t request{};
-    size_t count{};
+    kvs_status_t accept_new();
+    kvs_status_t check_finalize(bool& to_finalize);
+    kvs_status_t read_client(int socket);
+    kvs_status_t write_client(int socket);
+    kvs_status_t make_client_request(int socket, kvs_msg_t& request);
+    kvs_status_t reply(int socket, const kvs_msg_t& msg);
+    kvs_status_t update_events(int socket, bool with_out);
+    void close_client(int socket);
+
     size_t client_count = 0;
-    const size_t max_client_queue_size = 300;
-    const size_t client_count_increase = 300;
-    std::map<std::string, barrier_info> barriers;
-    std::map<std::string, comm_info> communicators;
-    int ret = 0;
-    std::mutex server_memory_mutex;
-    std::map<std::string, std::map<std::string, std::string>> requests;
+    const size_t max_events = 256;
+    const size_t read_chunk_size = 64 * 1024;
+    std::unordered_map<std::string, barrier_info> barriers;
+    std::unordered_map<std::string, comm_info> communicators;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> requests;
+    std::unordered_map<int, connection> connections;
+    std::vector<char> read_buf;
     const int free_socket = -1;
-    std::vector<struct pollfd> poll_fds;
+    int epoll_fd = free_socket;
+    int listener_fd = free_socket;
+    int control_fd = free_socket;
 
     sa_family_t address_family{ AF_UNSPEC };
 };
 
-kvs_status_t server::try_to_connect_new() {
-    if (poll_fds[FDI_LISTENER].revents != 0) {
+kvs_status_t server::update_events(int socket, bool with_out) {
+    struct epoll_event event {};
+    event.events = with_out ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.fd = socket;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, socket, &event) < 0) {
+        LOG_ERROR("epoll_ctl(", strerror(errno), ")");
+        return KVS_STATUS_FAILURE;
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t server::accept_new() {
+    while (true) {
         std::shared_ptr<isockaddr> addr;
 
         if (address_family == AF_INET) {
@@ -93,185 +227,270 @@ kvs_status_t server::try_to_connect_new() {
             addr = std::shared_ptr<isockaddr>(new sockaddr_v6());
         }
 
-        int new_socket;
         socklen_t peer_addr_size = addr->size();
-        if ((new_socket = accept(poll_fds[FDI_LISTENER].fd,
-                                 addr->get_sock_addr_ptr(),
-                                 (socklen_t*)&peer_addr_size)) < 0) {
-            LOG_ERROR("server_listen_sock accept, %s", strerror(errno));
+        int new_socket =
+            accept4(listener_fd, addr->get_sock_addr_ptr(), &peer_addr_size, SOCK_NONBLOCK);
+        if (new_socket < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return KVS_STATUS_SUCCESS;
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            LOG_ERROR("server_listen_sock accept, ", strerror(errno));
             return KVS_STATUS_FAILURE;
         }
-        for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-            if (poll_fds[i].fd == free_socket) {
-                poll_fds[i].fd = new_socket;
-                break;
-            }
+
+        int nodelay = 1;
+        setsockopt(new_socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = new_socket;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, new_socket, &event) < 0) {
+            LOG_ERROR("epoll_ctl(", strerror(errno), ")");
+            return KVS_STATUS_FAILURE;
         }
+        connections[new_socket];
         client_count++;
-        if (poll_fds.size() - FDI_LAST == client_count) {
-            size_t old_size = poll_fds.size();
-            poll_fds.resize(old_size + client_count_increase);
-            for (size_t i = old_size; i < poll_fds.size(); i++) {
-                poll_fds[i].fd = free_socket;
-                poll_fds[i].events = POLLIN;
-            }
-        }
     }
-    return KVS_STATUS_SUCCESS;
 }
 
-kvs_status_t server::make_client_request(int& socket) {
-    DO_RW_OP_1(
-        read, socket, &request, sizeof(kvs_request_t), ret, "server: get command from client");
-    if (ret == 0) {
-        close(socket);
-        socket = free_socket;
-        client_count--;
+void server::close_client(int socket) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, socket, nullptr);
+    close(socket);
+    connections.erase(socket);
+    client_count--;
+}
+
+kvs_status_t server::reply(int socket, const kvs_msg_t& msg) {
+    auto it = connections.find(socket);
+    if (it == connections.end()) {
+        LOG_DEBUG("skip reply to closed socket ", socket);
         return KVS_STATUS_SUCCESS;
     }
 
+    auto& conn = it->second;
+    bool was_empty = (conn.out_offset == conn.out_buf.size());
+    msg.serialize(conn.out_buf);
+    if (was_empty) {
+        /* try to send right away, leftover is sent on EPOLLOUT */
+        return write_client(socket);
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t server::write_client(int socket) {
+    auto& conn = connections[socket];
+    while (conn.out_offset < conn.out_buf.size()) {
+        ssize_t res = write(
+            socket, conn.out_buf.data() + conn.out_offset, conn.out_buf.size() - conn.out_offset);
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return update_events(socket, true);
+            LOG_ERROR("server: write error: ", strerror(errno));
+            return KVS_STATUS_FAILURE;
+        }
+        conn.out_offset += res;
+    }
+
+    bool had_pending = !conn.out_buf.empty();
+    conn.out_buf.clear();
+    conn.out_offset = 0;
+    return had_pending ? update_events(socket, false) : KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t server::read_client(int socket) {
+    bool is_closed = false;
+    while (true) {
+        ssize_t res = read(socket, read_buf.data(), read_buf.size());
+        if (res < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            LOG_ERROR("server: read error: ", strerror(errno));
+            return KVS_STATUS_FAILURE;
+        }
+        if (res == 0) {
+            is_closed = true;
+            break;
+        }
+        connections[socket].in_buf.append(read_buf.data(), res);
+    }
+
+    /* process all complete messages, requests may add replies to other connections */
+    size_t offset = 0;
+    while (true) {
+        auto& in_buf = connections[socket].in_buf;
+        size_t consumed = 0;
+        kvs_msg_t request;
+        KVS_CHECK_STATUS(
+            request.deserialize(in_buf.data() + offset, in_buf.size() - offset, consumed),
+            "server: failed to parse request");
+        if (consumed == 0)
+            break;
+        offset += consumed;
+        KVS_CHECK_STATUS(make_client_request(socket, request), "failed to make request");
+    }
+    connections[socket].in_buf.erase(0, offset);
+
+    if (is_closed) {
+        close_client(socket);
+    }
+    return KVS_STATUS_SUCCESS;
+}
+
+kvs_status_t server::make_client_request(int socket, kvs_msg_t& request) {
+    auto& fields = request.fields;
+    auto check_field_count = [&](size_t count) {
+        if (fields.size() < count) {
+            LOG_ERROR("server: too few fields ", fields.size(), " for mode ", request.mode);
+            return false;
+        }
+        return true;
+    };
+
     switch (request.mode) {
         case AM_PUT: {
-            auto& req = requests[request.name];
-            req[request.key] = request.val;
+            if (!check_field_count(3))
+                return KVS_STATUS_FAILURE;
+            requests[fields[0]][fields[1]] = std::move(fields[2]);
+            break;
+        }
+        case AM_PUT_BATCH: {
+            if (!check_field_count(1) || fields.size() % 2 != 1) {
+                LOG_ERROR("server: unexpected field count for batch put ", fields.size());
+                return KVS_STATUS_FAILURE;
+            }
+            auto& req = requests[fields[0]];
+            for (size_t idx = 1; idx < fields.size(); idx += 2) {
+                req[fields[idx]] = std::move(fields[idx + 1]);
+            }
             break;
         }
         case AM_REMOVE: {
-            requests[request.name].erase(request.key);
+            if (!check_field_count(2))
+                return KVS_STATUS_FAILURE;
+            auto it_name = requests.find(fields[0]);
+            if (it_name != requests.end()) {
+                it_name->second.erase(fields[1]);
+                if (it_name->second.empty()) {
+                    requests.erase(it_name);
+                }
+            }
             break;
         }
         case AM_GET_VAL: {
-            count = 0;
-            auto it_name = requests.find(request.name);
+            if (!check_field_count(2))
+                return KVS_STATUS_FAILURE;
+            kvs_msg_t answer(AM_GET_VAL);
+            auto it_name = requests.find(fields[0]);
             if (it_name != requests.end()) {
-                auto it_key = it_name->second.find(request.key);
+                auto it_key = it_name->second.find(fields[1]);
                 if (it_key != it_name->second.end()) {
-                    count = 1;
-                    DO_RW_OP(write,
-                             socket,
-                             &count,
-                             sizeof(size_t),
-                             server_memory_mutex,
-                             "server: get_value write size");
-
-                    kvs_str_copy(request.val, it_key->second.c_str(), MAX_KVS_VAL_LENGTH);
-
-                    DO_RW_OP(write,
-                             socket,
-                             &request,
-                             sizeof(kvs_request_t),
-                             server_memory_mutex,
-                             "server: get_value write data");
-                    break;
+                    answer.fields.push_back(it_key->second);
+                }
+            }
+            KVS_CHECK_STATUS(reply(socket, answer), "server: get_value reply");
+            break;
+        }
+        case AM_GET_BATCH: {
+            if (!check_field_count(1))
+                return KVS_STATUS_FAILURE;
+            kvs_msg_t answer(AM_GET_BATCH);
+            answer.fields.resize(fields.size() - 1);
+            auto it_name = requests.find(fields[0]);
+            if (it_name != requests.end()) {
+                for (size_t idx = 1; idx < fields.size(); idx++) {
+                    auto it_key = it_name->second.find(fields[idx]);
+                    if (it_key != it_name->second.end()) {
+                        answer.fields[idx - 1] = it_key->second;
+                    }
                 }
             }
-            DO_RW_OP(write,
-                     socket,
-                     &count,
-                     sizeof(size_t),
-                     server_memory_mutex,
-                     "server: get_value write size");
+            KVS_CHECK_STATUS(reply(socket, answer), "server: get_batch reply");
             break;
         }
         case AM_GET_COUNT: {
-            count = 0;
-            auto it = requests.find(request.name);
+            if (!check_field_count(1))
+                return KVS_STATUS_FAILURE;
+            size_t count = 0;
+            auto it = requests.find(fields[0]);
             if (it != requests.end()) {
                 count = it->second.size();
             }
-            DO_RW_OP(
-                write, socket, &count, sizeof(size_t), server_memory_mutex, "server: get_count");
+            KVS_CHECK_STATUS(reply(socket, kvs_msg_t(AM_GET_COUNT, { std::to_string(count) })),
+                             "server: get_count reply");
             break;
         }
         case AM_GET_REPLICA: {
             char* replica_size_str = getenv(CCL_WORLD_SIZE_ENV);
-            count = client_count;
+            size_t count = client_count;
             if (replica_size_str != nullptr) {
                 KVS_CHECK_STATUS(safe_strtol(replica_size_str, count), "failed to convert count");
             }
-            DO_RW_OP(
-                write, socket, &count, sizeof(size_t), server_memory_mutex, "server: get_replica");
+            KVS_CHECK_STATUS(reply(socket, kvs_msg_t(AM_GET_REPLICA, { std::to_string(count) })),
+                             "server: get_replica reply");
             break;
         }
         case AM_GET_KEYS_VALUES: {
-            size_t j = 0;
-            std::vector<kvs_request_t> answers;
-            count = 0;
-            auto it_name = requests.find(request.name);
+            if (!check_field_count(1))
+                return KVS_STATUS_FAILURE;
+            kvs_msg_t answer(AM_GET_KEYS_VALUES);
+            auto it_name = requests.find(fields[0]);
             if (it_name != requests.end()) {
-                count = it_name->second.size();
-            }
-
-            DO_RW_OP(write,
-                     socket,
-                     &count,
-                     sizeof(size_t),
-                     server_memory_mutex,
-                     "server: get_keys_values write size");
-            if (count == 0)
-                break;
-
-            answers.resize(count);
-
-            for (auto it_keys : it_name->second) {
-                kvs_str_copy_known_sizes(answers[j].name, request.name, MAX_KVS_NAME_LENGTH);
-                kvs_str_copy(answers[j].key, it_keys.first.c_str(), MAX_KVS_KEY_LENGTH);
-                kvs_str_copy(answers[j].val, it_keys.second.c_str(), MAX_KVS_VAL_LENGTH);
-                j++;
+                /* keep key order stable for callers which rely on it */
+                typedef const std::pair<const std::string, std::string>* entry_ptr_t;
+                std::vector<entry_ptr_t> entries;
+                entries.reserve(it_name->second.size());
+                for (const auto& entry : it_name->second) {
+                    entries.push_back(&entry);
+                }
+                std::sort(entries.begin(), entries.end(), [](entry_ptr_t a, entry_ptr_t b) {
+                    return a->first < b->first;
+                });
+                answer.fields.reserve(entries.size() * 2);
+                for (auto entry : entries) {
+                    answer.fields.push_back(entry->first);
+                    answer.fields.push_back(entry->second);
+                }
             }
-
-            DO_RW_OP(write,
-                     socket,
-                     answers.data(),
-                     sizeof(kvs_request_t) * count,
-                     server_memory_mutex,
-                     "server: get_keys_values write data");
-
+            KVS_CHECK_STATUS(reply(socket, answer), "server: get_keys_values reply");
             break;
         }
         case AM_BARRIER: {
-            auto& barrier_list = barriers[request.name];
-            auto& clients = barrier_list.clients;
-            auto client_it = std::find_if(std::begin(clients),
-                                          std::end(clients),
-                                          [&](std::shared_ptr<server::clients_info> v) {
-                                              return v->socket == socket;
-                                          });
-            if (client_it == clients.end()) {
+            if (!check_field_count(1))
+                return KVS_STATUS_FAILURE;
+            auto& barrier = barriers[fields[0]];
+            auto client_it = barrier.clients.find(socket);
+            if (client_it == barrier.clients.end()) {
                 // TODO: Look deeper to fix this error
                 LOG_ERROR("Server error: Unregister Barrier request!");
                 return KVS_STATUS_FAILURE;
             }
-            auto client_inf = client_it->get();
-            client_inf->in_barrier = true;
-
-            if (barrier_list.global_size == barrier_list.local_size) {
-                bool is_barrier_stop = true;
-                for (const auto& client : clients) {
-                    if (!client->in_barrier) {
-                        is_barrier_stop = false;
-                        break;
-                    }
-                }
-                if (is_barrier_stop) {
-                    int is_done = 1;
-                    for (const auto& client : clients) {
-                        client->in_barrier = false;
-                        DO_RW_OP(write,
-                                 client->socket,
-                                 &is_done,
-                                 sizeof(is_done),
-                                 server_memory_mutex,
-                                 "server: barrier");
-                    }
+            if (!client_it->second) {
+                client_it->second = true;
+                barrier.arrived_count++;
+            }
+
+            if (barrier.global_size == barrier.local_size &&
+                barrier.arrived_count == barrier.clients.size()) {
+                barrier.arrived_count = 0;
+                kvs_msg_t answer(AM_BARRIER);
+                for (auto& client : barrier.clients) {
+                    client.second = false;
+                    KVS_CHECK_STATUS(reply(client.first, answer), "server: barrier reply");
                 }
             }
             break;
         }
         case AM_BARRIER_REGISTER: {
-            char* glob_size = request.val;
+            if (!check_field_count(3))
+                return KVS_STATUS_FAILURE;
+            char* glob_size = &fields[2][0];
             char* local_size = strstr(glob_size, "_");
-            auto& barrier = barriers[request.name];
+            auto& barrier = barriers[fields[0]];
             if (local_size == nullptr) {
                 barrier.local_size++;
             }
@@ -287,33 +506,39 @@ kvs_status_t server::make_client_request(int& socket) {
             KVS_CHECK_STATUS(safe_strtol(glob_size, barrier.global_size),
                              "failed to convert global_size");
 
-            barrier.clients.push_back(
-                std::shared_ptr<clients_info>(new clients_info(socket, false)));
+            barrier.clients.emplace(socket, false);
             break;
         }
         case AM_SET_SIZE: {
-            char* glob_size = request.val;
-            KVS_CHECK_STATUS(safe_strtol(glob_size, communicators[request.key].global_size),
+            if (!check_field_count(3))
+                return KVS_STATUS_FAILURE;
+            KVS_CHECK_STATUS(safe_strtol(fields[2].c_str(), communicators[fields[1]].global_size),
                              "failed to convert global_size");
 
             break;
         }
         case AM_INTERNAL_REGISTER: {
-            auto& communicator = communicators[request.key];
-            char* rank_count_str = request.val;
+            if (!check_field_count(3))
+                return KVS_STATUS_FAILURE;
+            auto& communicator = communicators[fields[1]];
+            char* rank_count_str = &fields[2][0];
             char* rank = strstr(rank_count_str, "_");
+            char* proc_id = rank ? strstr(rank + 1, "_") : nullptr;
+            char* thread_id = proc_id ? strstr(proc_id + 1, "_") : nullptr;
+            if (!thread_id) {
+                LOG_ERROR("server: unexpected register value ", rank_count_str);
+                return KVS_STATUS_FAILURE;
+            }
             rank[0] = '\0';
             rank++;
-            char* proc_id = strstr(rank, "_");
             proc_id[0] = '\0';
             proc_id++;
-            char* thread_id = strstr(proc_id, "_");
             thread_id[0] = '\0';
             thread_id++;
             size_t rank_count;
             KVS_CHECK_STATUS(safe_strtol(rank_count_str, rank_count),
                              "failed to convert rank_count");
-            communicators[request.key].local_size += rank_count;
+            communicator.local_size += rank_count;
             socket_info sock_info{ socket, proc_id, { rank, rank_count, thread_id } };
             communicator.processes[proc_id].push_back(sock_info.process_info);
             communicator.sockets.push_back(sock_info);
@@ -328,7 +553,7 @@ kvs_status_t server::make_client_request(int& socket) {
                     std::string thread_num;
                     int i = 0;
                     size_t proc_rank_count = 0;
-                    auto process_info = communicator.processes[it.proc_id];
+                    const auto& process_info = communicator.processes[it.proc_id];
                     std::string threads_count = std::to_string(process_info.size());
                     for (auto& proc_info_it : process_info) {
                         if (it.process_info.rank == proc_info_it.rank) {
@@ -340,30 +565,19 @@ kvs_status_t server::make_client_request(int& socket) {
                     for (auto& proc_info_it : process_info) {
                         proc_rank_count += proc_info_it.rank_count;
                     }
-                    memset(request.val, 0, MAX_KVS_VAL_LENGTH);
                     /*return string: %PROC_COUNT%_%RANK_NUM%_%PROCESS_RANK_COUNT%_%THREADS_COUNT%_%THREAD_NUM% */
-                    snprintf(request.val,
-                             MAX_KVS_VAL_LENGTH,
-                             "%s_%s_%s_%s_%s",
-                             proc_count_str.c_str(),
-                             it.process_info.rank.c_str(),
-                             std::to_string(proc_rank_count).c_str(),
-                             threads_count.c_str(),
-                             thread_num.c_str());
-                    DO_RW_OP(write,
-                             it.socket,
-                             &request,
-                             sizeof(kvs_request_t),
-                             server_memory_mutex,
-                             "server: register write data");
+                    std::string answer_val = proc_count_str + "_" + it.process_info.rank + "_" +
+                                             std::to_string(proc_rank_count) + "_" +
+                                             threads_count + "_" + thread_num;
+                    KVS_CHECK_STATUS(
+                        reply(it.socket, kvs_msg_t(AM_INTERNAL_REGISTER, { answer_val })),
+                        "server: register reply");
                 }
             }
             break;
         }
         default: {
-            if (request.name[0] == '\0')
-                return KVS_STATUS_SUCCESS;
-            LOG_ERROR("unknown request mode - %d.\n", request.mode);
+            LOG_ERROR("unknown request mode - ", request.mode);
             return KVS_STATUS_FAILURE;
         }
     }
@@ -372,101 +586,111 @@ kvs_status_t server::make_client_request(int& socket) {
 
 kvs_status_t server::check_finalize(bool& to_finalize) {
     to_finalize = false;
-    if (poll_fds[FDI_CONTROL].revents != 0) {
-        DO_RW_OP_1(read,
-                   poll_fds[FDI_CONTROL].fd,
-                   &request,
-                   sizeof(kvs_request_t),
-                   ret,
-                   "server: get control msg from client");
-        if (ret == 0) {
-            close(poll_fds[FDI_CONTROL].fd);
-            poll_fds[FDI_CONTROL].fd = free_socket;
-        }
-        if (request.mode != AM_FINALIZE) {
-            LOG_ERROR("invalid access mode for local socket\n");
-            return KVS_STATUS_FAILURE;
-        }
-        to_finalize = true;
+    kvs_msg_t request;
+    KVS_CHECK_STATUS(kvs_msg_recv(control_fd, request), "server: get control msg from client");
+    if (request.mode != AM_FINALIZE) {
+        LOG_ERROR("invalid access mode for local socket\n");
+        return KVS_STATUS_FAILURE;
     }
+    /* no more control messages are expected */
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, control_fd, nullptr);
+    to_finalize = true;
     return KVS_STATUS_SUCCESS;
 }
 
 kvs_status_t server::run(void* args) {
     bool should_stop = false;
     int so_reuse = 1;
-    poll_fds.resize(client_count_increase);
-    for (auto& it : poll_fds) {
-        it.fd = free_socket;
-        it.events = POLLIN;
-    }
-    poll_fds[FDI_LISTENER].fd = ((server_args_t*)args)->sock_listener;
+    listener_fd = ((server_args_t*)args)->sock_listener;
     address_family = ((server_args_t*)args)->args->sin_family();
 
 #ifdef SO_REUSEPORT
-    setsockopt(poll_fds[FDI_LISTENER].fd, SOL_SOCKET, SO_REUSEPORT, &so_reuse, sizeof(so_reuse));
+    setsockopt(listener_fd, SOL_SOCKET, SO_REUSEPORT, &so_reuse, sizeof(so_reuse));
 #else
-    setsockopt(poll_fds[FDI_LISTENER].fd, SOL_SOCKET, SO_REUSEADDR, &so_reuse, sizeof(so_reuse));
+    setsockopt(listener_fd, SOL_SOCKET, SO_REUSEADDR, &so_reuse, sizeof(so_reuse));
 #endif
 
-    if (listen(poll_fds[FDI_LISTENER].fd, max_client_queue_size) < 0) {
-        LOG_ERROR("server_listen_sock listen(%s)", strerror(errno));
+    if (listen(listener_fd, SOMAXCONN) < 0) {
+        LOG_ERROR("server_listen_sock listen(", strerror(errno), ")");
         return KVS_STATUS_FAILURE;
     }
+    fcntl(listener_fd, F_SETFL, fcntl(listener_fd, F_GETFL) | O_NONBLOCK);
 
-    if ((poll_fds[FDI_CONTROL].fd = socket(address_family, SOCK_STREAM, 0)) < 0) {
-        LOG_ERROR("server_control_sock init(%s)", strerror(errno));
+    if ((control_fd = socket(address_family, SOCK_STREAM, 0)) < 0) {
+        LOG_ERROR("server_control_sock init(", strerror(errno), ")");
         return KVS_STATUS_FAILURE;
     }
 
-    while (connect(poll_fds[FDI_CONTROL].fd,
+    while (connect(control_fd,
                    ((server_args_t*)args)->args->get_sock_addr_ptr(),
                    ((server_args_t*)args)->args->size()) < 0) {
     }
+
+    if ((epoll_fd = epoll_create1(0)) < 0) {
+        LOG_ERROR("epoll_create1(", strerror(errno), ")");
+        return KVS_STATUS_FAILURE;
+    }
+
+    for (int fd : { listener_fd, control_fd }) {
+        struct epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            LOG_ERROR("epoll_ctl(", strerror(errno), ")");
+            return KVS_STATUS_FAILURE;
+        }
+    }
+
+    read_buf.resize(read_chunk_size);
+    std::vector<struct epoll_event> events(max_events);
     while (!should_stop || client_count > 0) {
-        if (poll(poll_fds.data(), poll_fds.size(), -1) < 0) {
+        int event_count = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (event_count < 0) {
             if (errno != EINTR) {
-                LOG_ERROR("poll(%s)", strerror(errno));
+                LOG_ERROR("epoll_wait(", strerror(errno), ")");
                 return KVS_STATUS_FAILURE;
             }
-            else {
-                /* restart select */
-                continue;
-            }
+            /* restart wait */
+            continue;
         }
 
-        for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-            if (poll_fds[i].fd != free_socket && poll_fds[i].revents != 0) {
-                KVS_CHECK_STATUS(make_client_request(poll_fds[i].fd), "failed to make request");
+        for (int idx = 0; idx < event_count; idx++) {
+            int fd = events[idx].data.fd;
+            if (fd == listener_fd) {
+                KVS_CHECK_STATUS(accept_new(), "failed to connect new");
+            }
+            else if (fd == control_fd) {
+                if (!should_stop) {
+                    KVS_CHECK_STATUS(check_finalize(should_stop), "failed to check finalize");
+                }
+            }
+            else if (connections.find(fd) != connections.end()) {
+                if (events[idx].events & EPOLLOUT) {
+                    KVS_CHECK_STATUS(write_client(fd), "failed to write reply");
+                }
+                if (events[idx].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    KVS_CHECK_STATUS(read_client(fd), "failed to make request");
+                }
             }
-        }
-        KVS_CHECK_STATUS(try_to_connect_new(), "failed to connect new");
-        if (!should_stop) {
-            KVS_CHECK_STATUS(check_finalize(should_stop), "failed to check finalize");
         }
     }
 
-    if (poll_fds[FDI_CONTROL].fd != free_socket) {
-        DO_RW_OP_1(write,
-                   poll_fds[FDI_CONTROL].fd,
-                   &should_stop,
-                   sizeof(should_stop),
-                   ret,
-                   "server: send control msg to client");
-    }
+    KVS_CHECK_STATUS(kvs_msg_send(control_fd, kvs_msg_t(AM_FINALIZE)),
+                     "server: send control msg to client");
 
-    close(poll_fds[FDI_CONTROL].fd);
-    poll_fds[FDI_CONTROL].fd = free_socket;
+    close(control_fd);
+    control_fd = free_socket;
 
-    for (size_t i = FDI_LAST; i < poll_fds.size(); i++) {
-        if (poll_fds[i].fd != free_socket) {
-            close(poll_fds[i].fd);
-            poll_fds[i].fd = free_socket;
-        }
+    for (auto& conn : connections) {
+        close(conn.first);
     }
+    connections.clear();
+
+    close(epoll_fd);
+    epoll_fd = free_socket;
 
-    close(poll_fds[FDI_LISTENER].fd);
-    poll_fds[FDI_LISTENER].fd = free_socket;
+    close(listener_fd);
+    listener_fd = free_socket;
     return KVS_STATUS_SUCCESS;
 }
 
@@ -14,6 +14,10 @@
  limitations under the License.
 */
 #pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "util/pm/pmi_resizable_rt/pmi_resizable/def.h"
 #include "internal_kvs.h"
 
@@ -29,14 +33,56 @@ typedef enum kvs_access_mode {
     AM_BARRIER_REGISTER = 10,
     AM_INTERNAL_REGISTER = 11,
     AM_SET_SIZE = 12,
+    AM_PUT_BATCH = 13,
+    AM_GET_BATCH = 14,
 } kvs_access_mode_t;
 
-typedef struct kvs_request {
+/*
+   wire format: header followed by field_count fields,
+   each field is uint32_t length and bytes without terminating zero
+
+   request fields:                          reply fields:
+   AM_PUT               name, key, val      -
+   AM_PUT_BATCH         name, (key, val)*   -
+   AM_REMOVE            name, key           -
+   AM_GET_VAL           name, key           val or nothing if key is absent
+   AM_GET_BATCH         name, key*          val* (empty val if key is absent)
+   AM_GET_COUNT         name                count
+   AM_GET_KEYS_VALUES   name                (key, val)* sorted by key
+   AM_GET_REPLICA       -                   count
+   AM_BARRIER_REGISTER  name, key, val      -
+   AM_BARRIER           name, key, val      - (sent when barrier is completed)
+   AM_SET_SIZE          name, key, val      -
+   AM_INTERNAL_REGISTER name, key, val      val (sent when all ranks are registered)
+   AM_FINALIZE          -                   - (control socket only)
+*/
+typedef struct kvs_msg_header {
+    uint32_t mode;
+    uint32_t field_count;
+    uint64_t body_len;
+} kvs_msg_header_t;
+
+#define KVS_MAX_MSG_BODY_LENGTH (256UL * 1024 * 1024)
+
+typedef struct kvs_msg {
     kvs_access_mode_t mode{ AM_PUT };
-    char name[MAX_KVS_NAME_LENGTH]{};
-    char key[MAX_KVS_KEY_LENGTH]{};
-    char val[MAX_KVS_VAL_LENGTH]{};
-} kvs_request_t;
+    std::vector<std::string> fields;
+
+    kvs_msg() = default;
+    kvs_msg(kvs_access_mode_t mode, std::vector<std::string> fields = {})
+            : mode(mode),
+              fields(std::move(fields)) {}
+
+    /* appends serialized message to buf */
+    void serialize(std::string& buf) const;
+
+    /* parses message from buf, consumed is 0 if buf doesn't contain complete message yet */
+    kvs_status_t deserialize(const char* buf, size_t buf_len, size_t& consumed);
+} kvs_msg_t;
+
+/* blocking send/recv of whole message */
+kvs_status_t kvs_msg_send(int fd, const kvs_msg_t& msg);
+kvs_status_t kvs_msg_recv(int fd, kvs_msg_t& msg);
 
 typedef struct server_args {
     int sock_listener;
@@ -231,7 +231,8 @@ atl_status_t pmi_resizable_simple_internal::pmrt_kvs_put(char* kvs_key,
         return ATL_STATUS_FAILURE;
     }
 
-    ATL_CHECK_STATUS(kvs_set_value(KVS_NAME, key_storage, val_storage), "failed to set val");
+    ATL_CHECK_STATUS(kvs_set_value(get_kvs_name(kvs_key).c_str(), key_storage, val_storage),
+                     "failed to set val");
 
     return ATL_STATUS_SUCCESS;
 }
@@ -249,7 +250,8 @@ atl_status_t pmi_resizable_simple_internal::pmrt_kvs_get(char* kvs_key,
         return ATL_STATUS_FAILURE;
     }
 
-    ATL_CHECK_STATUS(kvs_get_value(KVS_NAME, key_storage, val_storage), "failed to get val");
+    ATL_CHECK_STATUS(kvs_get_value(get_kvs_name(kvs_key).c_str(), key_storage, val_storage),
+                     "failed to get val");
 
     ret = decode(val_storage, kvs_val, kvs_val_len);
     if (ret) {
@@ -260,6 +262,43 @@ atl_status_t pmi_resizable_simple_internal::pmrt_kvs_get(char* kvs_key,
     return ATL_STATUS_SUCCESS;
 }
 
+atl_status_t pmi_resizable_simple_internal::pmrt_kvs_get_bulk(char* kvs_key,
+                                                              const std::vector<int>& proc_idxs,
+                                                              void* kvs_vals,
+                                                              size_t kvs_val_len) {
+    std::string result_kvs_name = get_kvs_name(kvs_key) + std::to_string(local_id);
+    std::vector<std::string> keys(proc_idxs.size());
+    std::vector<std::string> values;
+    char key_storage[max_keylen];
+
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        snprintf(key_storage, max_keylen - 1, RESIZABLE_PMI_RT_KEY_FORMAT, kvs_key, proc_idxs[idx]);
+        keys[idx] = key_storage;
+    }
+
+    KVS_2_ATL_CHECK_STATUS(k->kvs_get_values_by_name_keys(result_kvs_name.c_str(), keys, values),
+                           "failed to get values");
+
+    for (size_t idx = 0; idx < proc_idxs.size(); idx++) {
+        char* kvs_val = static_cast<char*>(kvs_vals) + idx * kvs_val_len;
+        if (values[idx].empty()) {
+            /* value is not published yet, wait for it */
+            ATL_CHECK_STATUS(pmrt_kvs_get(kvs_key, proc_idxs[idx], kvs_val, kvs_val_len),
+                             "failed to get value");
+        }
+        else if (decode(values[idx].c_str(), kvs_val, kvs_val_len)) {
+            LOG_ERROR("decode failed");
+            return ATL_STATUS_FAILURE;
+        }
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+std::string pmi_resizable_simple_internal::get_kvs_name(const char* kvs_key) {
+    return std::string(KVS_NAME) + "-" + kvs_key;
+}
+
 int pmi_resizable_simple_internal::get_size() {
     return proc_count;
 }
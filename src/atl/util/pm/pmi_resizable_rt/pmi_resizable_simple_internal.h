@@ -71,6 +71,11 @@ public:
                               void* kvs_val,
                               size_t kvs_val_len) override;
 
+    atl_status_t pmrt_kvs_get_bulk(char* kvs_key,
+                                   const std::vector<int>& proc_idxs,
+                                   void* kvs_vals,
+                                   size_t kvs_val_len) override;
+
     int get_size() override;
 
     int get_rank() override;
@@ -94,6 +99,7 @@ private:
 
     int kvs_set_value(const char* kvs_name, const char* key, const char* value);
     atl_status_t kvs_get_value(const char* kvs_name, const char* key, char* value);
+    std::string get_kvs_name(const char* kvs_key);
 
     atl_status_t pmrt_barrier_full();
     atl_status_t barrier_full_reg();
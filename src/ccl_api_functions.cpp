@@ -25,6 +25,7 @@
 
 #include "ccl_api_functions_generators.hpp"
 #include "common/global/global.hpp"
+#include "common/metrics/metrics.hpp"
 
 namespace ccl {
 
@@ -1103,6 +1104,29 @@ ccl::event sparse_allreduce(const IndexBufferType* send_ind_buf,
 //                                         disp(default_stream), attr, deps);
 // }
 
+/* metrics */
+static ccl::metrics_collector* get_metrics_collector() {
+    detail::environment::instance();
+    auto& collector = ccl::global_data::get().metrics_collector;
+    CCL_THROW_IF_NOT(collector, "metrics are disabled, set ", CCL_METRICS, "=1 to enable them");
+    return collector.get();
+}
+
+metrics get_metrics() {
+    return get_metrics_collector()->get();
+}
+
+metrics get_metrics(const communicator& comm) {
+    ccl::impl_dispatch disp;
+    auto comm_impl = dynamic_cast<const ccl_comm*>(disp(comm).get());
+    CCL_THROW_IF_NOT(comm_impl, "metrics are not supported for this communicator");
+    return get_metrics_collector()->get(comm_impl);
+}
+
+void reset_metrics() {
+    get_metrics_collector()->reset();
+}
+
 } // namespace preview
 
 namespace v1 {
@@ -44,9 +44,11 @@ enum ccl_coll_allreduce_algo {
     ccl_coll_allreduce_nreduce,
     ccl_coll_allreduce_ring,
     ccl_coll_allreduce_ring_rma,
+    ccl_coll_allreduce_ring_pipelined,
     ccl_coll_allreduce_double_tree,
     ccl_coll_allreduce_recursive_doubling,
     ccl_coll_allreduce_2d,
+    ccl_coll_allreduce_hierarchical,
     ccl_coll_allreduce_topo
 };
 
@@ -108,7 +110,8 @@ enum ccl_coll_sparse_allreduce_algo {
 
     ccl_coll_sparse_allreduce_ring,
     ccl_coll_sparse_allreduce_mask,
-    ccl_coll_sparse_allreduce_3_allgatherv
+    ccl_coll_sparse_allreduce_3_allgatherv,
+    ccl_coll_sparse_allreduce_sharded
 };
 
 union ccl_coll_algo {
@@ -94,6 +94,14 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
                                           ccl::reduction reduction,
                                           ccl_comm* comm);
 
+ccl::status ccl_coll_build_ring_pipelined_allreduce(ccl_sched* sched,
+                                                    ccl_buffer send_buf,
+                                                    ccl_buffer recv_buf,
+                                                    size_t count,
+                                                    const ccl_datatype& dtype,
+                                                    ccl::reduction reduction,
+                                                    ccl_comm* comm);
+
 ccl::status ccl_coll_build_ring_rma_allreduce(ccl_sched* sched,
                                               ccl_buffer send_buf,
                                               ccl_buffer recv_buf,
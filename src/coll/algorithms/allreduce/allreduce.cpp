@@ -447,15 +447,6 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
             reduce_buf = seg_recv_buf + elem_offsets[comm_rank];
         }
 
-        if (!is_inplace || use_buffering) {
-            entry_factory::create<copy_entry>(sched,
-                                              seg_send_buf + elem_offsets[comm_rank],
-                                              reduce_buf,
-                                              elem_counts[comm_rank],
-                                              dtype);
-            sched->add_barrier();
-        }
-
         // reduce-scatter
         for (int idx = 1; idx < comm_size; idx++) {
             int dst = (comm_rank - idx + comm_size) % comm_size;
@@ -465,20 +456,26 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
                 sched, seg_send_buf + elem_offsets[dst], elem_counts[dst], dtype, dst, comm);
         }
 
+        std::vector<int> srcs;
+        std::vector<ccl_buffer> src_tmp_bufs;
         for (int idx = 1; idx < comm_size; idx++) {
             int src = (comm_rank + idx) % comm_size;
-
-            // recv part of buffer from other rank and perform reduce
-            entry_factory::create<recv_reduce_entry>(sched,
-                                                     reduce_buf,
-                                                     elem_count,
-                                                     dtype,
-                                                     op,
-                                                     src,
-                                                     comm,
-                                                     seg_tmp_buf + elem_count * src * dtype_size);
+            srcs.push_back(src);
+            src_tmp_bufs.push_back(seg_tmp_buf + elem_count * src * dtype_size);
         }
 
+        // recv parts of buffer from other ranks and reduce them with own part,
+        // parts which arrived together are reduced in single pass over reduce_buf
+        entry_factory::create<recv_reduce_multi_entry>(sched,
+                                                       seg_send_buf + elem_offsets[comm_rank],
+                                                       reduce_buf,
+                                                       elem_count,
+                                                       dtype,
+                                                       op,
+                                                       srcs,
+                                                       src_tmp_bufs,
+                                                       comm);
+
         sched->add_barrier();
 
         // allgatherv
@@ -564,6 +561,100 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
     return status;
 }
 
+static void ccl_allreduce_ring_pipelined_add_allgather(ccl_sched* sched,
+                                                       ccl_buffer recv_buf,
+                                                       size_t count,
+                                                       const ccl_datatype& dtype,
+                                                       ccl_comm* comm) {
+    int comm_size = comm->size();
+    size_t main_block_count = count / comm_size;
+    size_t last_block_count = main_block_count + count % comm_size;
+    std::vector<size_t> recv_counts(comm_size, main_block_count);
+    recv_counts[comm_size - 1] = last_block_count;
+
+    ccl_coll_build_ring_allgatherv(
+        sched, recv_buf, recv_counts[comm->rank()], recv_buf, recv_counts.data(), dtype, comm);
+}
+
+ccl::status ccl_coll_build_ring_pipelined_allreduce(ccl_sched* sched,
+                                                    ccl_buffer send_buf,
+                                                    ccl_buffer recv_buf,
+                                                    size_t count,
+                                                    const ccl_datatype& dtype,
+                                                    ccl::reduction op,
+                                                    ccl_comm* comm) {
+    CCL_THROW_IF_NOT(sched && send_buf && recv_buf,
+                     "incorrect values, sched ",
+                     sched,
+                     ", send ",
+                     send_buf,
+                     " recv ",
+                     recv_buf);
+
+    ccl::status status = ccl::status::success;
+
+    int comm_size = comm->size();
+    size_t dtype_size = dtype.size();
+
+    size_t segment_size = ccl::global_data::env().allreduce_ring_pipelined_segment_size;
+    CCL_THROW_IF_NOT(segment_size > 0, "unexpected segment size ", segment_size);
+
+    /* each segment should have at least one element per rank */
+    size_t seg_count = (count * dtype_size + segment_size - 1) / segment_size;
+    seg_count = std::min(seg_count, count / comm_size);
+    seg_count = std::max(seg_count, 1UL);
+
+    LOG_DEBUG("build ring_pipelined allreduce ",
+              (send_buf == recv_buf) ? "in-place" : "out-of-place",
+              ", seg_count ",
+              seg_count);
+
+    if (comm_size == 1 || seg_count == 1) {
+        return ccl_coll_build_ring_allreduce(sched, send_buf, recv_buf, count, dtype, op, comm);
+    }
+
+    size_t main_seg_size = count / seg_count;
+    size_t last_seg_size = main_seg_size + count % seg_count;
+
+    /*
+       stage k runs allgather of segment k-1 concurrently with reduce_scatter of segment k,
+       each phase is a separate subsched with own op_id to keep tags of concurrent phases apart
+    */
+    ccl_op_id_t op_id = 0;
+    for (size_t stage_idx = 0; stage_idx <= seg_count; stage_idx++) {
+        if (stage_idx > 0) {
+            size_t seg_idx = stage_idx - 1;
+            size_t cnt = (seg_idx == (seg_count - 1)) ? last_seg_size : main_seg_size;
+            ccl_buffer rbuf = recv_buf + seg_idx * main_seg_size * dtype_size;
+            entry_factory::create<subsched_entry>(
+                sched,
+                ++op_id,
+                [rbuf, cnt, dtype, comm](ccl_sched* s) {
+                    ccl_allreduce_ring_pipelined_add_allgather(s, rbuf, cnt, dtype, comm);
+                },
+                "RING_AG");
+        }
+
+        if (stage_idx < seg_count) {
+            size_t seg_idx = stage_idx;
+            size_t cnt = (seg_idx == (seg_count - 1)) ? last_seg_size : main_seg_size;
+            ccl_buffer sbuf = send_buf + seg_idx * main_seg_size * dtype_size;
+            ccl_buffer rbuf = recv_buf + seg_idx * main_seg_size * dtype_size;
+            entry_factory::create<subsched_entry>(
+                sched,
+                ++op_id,
+                [sbuf, rbuf, cnt, dtype, op, comm](ccl_sched* s) {
+                    ccl_coll_build_ring_reduce_scatter(s, sbuf, rbuf, cnt, dtype, op, comm);
+                },
+                "RING_RS");
+        }
+
+        sched->add_barrier();
+    }
+
+    return status;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 
 ccl::status ccl_coll_build_topo_allreduce(ccl_sched* sched,
@@ -0,0 +1,267 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "coll/algorithms/algorithms.hpp"
+#include "coll/algorithms/allreduce/allreduce_hierarchical.hpp"
+#include "coll/coll.hpp"
+#include "common/global/global.hpp"
+#include "sched/entry/factory/entry_factory.hpp"
+
+ccl_allreduce_hierarchical_builder::ccl_allreduce_hierarchical_builder(
+    size_t segment_size,
+    ccl_comm* comm,
+    std::shared_ptr<ccl_comm> node_comm,
+    std::shared_ptr<ccl_comm> r2r_comm)
+        : segment_size(segment_size),
+          node_comm(node_comm),
+          r2r_comm(r2r_comm) {
+    ccl_coll_attr attr{};
+    attr.synchronous = 1;
+
+    int local_rank = node_comm->rank();
+
+    /* chunk of local rank is allreduced over r2r_comm, its peers should have the same local rank */
+    int is_uniform = (node_comm->size() * r2r_comm->size() == comm->size());
+    int local_rank_range[2] = { local_rank, -local_rank };
+    ccl_allreduce_impl(local_rank_range,
+                       local_rank_range,
+                       2,
+                       ccl::datatype::int32,
+                       ccl::reduction::min,
+                       attr,
+                       r2r_comm.get(),
+                       nullptr,
+                       {});
+    is_uniform =
+        is_uniform && (local_rank_range[0] == local_rank) && (-local_rank_range[1] == local_rank);
+
+    /* all ranks should make the same decision */
+    int is_enabled = map_shm(comm) && is_uniform;
+    ccl_allreduce_impl(&is_enabled,
+                       &is_enabled,
+                       1,
+                       ccl::datatype::int32,
+                       ccl::reduction::min,
+                       attr,
+                       comm,
+                       nullptr,
+                       {});
+    enabled = is_enabled;
+
+    LOG_DEBUG("hierarchical allreduce: enabled ",
+              enabled,
+              ", uniform ",
+              is_uniform,
+              ", node_comm size ",
+              node_comm->size(),
+              ", r2r_comm size ",
+              r2r_comm->size(),
+              ", segment_size ",
+              segment_size,
+              ", shm_size ",
+              shm_size);
+}
+
+ccl_allreduce_hierarchical_builder::~ccl_allreduce_hierarchical_builder() {
+    if (shm_ptr) {
+        munmap(shm_ptr, shm_size);
+        shm_ptr = nullptr;
+    }
+    node_comm.reset();
+    r2r_comm.reset();
+}
+
+bool ccl_allreduce_hierarchical_builder::map_shm(ccl_comm* comm) {
+    ccl_coll_attr attr{};
+    attr.synchronous = 1;
+
+    int local_rank = node_comm->rank();
+    int local_size = node_comm->size();
+
+    /* region: per local rank flags, per local rank input slots, output slot */
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t flags_size = local_size * sizeof(ccl_shm_flag);
+    region_size = flags_size + (local_size + 1) * segment_size;
+    region_size = (region_size + page_size - 1) / page_size * page_size;
+    shm_size = region_size * CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT;
+
+    char shm_name[CCL_ALLREDUCE_HIERARCHICAL_SHM_NAME_LEN] = {};
+    int fd = -1;
+
+    if (local_rank == 0) {
+        snprintf(shm_name, sizeof(shm_name), "/ccl_hier_%d_%u", getpid(), comm->id());
+        fd = shm_open(shm_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 || ftruncate(fd, shm_size)) {
+            LOG_WARN("can not create shm segment ", shm_name, ": ", strerror(errno));
+            if (fd >= 0) {
+                close(fd);
+                shm_unlink(shm_name);
+                fd = -1;
+            }
+            shm_name[0] = '\0';
+        }
+    }
+
+    ccl_broadcast_impl(
+        shm_name, sizeof(shm_name), ccl::datatype::int8, 0, attr, node_comm.get(), nullptr, {});
+
+    if (!shm_name[0]) {
+        return false;
+    }
+
+    if (local_rank != 0) {
+        fd = shm_open(shm_name, O_RDWR, 0600);
+    }
+
+    if (fd >= 0) {
+        shm_ptr = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (shm_ptr == MAP_FAILED) {
+            shm_ptr = nullptr;
+        }
+        close(fd);
+    }
+
+    if (!shm_ptr) {
+        LOG_WARN("can not map shm segment ", shm_name, ": ", strerror(errno));
+    }
+
+    /* segment stays alive while it is mapped, unlink it as soon as all local ranks opened it */
+    ccl_barrier_impl(node_comm.get(), nullptr, {});
+    if (local_rank == 0) {
+        shm_unlink(shm_name);
+    }
+
+    if (!shm_ptr) {
+        return false;
+    }
+
+    regions.reset(new ccl_shm_region[CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT]);
+    for (size_t idx = 0; idx < CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT; idx++) {
+        char* region_ptr = static_cast<char*>(shm_ptr) + idx * region_size;
+        regions[idx].flags = reinterpret_cast<ccl_shm_flag*>(region_ptr);
+        regions[idx].data = region_ptr + flags_size;
+        regions[idx].serving_ticket.store(idx);
+    }
+
+    return true;
+}
+
+ccl_buffer ccl_allreduce_hierarchical_builder::get_slot(ccl_shm_binding* binding,
+                                                       int idx) const {
+    /* region is bound on schedule start, so slot is resolved through binding */
+    return ccl_buffer(&binding->data, region_size, idx * segment_size, ccl_buffer_type::INDIRECT);
+}
+
+ccl::status ccl_allreduce_hierarchical_builder::build(ccl_sched* sched,
+                                                      ccl_buffer send_buf,
+                                                      ccl_buffer recv_buf,
+                                                      size_t count,
+                                                      const ccl_datatype& dtype,
+                                                      ccl::reduction op) {
+    CCL_THROW_IF_NOT(enabled, "hierarchical allreduce is not available");
+
+    LOG_DEBUG("build hierarchical allreduce");
+
+    int local_rank = node_comm->rank();
+    int local_size = node_comm->size();
+    size_t dtype_size = dtype.size();
+
+    size_t seg_count = segment_size / dtype_size;
+    CCL_THROW_IF_NOT(seg_count > 0, "segment size ", segment_size, " is less than dtype size");
+
+    CCL_THROW_IF_NOT(sched->is_regular_partial(),
+                     "hierarchical allreduce requires schedule started from user call");
+
+    auto acquire_entry = entry_factory::create<shm_acquire_entry>(
+        sched, regions.get(), CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT, &next_ticket);
+    ccl_shm_binding* binding = acquire_entry->get_binding();
+    ccl_buffer out_slot = get_slot(binding, local_size);
+
+    ccl_op_id_t op_id = 0;
+    for (size_t seg_offset = 0; seg_offset < count; seg_offset += seg_count) {
+        size_t cnt = std::min(seg_count, count - seg_offset);
+        ccl_buffer sbuf = send_buf + seg_offset * dtype_size;
+        ccl_buffer rbuf = recv_buf + seg_offset * dtype_size;
+
+        size_t main_chunk_count = cnt / local_size;
+        size_t chunk_offset = main_chunk_count * local_rank;
+        size_t chunk_count =
+            (local_rank == local_size - 1) ? cnt - chunk_offset : main_chunk_count;
+        size_t chunk_end = chunk_offset + chunk_count;
+        ccl_buffer chunk_buf = rbuf + chunk_offset * dtype_size;
+
+        /* 1. publish input */
+        entry_factory::create<copy_entry>(sched, sbuf, get_slot(binding, local_rank), cnt, dtype);
+        sched->add_barrier();
+        entry_factory::create<shm_barrier_entry>(sched, binding, local_rank, local_size);
+
+        if (chunk_count) {
+            /* 2. reduce own chunk directly from input slots of all local ranks */
+            std::vector<ccl_buffer> in_bufs;
+            for (int idx = 0; idx < local_size; idx++) {
+                in_bufs.push_back(get_slot(binding, idx) + chunk_offset * dtype_size);
+            }
+            entry_factory::create<reduce_local_multi_entry>(
+                sched, in_bufs, chunk_count, chunk_buf, nullptr, dtype, op);
+            sched->add_barrier();
+
+            /* 3. allreduce own chunk with the same local ranks of other nodes */
+            if (r2r_comm->size() > 1) {
+                ccl_comm* comm = r2r_comm.get();
+                entry_factory::create<subsched_entry>(
+                    sched,
+                    ++op_id,
+                    [chunk_buf, chunk_count, dtype, op, comm](ccl_sched* s) {
+                        ccl_coll_build_allreduce(
+                            s, chunk_buf, chunk_buf, chunk_count, dtype, op, comm);
+                    },
+                    "HIER_R2R");
+                sched->add_barrier();
+            }
+
+            entry_factory::create<copy_entry>(
+                sched, chunk_buf, out_slot + chunk_offset * dtype_size, chunk_count, dtype);
+            sched->add_barrier();
+        }
+
+        /*
+           4. gather chunks of other local ranks,
+           output slot is overwritten only after the next shm barrier so no trailing barrier here
+        */
+        entry_factory::create<shm_barrier_entry>(sched, binding, local_rank, local_size);
+        if (chunk_offset) {
+            entry_factory::create<copy_entry>(sched, out_slot, rbuf, chunk_offset, dtype);
+        }
+        if (cnt > chunk_end) {
+            entry_factory::create<copy_entry>(sched,
+                                              out_slot + chunk_end * dtype_size,
+                                              rbuf + chunk_end * dtype_size,
+                                              cnt - chunk_end,
+                                              dtype);
+        }
+        sched->add_barrier();
+    }
+
+    entry_factory::create<shm_release_entry>(
+        sched, binding, CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT);
+
+    return ccl::status::success;
+}
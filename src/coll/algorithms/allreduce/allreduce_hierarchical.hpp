@@ -0,0 +1,80 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/utils/buffer.hpp"
+#include "sched/sched.hpp"
+
+#include <atomic>
+#include <memory>
+
+#define CCL_ALLREDUCE_HIERARCHICAL_REGION_COUNT 4
+#define CCL_ALLREDUCE_HIERARCHICAL_SHM_NAME_LEN 64
+
+class ccl_comm;
+struct ccl_shm_region;
+struct ccl_shm_binding;
+
+/*
+   allreduce over node_comm and r2r_comm:
+   each local rank reduces own chunk of data directly from node-local shared memory,
+   allreduces the chunk with the same local ranks of other nodes
+   and publishes result back through shared memory
+*/
+class ccl_allreduce_hierarchical_builder {
+public:
+    ccl_allreduce_hierarchical_builder(size_t segment_size,
+                                       ccl_comm* comm,
+                                       std::shared_ptr<ccl_comm> node_comm,
+                                       std::shared_ptr<ccl_comm> r2r_comm);
+    ~ccl_allreduce_hierarchical_builder();
+
+    ccl_allreduce_hierarchical_builder(const ccl_allreduce_hierarchical_builder&) = delete;
+    ccl_allreduce_hierarchical_builder(ccl_allreduce_hierarchical_builder&&) = delete;
+
+    ccl_allreduce_hierarchical_builder& operator=(const ccl_allreduce_hierarchical_builder&) =
+        delete;
+    ccl_allreduce_hierarchical_builder& operator=(ccl_allreduce_hierarchical_builder&&) = delete;
+
+    ccl::status build(ccl_sched* sched,
+                      ccl_buffer send_buf,
+                      ccl_buffer recv_buf,
+                      size_t count,
+                      const ccl_datatype& dtype,
+                      ccl::reduction op);
+
+    /* false if shared memory segment is not available on some node */
+    bool is_enabled() const {
+        return enabled;
+    }
+
+private:
+    bool map_shm(ccl_comm* comm);
+
+    ccl_buffer get_slot(ccl_shm_binding* binding, int idx) const;
+
+    size_t segment_size;
+    std::shared_ptr<ccl_comm> node_comm;
+    std::shared_ptr<ccl_comm> r2r_comm;
+
+    bool enabled = false;
+    void* shm_ptr = nullptr;
+    size_t shm_size = 0;
+    size_t region_size = 0;
+    /* concurrent schedules use different regions, selected by ticket taken on schedule start */
+    std::unique_ptr<ccl_shm_region[]> regions;
+    std::atomic<uint64_t> next_ticket{ 0 };
+};
@@ -13,13 +13,14 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <functional>
+#include <queue>
+
 #include "oneapi/ccl/type_traits.hpp"
 #include "coll/algorithms/sparse_allreduce/sparse_handler.hpp"
 #include "common/utils/memcpy.hpp"
 #include "sched/entry/factory/entry_factory.hpp"
 
-#define CCL_COALESCE_RESERVE_SIZE 16
-
 #define CCL_BF16_ONE 0x3f80
 #define CCL_BF16_MAX 0x7f7f
 #define CCL_BF16_MIN 0xff7f
@@ -73,6 +74,21 @@
                                                                                 reduction, \
                                                                                 comm))); \
                 break; \
+            case ccl_coll_sparse_allreduce_sharded: \
+                CCL_CALL((ccl_coll_build_sparse_allreduce_sharded<itype, vtype>(sched, \
+                                                                                send_ind_buf, \
+                                                                                send_ind_count, \
+                                                                                send_val_buf, \
+                                                                                send_val_count, \
+                                                                                recv_ind_buf, \
+                                                                                recv_ind_count, \
+                                                                                recv_val_buf, \
+                                                                                recv_val_count, \
+                                                                                index_dtype, \
+                                                                                value_dtype, \
+                                                                                reduction, \
+                                                                                comm))); \
+                break; \
             default: \
                 CCL_FATAL("unexpected sparse_allreduce_algo ", ccl_coll_algorithm_to_str(algo)); \
                 return ccl::status::invalid_arguments; \
@@ -198,6 +214,62 @@ typename std::enable_if<std::is_same<vtype, ccl::bfloat16>::value, vtype>::type
     }
 }
 
+/*
+   writes unique indices in order of map positions and their reduced values,
+   map offsets are updated to point to rows in dst_v
+*/
+template <typename i_type, typename v_type>
+void sparse_write_coalesced(ccl_sparse_allreduce_handler* sah,
+                            const v_type* src_v,
+                            idx_offset_map& iv_map,
+                            const ccl_sparse_index_groups& groups,
+                            const std::vector<size_t>& positions,
+                            i_type* dst_i,
+                            v_type* dst_v) {
+    ccl_sched* sched = sah->sched;
+    int keep_precision =
+        (sched->coll_attr.sparse_coalesce_mode == ccl::sparse_coalesce_mode::keep_precision &&
+         sah->value_dtype.idx() == ccl::datatype::bfloat16);
+
+    for (size_t idx = 0; idx < positions.size(); idx++) {
+        size_t pos = positions[idx];
+        size_t val_offset = idx * sah->val_dim_cnt;
+        size_t src_offset = iv_map.offset(pos);
+
+        dst_i[idx] = static_cast<i_type>(iv_map.key(pos));
+        std::copy(src_v + src_offset, src_v + src_offset + sah->val_dim_cnt, dst_v + val_offset);
+        iv_map.offset(pos) = val_offset;
+
+        /* reduce values from duplicate indices */
+        if (!groups.starts.empty() && (groups.starts[pos + 1] - groups.starts[pos] > 1)) {
+            ccl_comp_batch_reduce(src_v,
+                                  groups.offsets.data() + groups.starts[pos],
+                                  groups.starts[pos + 1] - groups.starts[pos],
+                                  sah->val_dim_cnt,
+                                  dst_v + val_offset,
+                                  nullptr,
+                                  sah->value_dtype,
+                                  sah->op,
+                                  nullptr,
+                                  nullptr,
+                                  keep_precision,
+                                  sah->tmp,
+                                  sah->acc);
+        }
+    }
+}
+
+/* writes unique indices in ascending order */
+template <typename i_type, typename v_type>
+void sparse_write_coalesced(ccl_sparse_allreduce_handler* sah,
+                            const v_type* src_v,
+                            idx_offset_map& iv_map,
+                            const ccl_sparse_index_groups& groups,
+                            i_type* dst_i,
+                            v_type* dst_v) {
+    sparse_write_coalesced(sah, src_v, iv_map, groups, iv_map.sorted_positions(), dst_i, dst_v);
+}
+
 template <typename i_type, typename v_type>
 void sparse_coalesce(ccl_sparse_allreduce_handler* sah) {
     std::unique_ptr<idx_offset_map> iv_map(new idx_offset_map);
@@ -205,17 +277,8 @@ void sparse_coalesce(ccl_sparse_allreduce_handler* sah) {
     v_type* src_v = (v_type*)sah->send_vbuf;
 
     /* fill in the <index:value_offset> map */
-    for (size_t i = 0; i < sah->send_count[0]; i++) {
-        auto it = iv_map->find(src_i[i]);
-        if (it == iv_map->end()) {
-            std::vector<size_t> tmp = { i * sah->val_dim_cnt };
-            tmp.reserve(CCL_COALESCE_RESERVE_SIZE);
-            iv_map->emplace(src_i[i], tmp);
-        }
-        else {
-            it->second.push_back(i * sah->val_dim_cnt);
-        }
-    }
+    ccl_sparse_index_groups groups;
+    sparse_group_indices(src_i, sah->send_count[0], sah->val_dim_cnt, *iv_map, groups);
 
     /* create buffer w/o duplicates */
     size_t iv_map_cnt = iv_map->size();
@@ -253,38 +316,8 @@ void sparse_coalesce(ccl_sparse_allreduce_handler* sah) {
 
     CCL_THROW_IF_NOT(dst_i && dst_v);
 
-    size_t idx_offset = 0;
-    size_t val_offset = 0;
-
-    for (auto& it : *iv_map) {
-        dst_i[idx_offset] = it.first;
-        val_offset = idx_offset * sah->val_dim_cnt;
-
-        std::copy(
-            src_v + it.second[0], src_v + it.second[0] + sah->val_dim_cnt, dst_v + val_offset);
-        it.second[0] = val_offset;
+    sparse_write_coalesced(sah, src_v, *iv_map, groups, dst_i, dst_v);
 
-        /* reduce values from duplicate indices */
-        if (it.second.size() > 1) {
-            ccl_comp_batch_reduce(src_v,
-                                  it.second,
-                                  sah->val_dim_cnt,
-                                  dst_v + val_offset,
-                                  nullptr,
-                                  sah->value_dtype,
-                                  sah->op,
-                                  nullptr,
-                                  nullptr,
-                                  (sched->coll_attr.sparse_coalesce_mode ==
-                                       ccl::sparse_coalesce_mode::keep_precision &&
-                                   sah->value_dtype.idx() == ccl::datatype::bfloat16),
-                                  sah->tmp,
-                                  sah->acc);
-
-            it.second.resize(1);
-        }
-        idx_offset++;
-    }
     sah->iv_map = std::move(iv_map);
 }
 
@@ -331,12 +364,12 @@ ccl::status sparse_reduce_ring(const void* ctx) {
     ones, then the values could be reduced right away. The indices left will be copied
     along with correspoinding values*/
     for (size_t idx = 0; idx < sa_hndl->send_count[0]; idx++) {
-        auto it = sa_hndl->iv_map->find(rcv_i[idx]);
-        if (it != sa_hndl->iv_map->end()) {
+        size_t pos = sa_hndl->iv_map->find(rcv_i[idx]);
+        if (pos != idx_offset_map::npos) {
             ccl_comp_reduce(sa_hndl->sched,
                             (void*)(rcv_v + idx * sa_hndl->val_dim_cnt),
                             sa_hndl->val_dim_cnt,
-                            snd_v + it->second[0],
+                            snd_v + sa_hndl->iv_map->offset(pos),
                             nullptr,
                             sa_hndl->value_dtype,
                             sa_hndl->op,
@@ -371,9 +404,8 @@ ccl::status sparse_reduce_ring(const void* ctx) {
             }
 
             /* upd the map */
-            std::vector<size_t> tmp = { sa_hndl->dst_count[1] + idx_offset * sa_hndl->val_dim_cnt };
-            tmp.reserve(CCL_COALESCE_RESERVE_SIZE);
-            sa_hndl->iv_map->emplace(rcv_i[id], tmp);
+            sa_hndl->iv_map->insert(rcv_i[id],
+                                    sa_hndl->dst_count[1] + idx_offset * sa_hndl->val_dim_cnt);
             idx_offset++;
         }
 
@@ -417,13 +449,14 @@ ccl::status sparse_prepare_result_ring(const void* ctx) {
     i_type* ibuf = (i_type*)(sa_hndl->dst_buf);
     v_type* vbuf = (v_type*)((i_type*)(sa_hndl->dst_buf) + sa_hndl->iv_map->size());
     std::vector<v_type> tmp(vbuf, vbuf + sa_hndl->iv_map->size() * sa_hndl->val_dim_cnt);
-    size_t idx_offset = 0;
-    for (auto& it : *sa_hndl->iv_map) {
-        ibuf[idx_offset] = it.first;
-        std::copy(tmp.begin() + it.second[0],
-                  tmp.begin() + it.second[0] + sa_hndl->val_dim_cnt,
+    std::vector<size_t> positions = sa_hndl->iv_map->sorted_positions();
+    for (size_t idx_offset = 0; idx_offset < positions.size(); idx_offset++) {
+        size_t pos = positions[idx_offset];
+        size_t val_offset = sa_hndl->iv_map->offset(pos);
+        ibuf[idx_offset] = static_cast<i_type>(sa_hndl->iv_map->key(pos));
+        std::copy(tmp.begin() + val_offset,
+                  tmp.begin() + val_offset + sa_hndl->val_dim_cnt,
                   vbuf + idx_offset * sa_hndl->val_dim_cnt);
-        idx_offset++;
     }
 
     *sa_hndl->recv_icount = sa_hndl->iv_map->size();
@@ -603,8 +636,10 @@ ccl::status sparse_create_matrix_mask(const void* ctx) {
               sa_hndl->recv_buf);
 
     /* get rid of the duplicates in allgathered indices list */
-    std::set<i_type> idx_set(static_cast<i_type*>(sa_hndl->recv_buf),
-                             static_cast<i_type*>(sa_hndl->recv_buf) + sa_hndl->recv_buf_count);
+    std::vector<i_type> idx_set(static_cast<i_type*>(sa_hndl->recv_buf),
+                                static_cast<i_type*>(sa_hndl->recv_buf) + sa_hndl->recv_buf_count);
+    std::sort(idx_set.begin(), idx_set.end());
+    idx_set.erase(std::unique(idx_set.begin(), idx_set.end()), idx_set.end());
 
     /* create a matrix expanded with zeros for indices that are not
        present in the unique indices list specified for this very process */
@@ -617,12 +652,12 @@ ccl::status sparse_create_matrix_mask(const void* ctx) {
 
     v_type mask_value = get_mask<v_type>(sa_hndl->op);
     size_t idx_offset = 0;
-    for (typename std::set<i_type>::iterator it = idx_set.begin(); it != idx_set.end(); ++it) {
-        auto elem = sa_hndl->iv_map->find(*it);
-        if (elem != sa_hndl->iv_map->end()) {
+    for (auto it = idx_set.begin(); it != idx_set.end(); ++it) {
+        size_t pos = sa_hndl->iv_map->find(*it);
+        if (pos != idx_offset_map::npos) {
             /* copy values from dst_buf to matrix */
             ccl::memcpy(matrix + idx_offset * sa_hndl->val_dim_cnt,
-                        values + elem->second[0],
+                        values + sa_hndl->iv_map->offset(pos),
                         value_line_size);
         }
         else {
@@ -879,17 +914,8 @@ ccl::status sparse_reduce_gathered_allgatherv(const void* ctx) {
     v_type* values = static_cast<v_type*>(sa_hndl->all_val_buf);
 
     std::unique_ptr<idx_offset_map> iv_map(new idx_offset_map);
-    for (size_t i = 0; i < sa_hndl->recv_buf_count; i++) {
-        auto it = iv_map->find(indices[i]);
-        if (it == iv_map->end()) {
-            std::vector<size_t> tmp = { i * sa_hndl->val_dim_cnt };
-            tmp.reserve(CCL_COALESCE_RESERVE_SIZE);
-            iv_map->emplace(indices[i], tmp);
-        }
-        else {
-            it->second.push_back(i * sa_hndl->val_dim_cnt);
-        }
-    }
+    ccl_sparse_index_groups groups;
+    sparse_group_indices(indices, sa_hndl->recv_buf_count, sa_hndl->val_dim_cnt, *iv_map, groups);
 
     size_t idx_cnt = iv_map->size();
     size_t i_new_size = sa_hndl->itype_size * idx_cnt;
@@ -922,36 +948,7 @@ ccl::status sparse_reduce_gathered_allgatherv(const void* ctx) {
 
     CCL_THROW_IF_NOT(i_recv && v_recv);
 
-    size_t idx_offset = 0;
-    size_t val_offset = 0;
-
-    for (auto& it : *iv_map) {
-        i_recv[idx_offset] = it.first;
-        val_offset = idx_offset * sa_hndl->val_dim_cnt;
-        std::copy(values + it.second[0],
-                  values + it.second[0] + sa_hndl->val_dim_cnt,
-                  v_recv + val_offset);
-        it.second[0] = val_offset;
-
-        /* reduce values from duplicate indices */
-        if (it.second.size() > 1) {
-            ccl_comp_batch_reduce(values,
-                                  it.second,
-                                  sa_hndl->val_dim_cnt,
-                                  v_recv + val_offset,
-                                  nullptr,
-                                  sa_hndl->value_dtype,
-                                  sa_hndl->op,
-                                  nullptr,
-                                  nullptr,
-                                  sched->coll_attr.sparse_coalesce_mode ==
-                                          ccl::sparse_coalesce_mode::keep_precision &&
-                                      sa_hndl->value_dtype.idx() == ccl::datatype::bfloat16,
-                                  sa_hndl->tmp,
-                                  sa_hndl->acc);
-        }
-        idx_offset++;
-    }
+    sparse_write_coalesced(sa_hndl, values, *iv_map, groups, i_recv, v_recv);
 
     iv_map->clear();
 
@@ -1006,6 +1003,50 @@ ccl::status sparse_get_v_send_allgatherv(const void* ctx, void* field_ptr) {
     return ccl::status::success;
 }
 
+/* gathers dst_ibuf/dst_vbuf of all ranks into all_idx_buf/all_val_buf */
+void sparse_add_allgatherv_entries(ccl_sched* sched,
+                                   ccl_sparse_allreduce_handler* sa_hndl,
+                                   const ccl_datatype& index_dtype,
+                                   const ccl_datatype& value_dtype,
+                                   ccl_comm* comm) {
+    int comm_size = comm->size();
+
+    // allgather indices
+    size_t parallel_request_index = 0;
+    ccl_coll_entry_param param_i{};
+    param_i.ctype = ccl_coll_allgatherv;
+    param_i.send_buf = ccl_buffer();
+    param_i.recv_buf = ccl_buffer();
+    param_i.send_count = 0;
+    param_i.recv_counts = sa_hndl->recv_counts;
+    param_i.dtype = index_dtype;
+    param_i.comm = comm;
+
+    coll_entry* ce = entry_factory::create<coll_entry>(sched, param_i, parallel_request_index);
+    ce->set_field_fn<ccl_sched_entry_field_send_buf>(sparse_get_i_send_allgatherv, sa_hndl);
+    ce->set_field_fn<ccl_sched_entry_field_recv_buf>(sparse_get_i_recv_allgatherv, sa_hndl);
+    ce->set_field_fn<ccl_sched_entry_field_send_count>(sparse_get_send_count_allgatherv<0>,
+                                                       sa_hndl);
+    entry_factory::create<function_entry>(sched, sparse_set_v_counts_allgatherv<1>, sa_hndl);
+
+    // allgather values
+    parallel_request_index++;
+    ccl_coll_entry_param param_v{};
+    param_v.ctype = ccl_coll_allgatherv;
+    param_v.send_buf = ccl_buffer();
+    param_v.recv_buf = ccl_buffer();
+    param_v.send_count = 0;
+    param_v.recv_counts = &sa_hndl->recv_counts[comm_size];
+    param_v.dtype = value_dtype;
+    param_v.comm = comm;
+
+    ce = entry_factory::create<coll_entry>(sched, param_v, parallel_request_index);
+    ce->set_field_fn<ccl_sched_entry_field_send_buf>(sparse_get_v_send_allgatherv, sa_hndl);
+    ce->set_field_fn<ccl_sched_entry_field_recv_buf>(sparse_get_v_recv_allgatherv, sa_hndl);
+    ce->set_field_fn<ccl_sched_entry_field_send_count>(sparse_get_send_count_allgatherv<1>,
+                                                       sa_hndl);
+}
+
 template <typename i_type, typename v_type>
 ccl::status sparse_coalesce_allgatherv(const void* ctx) {
     ccl_sparse_allreduce_handler* sa_hndl = (ccl_sparse_allreduce_handler*)ctx;
@@ -1094,40 +1135,7 @@ ccl::status ccl_coll_build_sparse_allreduce_3_allgatherv(ccl_sched* sched,
     entry_factory::create<function_entry>(sched, sparse_alloc_result_buf_allgatherv, sa_hndl);
     sched->add_barrier();
 
-    // allgather indices
-    size_t parallel_request_index = 0;
-    ccl_coll_entry_param param_i{};
-    param_i.ctype = ccl_coll_allgatherv;
-    param_i.send_buf = ccl_buffer();
-    param_i.recv_buf = ccl_buffer();
-    param_i.send_count = 0;
-    param_i.recv_counts = sa_hndl->recv_counts;
-    param_i.dtype = index_dtype;
-    param_i.comm = comm;
-
-    coll_entry* ce = entry_factory::create<coll_entry>(sched, param_i, parallel_request_index);
-    ce->set_field_fn<ccl_sched_entry_field_send_buf>(sparse_get_i_send_allgatherv, sa_hndl);
-    ce->set_field_fn<ccl_sched_entry_field_recv_buf>(sparse_get_i_recv_allgatherv, sa_hndl);
-    ce->set_field_fn<ccl_sched_entry_field_send_count>(sparse_get_send_count_allgatherv<0>,
-                                                       sa_hndl);
-    entry_factory::create<function_entry>(sched, sparse_set_v_counts_allgatherv<1>, sa_hndl);
-
-    // allgather values
-    parallel_request_index++;
-    ccl_coll_entry_param param_v{};
-    param_v.ctype = ccl_coll_allgatherv;
-    param_v.send_buf = ccl_buffer();
-    param_v.recv_buf = ccl_buffer();
-    param_v.send_count = 0;
-    param_v.recv_counts = &sa_hndl->recv_counts[comm_size];
-    param_v.dtype = value_dtype;
-    param_v.comm = comm;
-
-    ce = entry_factory::create<coll_entry>(sched, param_v, parallel_request_index);
-    ce->set_field_fn<ccl_sched_entry_field_send_buf>(sparse_get_v_send_allgatherv, sa_hndl);
-    ce->set_field_fn<ccl_sched_entry_field_recv_buf>(sparse_get_v_recv_allgatherv, sa_hndl);
-    ce->set_field_fn<ccl_sched_entry_field_send_count>(sparse_get_send_count_allgatherv<1>,
-                                                       sa_hndl);
+    sparse_add_allgatherv_entries(sched, sa_hndl, index_dtype, value_dtype, comm);
     sched->add_barrier();
 
     if (sched->coll_attr.sparse_coalesce_mode == ccl::sparse_coalesce_mode::disable) {
@@ -1141,3 +1149,446 @@ ccl::status ccl_coll_build_sparse_allreduce_3_allgatherv(ccl_sched* sched,
 
     return status;
 }
+
+/*
+   owner rank of index in sharded algo,
+   upper bits of fibonacci hash spread strided and clustered indices evenly
+*/
+int sparse_get_owner_sharded(size_t idx, int comm_size) {
+    return static_cast<int>(((static_cast<uint64_t>(idx) * 0x9E3779B97F4A7C15ull) >> 32) %
+                            comm_size);
+}
+
+void* sparse_alloc_buf_sharded(ccl_sched* sched, size_t bytes) {
+    return (bytes) ? sched->alloc_buffer(bytes).get_ptr() : nullptr;
+}
+
+template <typename i_type, typename v_type>
+ccl::status sparse_partition_sharded(const void* ctx) {
+    ccl_sparse_allreduce_handler* sa_hndl = (ccl_sparse_allreduce_handler*)ctx;
+    i_type* src_i = (i_type*)sa_hndl->send_ibuf;
+    v_type* src_v = (v_type*)sa_hndl->send_vbuf;
+    int comm_size = sa_hndl->comm_size;
+
+    /* coalesce local duplicates before sending to owners */
+    idx_offset_map iv_map;
+    ccl_sparse_index_groups groups;
+    sparse_group_indices(src_i, sa_hndl->send_count[0], sa_hndl->val_dim_cnt, iv_map, groups);
+
+    size_t iv_map_cnt = iv_map.size();
+
+    /* counting sort of unique indices by owner */
+    std::vector<int> owners(iv_map_cnt);
+    size_t* send_counts = sa_hndl->shard_send_counts;
+    size_t* send_offsets = sa_hndl->shard_send_offsets;
+    std::fill(send_counts, send_counts + comm_size, 0);
+
+    for (size_t pos = 0; pos < iv_map_cnt; pos++) {
+        owners[pos] = sparse_get_owner_sharded(iv_map.key(pos), comm_size);
+        send_counts[owners[pos]]++;
+    }
+
+    send_offsets[0] = 0;
+    for (int rank = 1; rank < comm_size; rank++) {
+        send_offsets[rank] = send_offsets[rank - 1] + send_counts[rank - 1];
+    }
+
+    std::vector<size_t> fill_idx(send_offsets, send_offsets + comm_size);
+    std::vector<size_t> positions(iv_map_cnt);
+    for (size_t pos = 0; pos < iv_map_cnt; pos++) {
+        positions[fill_idx[owners[pos]]++] = pos;
+    }
+
+    ccl_sched* sched = sa_hndl->sched;
+    sa_hndl->shard_send_ibuf = sparse_alloc_buf_sharded(sched, iv_map_cnt * sa_hndl->itype_size);
+    sa_hndl->shard_send_vbuf = sparse_alloc_buf_sharded(
+        sched, iv_map_cnt * sa_hndl->val_dim_cnt * sa_hndl->vtype_size);
+
+    if (iv_map_cnt) {
+        sparse_write_coalesced(sa_hndl,
+                               src_v,
+                               iv_map,
+                               groups,
+                               positions,
+                               (i_type*)sa_hndl->shard_send_ibuf,
+                               (v_type*)sa_hndl->shard_send_vbuf);
+    }
+
+    int rank = sa_hndl->comm->rank();
+    sa_hndl->shard_recv_counts[rank] = send_counts[rank];
+
+    return ccl::status::success;
+}
+
+ccl::status sparse_alloc_shard_sharded(const void* ctx) {
+    ccl_sparse_allreduce_handler* sa_hndl = (ccl_sparse_allreduce_handler*)ctx;
+    int comm_size = sa_hndl->comm_size;
+    size_t* recv_counts = sa_hndl->shard_recv_counts;
+    size_t* recv_offsets = sa_hndl->shard_recv_offsets;
+
+    recv_offsets[0] = 0;
+    for (int rank = 1; rank < comm_size; rank++) {
+        recv_offsets[rank] = recv_offsets[rank - 1] + recv_counts[rank - 1];
+    }
+
+    size_t total_count = recv_offsets[comm_size - 1] + recv_counts[comm_size - 1];
+    size_t val_row_size = sa_hndl->val_dim_cnt * sa_hndl->vtype_size;
+
+    ccl_sched* sched = sa_hndl->sched;
+    sa_hndl->shard_recv_ibuf = sparse_alloc_buf_sharded(sched, total_count * sa_hndl->itype_size);
+    sa_hndl->shard_recv_vbuf = sparse_alloc_buf_sharded(sched, total_count * val_row_size);
+
+    /* own part of shard doesn't go through the network */
+    int rank = sa_hndl->comm->rank();
+    size_t count = recv_counts[rank];
+    if (count) {
+        size_t send_offset = sa_hndl->shard_send_offsets[rank];
+        memcpy((char*)sa_hndl->shard_recv_ibuf + recv_offsets[rank] * sa_hndl->itype_size,
+               (char*)sa_hndl->shard_send_ibuf + send_offset * sa_hndl->itype_size,
+               count * sa_hndl->itype_size);
+        memcpy((char*)sa_hndl->shard_recv_vbuf + recv_offsets[rank] * val_row_size,
+               (char*)sa_hndl->shard_send_vbuf + send_offset * val_row_size,
+               count * val_row_size);
+    }
+
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_i_send_buf_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    ccl_sparse_allreduce_handler* sa_hndl = peer->sa_hndl;
+    ccl_buffer* buf_ptr = (ccl_buffer*)field_ptr;
+    buf_ptr->set((char*)sa_hndl->shard_send_ibuf +
+                 sa_hndl->shard_send_offsets[peer->peer] * sa_hndl->itype_size);
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_v_send_buf_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    ccl_sparse_allreduce_handler* sa_hndl = peer->sa_hndl;
+    ccl_buffer* buf_ptr = (ccl_buffer*)field_ptr;
+    buf_ptr->set((char*)sa_hndl->shard_send_vbuf + sa_hndl->shard_send_offsets[peer->peer] *
+                                                       sa_hndl->val_dim_cnt * sa_hndl->vtype_size);
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_i_recv_buf_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    ccl_sparse_allreduce_handler* sa_hndl = peer->sa_hndl;
+    ccl_buffer* buf_ptr = (ccl_buffer*)field_ptr;
+    buf_ptr->set((char*)sa_hndl->shard_recv_ibuf +
+                 sa_hndl->shard_recv_offsets[peer->peer] * sa_hndl->itype_size);
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_v_recv_buf_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    ccl_sparse_allreduce_handler* sa_hndl = peer->sa_hndl;
+    ccl_buffer* buf_ptr = (ccl_buffer*)field_ptr;
+    buf_ptr->set((char*)sa_hndl->shard_recv_vbuf + sa_hndl->shard_recv_offsets[peer->peer] *
+                                                       sa_hndl->val_dim_cnt * sa_hndl->vtype_size);
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_i_send_count_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    *(size_t*)field_ptr = peer->sa_hndl->shard_send_counts[peer->peer];
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_v_send_count_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    *(size_t*)field_ptr =
+        peer->sa_hndl->shard_send_counts[peer->peer] * peer->sa_hndl->val_dim_cnt;
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_i_recv_count_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    *(size_t*)field_ptr = peer->sa_hndl->shard_recv_counts[peer->peer];
+    return ccl::status::success;
+}
+
+ccl::status sparse_get_v_recv_count_sharded(const void* ctx, void* field_ptr) {
+    const ccl_sparse_shard_peer* peer = (const ccl_sparse_shard_peer*)ctx;
+    *(size_t*)field_ptr =
+        peer->sa_hndl->shard_recv_counts[peer->peer] * peer->sa_hndl->val_dim_cnt;
+    return ccl::status::success;
+}
+
+template <typename i_type, typename v_type>
+ccl::status sparse_reduce_shard_sharded(const void* ctx) {
+    ccl_sparse_allreduce_handler* sa_hndl = (ccl_sparse_allreduce_handler*)ctx;
+    int comm_size = sa_hndl->comm_size;
+    size_t total_count =
+        sa_hndl->shard_recv_offsets[comm_size - 1] + sa_hndl->shard_recv_counts[comm_size - 1];
+
+    idx_offset_map iv_map;
+    ccl_sparse_index_groups groups;
+    sparse_group_indices(
+        (i_type*)sa_hndl->shard_recv_ibuf, total_count, sa_hndl->val_dim_cnt, iv_map, groups);
+
+    size_t idx_cnt = iv_map.size();
+
+    ccl_sched* sched = sa_hndl->sched;
+    sa_hndl->dst_ibuf = sparse_alloc_buf_sharded(sched, idx_cnt * sa_hndl->itype_size);
+    sa_hndl->dst_vbuf =
+        sparse_alloc_buf_sharded(sched, idx_cnt * sa_hndl->val_dim_cnt * sa_hndl->vtype_size);
+
+    if (idx_cnt) {
+        sparse_write_coalesced(sa_hndl,
+                               (v_type*)sa_hndl->shard_recv_vbuf,
+                               iv_map,
+                               groups,
+                               (i_type*)sa_hndl->dst_ibuf,
+                               (v_type*)sa_hndl->dst_vbuf);
+    }
+
+    sa_hndl->send_count[0] = idx_cnt;
+    sa_hndl->send_count[1] = idx_cnt * sa_hndl->val_dim_cnt;
+
+    return ccl::status::success;
+}
+
+template <typename i_type, typename v_type>
+ccl::status sparse_merge_shards_sharded(const void* ctx) {
+    ccl_sparse_allreduce_handler* sa_hndl = (ccl_sparse_allreduce_handler*)ctx;
+    int comm_size = sa_hndl->comm_size;
+    size_t val_dim_cnt = sa_hndl->val_dim_cnt;
+    size_t idx_cnt = sa_hndl->recv_buf_count;
+
+    const i_type* all_i = (i_type*)sa_hndl->all_idx_buf;
+    const v_type* all_v = (v_type*)sa_hndl->all_val_buf;
+
+    i_type* i_recv = nullptr;
+    v_type* v_recv = nullptr;
+
+    ccl_sched* sched = sa_hndl->sched;
+
+    if (sched->coll_attr.sparse_allreduce_alloc_fn) {
+        sched->coll_attr.sparse_allreduce_alloc_fn(idx_cnt,
+                                                   sa_hndl->index_dtype.idx(),
+                                                   idx_cnt * val_dim_cnt,
+                                                   sa_hndl->value_dtype.idx(),
+                                                   sched->coll_attr.sparse_allreduce_fn_ctx,
+                                                   &sa_hndl->dst_ibuf,
+                                                   &sa_hndl->dst_vbuf);
+    }
+    else {
+        sa_hndl->dst_ibuf = sched->alloc_buffer(idx_cnt * sa_hndl->itype_size).get_ptr();
+        sa_hndl->dst_vbuf =
+            sched->alloc_buffer(idx_cnt * val_dim_cnt * sa_hndl->vtype_size).get_ptr();
+    }
+
+    i_recv = (i_type*)sa_hndl->dst_ibuf;
+    v_recv = (v_type*)sa_hndl->dst_vbuf;
+
+    CCL_THROW_IF_NOT(i_recv && v_recv);
+
+    /* shards are sorted and disjoint, merge them to keep ascending order of indices */
+    typedef std::pair<i_type, int> shard_head_t;
+    std::priority_queue<shard_head_t, std::vector<shard_head_t>, std::greater<shard_head_t>> heads;
+    std::vector<size_t> shard_pos(comm_size), shard_end(comm_size);
+
+    size_t offset = 0;
+    for (int rank = 0; rank < comm_size; rank++) {
+        shard_pos[rank] = offset;
+        offset += sa_hndl->recv_counts[rank];
+        shard_end[rank] = offset;
+        if (shard_pos[rank] < shard_end[rank])
+            heads.emplace(all_i[shard_pos[rank]], rank);
+    }
+
+    for (size_t idx = 0; !heads.empty(); idx++) {
+        int rank = heads.top().second;
+        heads.pop();
+
+        size_t src = shard_pos[rank]++;
+        i_recv[idx] = all_i[src];
+        std::copy(all_v + src * val_dim_cnt,
+                  all_v + (src + 1) * val_dim_cnt,
+                  v_recv + idx * val_dim_cnt);
+
+        if (shard_pos[rank] < shard_end[rank])
+            heads.emplace(all_i[shard_pos[rank]], rank);
+    }
+
+    *sa_hndl->recv_icount = idx_cnt;
+    *sa_hndl->recv_vcount = idx_cnt * val_dim_cnt;
+
+    *sa_hndl->recv_ibuf = i_recv;
+    *sa_hndl->recv_vbuf = v_recv;
+
+    return ccl::status::success;
+}
+
+/*
+   each rank owns hash range of indices:
+   local coalesce -> rows to owners -> owners coalesce their shards -> allgatherv of shards,
+   unlike allgatherv algo every rank reduces only its own part of the unique indices
+*/
+template <typename i_type, typename v_type>
+ccl::status ccl_coll_build_sparse_allreduce_sharded(ccl_sched* sched,
+                                                    ccl_buffer send_ind_buf,
+                                                    size_t send_ind_count,
+                                                    ccl_buffer send_val_buf,
+                                                    size_t send_val_count,
+                                                    void** recv_ind_buf,
+                                                    size_t* recv_ind_count,
+                                                    void** recv_val_buf,
+                                                    size_t* recv_val_count,
+                                                    const ccl_datatype& index_dtype,
+                                                    const ccl_datatype& value_dtype,
+                                                    ccl::reduction op,
+                                                    ccl_comm* comm) {
+    ccl::status status = ccl::status::success;
+
+    int comm_size = comm->size();
+    int rank = comm->rank();
+
+    if (comm_size == 1) {
+        /* nothing to exchange, local coalescing is the whole work */
+        return ccl_coll_build_sparse_allreduce_3_allgatherv<i_type, v_type>(sched,
+                                                                            send_ind_buf,
+                                                                            send_ind_count,
+                                                                            send_val_buf,
+                                                                            send_val_count,
+                                                                            recv_ind_buf,
+                                                                            recv_ind_count,
+                                                                            recv_val_buf,
+                                                                            recv_val_count,
+                                                                            index_dtype,
+                                                                            value_dtype,
+                                                                            op,
+                                                                            comm);
+    }
+
+    /* get data type sizes */
+    size_t vtype_size = sizeof(v_type);
+    size_t itype_size = sizeof(i_type);
+
+    /* get value dimension */
+    size_t val_dim_cnt = send_val_count / send_ind_count;
+
+    CCL_ASSERT(recv_ind_buf && recv_val_buf, "recv buffers are null");
+    CCL_ASSERT(recv_ind_count && recv_val_count, "recv counts are null");
+
+    void** r_ind_buf = recv_ind_buf;
+    void** r_val_buf = recv_val_buf;
+
+    ccl_sparse_allreduce_handler* sa_hndl;
+    CCL_SPARSE_ALLREDUCE_CREATE_HANDLER();
+
+    constexpr size_t parallel_requests_count = 2; //indices + values
+    sa_hndl->recv_counts = static_cast<size_t*>(
+        sched->alloc_buffer(sizeof(size_t) * comm_size * parallel_requests_count).get_ptr());
+
+    size_t* shard_counts =
+        static_cast<size_t*>(sched->alloc_buffer(sizeof(size_t) * comm_size * 4).get_ptr());
+    sa_hndl->shard_send_counts = shard_counts;
+    sa_hndl->shard_recv_counts = shard_counts + comm_size;
+    sa_hndl->shard_send_offsets = shard_counts + 2 * comm_size;
+    sa_hndl->shard_recv_offsets = shard_counts + 3 * comm_size;
+
+    sa_hndl->shard_peers = static_cast<ccl_sparse_shard_peer*>(
+        sched->alloc_buffer(sizeof(ccl_sparse_shard_peer) * comm_size).get_ptr());
+
+    LOG_DEBUG("sa_hndl: ",
+              sa_hndl,
+              ", sa_hndl->recv_ibuf: ",
+              sa_hndl->recv_ibuf,
+              ", sa_hndl->recv_vbuf: ",
+              sa_hndl->recv_vbuf,
+              ", sa_hndl->val_dim_cnt: ",
+              sa_hndl->val_dim_cnt);
+
+    entry_factory::create<function_entry>(
+        sched, sparse_partition_sharded<i_type, v_type>, sa_hndl);
+    sched->add_barrier();
+
+    /* exchange number of rows for each owner */
+    for (int idx = 1; idx < comm_size; idx++) {
+        int dst = (rank + idx) % comm_size;
+        int src = (rank - idx + comm_size) % comm_size;
+
+        entry_factory::create<send_entry>(sched,
+                                          ccl_buffer(&sa_hndl->shard_send_counts[dst],
+                                                     sizeof(size_t)),
+                                          sizeof(size_t),
+                                          ccl_datatype_int8,
+                                          dst,
+                                          comm);
+        entry_factory::create<recv_entry>(sched,
+                                          ccl_buffer(&sa_hndl->shard_recv_counts[src],
+                                                     sizeof(size_t)),
+                                          sizeof(size_t),
+                                          ccl_datatype_int8,
+                                          src,
+                                          comm);
+    }
+    sched->add_barrier();
+
+    entry_factory::create<function_entry>(sched, sparse_alloc_shard_sharded, sa_hndl);
+    sched->add_barrier();
+
+    /* send rows to owners, indices and values go in parallel requests */
+    ccl_sched* shard_scheds[parallel_requests_count];
+    for (size_t idx = 0; idx < parallel_requests_count; idx++) {
+        shard_scheds[idx] =
+            entry_factory::create<subsched_entry>(
+                sched, idx, [](ccl_sched* s) {}, (idx == 0) ? "SHARD_IDX" : "SHARD_VAL")
+                ->get_subsched();
+    }
+
+    for (int idx = 1; idx < comm_size; idx++) {
+        int dst = (rank + idx) % comm_size;
+        int src = (rank - idx + comm_size) % comm_size;
+
+        ccl_sparse_shard_peer* dst_peer = &sa_hndl->shard_peers[dst];
+        dst_peer->sa_hndl = sa_hndl;
+        dst_peer->peer = dst;
+
+        ccl_sparse_shard_peer* src_peer = &sa_hndl->shard_peers[src];
+        src_peer->sa_hndl = sa_hndl;
+        src_peer->peer = src;
+
+        send_entry* se = entry_factory::create<send_entry>(
+            shard_scheds[0], ccl_buffer(), 0, index_dtype, dst, comm);
+        se->set_field_fn<ccl_sched_entry_field_buf>(sparse_get_i_send_buf_sharded, dst_peer);
+        se->set_field_fn<ccl_sched_entry_field_cnt>(sparse_get_i_send_count_sharded, dst_peer);
+
+        recv_entry* re = entry_factory::create<recv_entry>(
+            shard_scheds[0], ccl_buffer(), 0, index_dtype, src, comm);
+        re->set_field_fn<ccl_sched_entry_field_buf>(sparse_get_i_recv_buf_sharded, src_peer);
+        re->set_field_fn<ccl_sched_entry_field_cnt>(sparse_get_i_recv_count_sharded, src_peer);
+
+        se = entry_factory::create<send_entry>(
+            shard_scheds[1], ccl_buffer(), 0, value_dtype, dst, comm);
+        se->set_field_fn<ccl_sched_entry_field_buf>(sparse_get_v_send_buf_sharded, dst_peer);
+        se->set_field_fn<ccl_sched_entry_field_cnt>(sparse_get_v_send_count_sharded, dst_peer);
+
+        re = entry_factory::create<recv_entry>(
+            shard_scheds[1], ccl_buffer(), 0, value_dtype, src, comm);
+        re->set_field_fn<ccl_sched_entry_field_buf>(sparse_get_v_recv_buf_sharded, src_peer);
+        re->set_field_fn<ccl_sched_entry_field_cnt>(sparse_get_v_recv_count_sharded, src_peer);
+    }
+    sched->add_barrier();
+
+    entry_factory::create<function_entry>(
+        sched, sparse_reduce_shard_sharded<i_type, v_type>, sa_hndl);
+    sched->add_barrier();
+
+    CCL_SPARSE_ALLREDUCE_ADD_NNZ_ENTRY();
+
+    entry_factory::create<function_entry>(sched, sparse_alloc_result_buf_allgatherv, sa_hndl);
+    sched->add_barrier();
+
+    sparse_add_allgatherv_entries(sched, sa_hndl, index_dtype, value_dtype, comm);
+    sched->add_barrier();
+
+    entry_factory::create<function_entry>(
+        sched, sparse_merge_shards_sharded<i_type, v_type>, sa_hndl);
+    sched->add_barrier();
+
+    return status;
+}
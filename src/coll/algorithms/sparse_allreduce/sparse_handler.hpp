@@ -15,9 +15,11 @@
 */
 #pragma once
 
-#include <unordered_map>
+#include "coll/algorithms/sparse_allreduce/sparse_index_map.hpp"
 
-typedef std::map<size_t, std::vector<size_t>> idx_offset_map;
+typedef ccl_sparse_index_map idx_offset_map;
+
+struct ccl_sparse_shard_peer;
 
 struct ccl_sparse_allreduce_handler {
     size_t val_dim_cnt;
@@ -51,6 +53,18 @@ struct ccl_sparse_allreduce_handler {
     void* all_idx_buf;
     void* all_val_buf;
 
+    /* per-rank index counts and offsets for sharded algo */
+    size_t* shard_send_counts;
+    size_t* shard_recv_counts;
+    size_t* shard_send_offsets;
+    size_t* shard_recv_offsets;
+    ccl_sparse_shard_peer* shard_peers;
+
+    void* shard_send_ibuf;
+    void* shard_send_vbuf;
+    void* shard_recv_ibuf;
+    void* shard_recv_vbuf;
+
     void* send_ibuf;
     void* send_vbuf;
 
@@ -65,3 +79,9 @@ struct ccl_sparse_allreduce_handler {
     ccl_sched* sched;
     ccl_comm* comm;
 };
+
+/* context of field functions for exchange with single peer in sharded algo */
+struct ccl_sparse_shard_peer {
+    ccl_sparse_allreduce_handler* sa_hndl;
+    int peer;
+};
@@ -0,0 +1,222 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#define CCL_SPARSE_INDEX_MAP_MIN_CAPACITY 64
+#define CCL_SPARSE_INDEX_MAP_RADIX_BITS   8
+#define CCL_SPARSE_INDEX_MAP_RADIX_MIN    256
+
+/*
+   open addressing (linear probing) hash map from index to offset of its values,
+   entries are stored in flat arrays in insertion order and are addressed by position,
+   table keeps position + 1 of entry or 0 for empty slot, load factor is at most 1/2
+*/
+class ccl_sparse_index_map {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    ccl_sparse_index_map() {
+        rehash(CCL_SPARSE_INDEX_MAP_MIN_CAPACITY);
+    }
+
+    void reserve(size_t count) {
+        keys.reserve(count);
+        offsets.reserve(count);
+        if (count * 2 > table.size()) {
+            rehash(count * 2);
+        }
+    }
+
+    size_t size() const {
+        return keys.size();
+    }
+
+    void clear() {
+        keys.clear();
+        offsets.clear();
+        std::fill(table.begin(), table.end(), 0);
+    }
+
+    /* returns position of key and true if key was inserted with provided offset */
+    std::pair<size_t, bool> insert(size_t key, size_t offset) {
+        size_t slot = get_slot(key);
+        for (; table[slot]; slot = (slot + 1) & mask) {
+            size_t pos = table[slot] - 1;
+            if (keys[pos] == key)
+                return { pos, false };
+        }
+
+        size_t pos = keys.size();
+        keys.push_back(key);
+        offsets.push_back(offset);
+        table[slot] = pos + 1;
+
+        if (keys.size() * 2 > table.size()) {
+            rehash(table.size() * 2);
+        }
+
+        return { pos, true };
+    }
+
+    /* returns position of key or npos */
+    size_t find(size_t key) const {
+        for (size_t slot = get_slot(key); table[slot]; slot = (slot + 1) & mask) {
+            size_t pos = table[slot] - 1;
+            if (keys[pos] == key)
+                return pos;
+        }
+        return npos;
+    }
+
+    size_t key(size_t pos) const {
+        return keys[pos];
+    }
+
+    size_t& offset(size_t pos) {
+        return offsets[pos];
+    }
+
+    /* positions of entries in ascending order of keys */
+    std::vector<size_t> sorted_positions() const {
+        std::vector<size_t> positions(keys.size());
+        for (size_t pos = 0; pos < positions.size(); pos++) {
+            positions[pos] = pos;
+        }
+
+        if (positions.size() < CCL_SPARSE_INDEX_MAP_RADIX_MIN) {
+            std::sort(positions.begin(), positions.end(), [this](size_t a, size_t b) {
+                return keys[a] < keys[b];
+            });
+            return positions;
+        }
+
+        /* LSD radix sort, passes where all keys have the same digit are skipped */
+        constexpr size_t bucket_count = 1 << CCL_SPARSE_INDEX_MAP_RADIX_BITS;
+        std::vector<size_t> tmp(positions.size());
+        for (size_t digit_shift = 0; digit_shift < sizeof(size_t) * 8;
+             digit_shift += CCL_SPARSE_INDEX_MAP_RADIX_BITS) {
+            size_t counts[bucket_count] = {};
+            for (size_t pos : positions) {
+                counts[(keys[pos] >> digit_shift) & (bucket_count - 1)]++;
+            }
+
+            if (counts[(keys[0] >> digit_shift) & (bucket_count - 1)] == positions.size())
+                continue;
+
+            size_t sum = 0;
+            for (size_t idx = 0; idx < bucket_count; idx++) {
+                size_t count = counts[idx];
+                counts[idx] = sum;
+                sum += count;
+            }
+
+            for (size_t pos : positions) {
+                tmp[counts[(keys[pos] >> digit_shift) & (bucket_count - 1)]++] = pos;
+            }
+            positions.swap(tmp);
+        }
+
+        return positions;
+    }
+
+private:
+    size_t get_slot(size_t key) const {
+        /* fibonacci hashing, top bits of product are well mixed for sequential keys */
+        return (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> shift;
+    }
+
+    void rehash(size_t capacity) {
+        size_t new_size = 1;
+        shift = 64;
+        while (new_size < std::max(capacity, size_t(CCL_SPARSE_INDEX_MAP_MIN_CAPACITY))) {
+            new_size <<= 1;
+            shift--;
+        }
+
+        table.assign(new_size, 0);
+        mask = new_size - 1;
+
+        for (size_t pos = 0; pos < keys.size(); pos++) {
+            size_t slot = get_slot(keys[pos]);
+            while (table[slot]) {
+                slot = (slot + 1) & mask;
+            }
+            table[slot] = pos + 1;
+        }
+    }
+
+    std::vector<size_t> keys;
+    std::vector<size_t> offsets;
+    std::vector<size_t> table;
+    size_t mask = 0;
+    unsigned shift = 0;
+};
+
+/*
+   value offsets of all rows of index at map position pos in CSR form:
+   offsets[starts[pos]] .. offsets[starts[pos + 1] - 1]
+*/
+struct ccl_sparse_index_groups {
+    std::vector<size_t> starts;
+    std::vector<size_t> offsets;
+};
+
+/*
+   fills map with unique indices and offsets of their first value rows,
+   groups are built only when there are duplicates
+*/
+template <typename i_type>
+void sparse_group_indices(const i_type* src_i,
+                          size_t count,
+                          size_t val_dim_cnt,
+                          ccl_sparse_index_map& iv_map,
+                          ccl_sparse_index_groups& groups) {
+    std::vector<size_t> positions(count);
+
+    iv_map.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        positions[i] = iv_map.insert(src_i[i], i * val_dim_cnt).first;
+    }
+
+    groups.starts.clear();
+    groups.offsets.clear();
+
+    size_t unique_count = iv_map.size();
+    if (unique_count == count)
+        return;
+
+    groups.starts.assign(unique_count + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        groups.starts[positions[i] + 1]++;
+    }
+    for (size_t pos = 0; pos < unique_count; pos++) {
+        groups.starts[pos + 1] += groups.starts[pos];
+    }
+
+    /* keep original order of duplicates to preserve reduction order */
+    std::vector<size_t> fill_idx(groups.starts.begin(), groups.starts.end() - 1);
+    groups.offsets.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        groups.offsets[fill_idx[positions[i]]++] = i * val_dim_cnt;
+    }
+}
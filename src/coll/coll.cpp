@@ -59,6 +59,13 @@
 #include "fusion/fusion.hpp"
 #include "unordered_coll/unordered_coll.hpp"
 
+/* nested builds of algorithm parts don't override algorithm of the outer collective */
+static void ccl_sched_set_algo_name(ccl_sched* sched, const std::string& name) {
+    if (!sched->algo_name) {
+        sched->algo_name = name.c_str();
+    }
+}
+
 /* param is not const because param.comm can be updated for unordered colls */
 static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr& in_attr) {
     ccl_coll_attr& attr = const_cast<ccl_coll_attr&>(in_attr);
@@ -109,7 +116,8 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
     ccl_master_sched* sched = ccl_master_sched::create(param, attr);
 
     /* 3. fuse schedule */
-    if (!postpone_schedule && ccl::global_data::env().enable_fusion) {
+    if (!postpone_schedule && ccl::global_data::env().enable_fusion &&
+        !attr.hint_algo.has_value()) {
         if (data.fusion_manager->add(sched)) {
             LOG_DEBUG("sched ",
                       sched,
@@ -162,6 +170,8 @@ ccl::status ccl_coll_build_allgatherv(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_allgatherv>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_allgatherv_direct:
             CCL_CALL(ccl_coll_build_direct_allgatherv(
@@ -203,6 +213,7 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
     param.ctype = ccl_coll_allreduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -210,9 +221,12 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
     param.is_sycl_buf = sched->coll_attr.is_sycl_buf;
 #endif // CCL_ENABLE_SYCL
     param.hint_algo = sched->hint_algo;
+    param.is_regular_sched = sched->is_regular_partial() && !sched->coll_attr.prologue_fn;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_allreduce>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_allreduce_direct:
             CCL_CALL(ccl_coll_build_direct_allreduce(
@@ -230,6 +244,10 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
             CCL_CALL(ccl_coll_build_ring_allreduce(
                 sched, send_buf, recv_buf, count, dtype, reduction, comm));
             break;
+        case ccl_coll_allreduce_ring_pipelined:
+            CCL_CALL(ccl_coll_build_ring_pipelined_allreduce(
+                sched, send_buf, recv_buf, count, dtype, reduction, comm));
+            break;
         case ccl_coll_allreduce_ring_rma:
             CCL_CALL(ccl_coll_build_ring_rma_allreduce(
                 sched, send_buf, recv_buf, count, dtype, reduction, comm));
@@ -253,6 +271,10 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
             CCL_CALL(comm->get_allreduce_2d_builder()->build(
                 sched, send_buf, recv_buf, count, dtype, reduction));
             break;
+        case ccl_coll_allreduce_hierarchical:
+            CCL_CALL(comm->get_allreduce_hierarchical_builder()->build(
+                sched, send_buf, recv_buf, count, dtype, reduction));
+            break;
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
         case ccl_coll_allreduce_topo:
             CCL_CALL(ccl_coll_build_topo_allreduce(
@@ -284,6 +306,8 @@ ccl::status ccl_coll_build_alltoall(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_alltoall>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_alltoall_direct:
             CCL_CALL(ccl_coll_build_direct_alltoall(sched, send_buf, recv_buf, count, dtype, comm));
@@ -313,6 +337,8 @@ ccl::status ccl_coll_build_alltoallv(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_alltoallv>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_alltoallv_direct:
             CCL_CALL(ccl_coll_build_direct_alltoallv(
@@ -338,6 +364,8 @@ ccl::status ccl_coll_build_barrier(ccl_sched* sched, ccl_comm* comm) {
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_barrier>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_barrier_direct: CCL_CALL(ccl_coll_build_direct_barrier(sched, comm)); break;
         case ccl_coll_barrier_ring:
@@ -372,6 +400,8 @@ ccl::status ccl_coll_build_bcast(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_bcast>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_bcast_direct:
             CCL_CALL(ccl_coll_build_direct_bcast(sched, buf, count, dtype, root, comm));
@@ -422,6 +452,7 @@ ccl::status ccl_coll_build_reduce(ccl_sched* sched,
     param.ctype = ccl_coll_reduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -432,6 +463,8 @@ ccl::status ccl_coll_build_reduce(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_reduce>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_reduce_direct:
             CCL_CALL(ccl_coll_build_direct_reduce(
@@ -485,12 +518,15 @@ ccl::status ccl_coll_build_reduce_scatter(ccl_sched* sched,
     param.ctype = ccl_coll_reduce_scatter;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_reduce_scatter>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     switch (algo) {
         case ccl_coll_reduce_scatter_direct:
             if (!from_allreduce) {
@@ -595,6 +631,8 @@ ccl::status ccl_coll_build_sparse_allreduce(ccl_sched* sched,
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_sparse_allreduce>(param);
 
+    ccl_sched_set_algo_name(sched, ccl_coll_algorithm_to_str(algo));
+
     LOG_DEBUG("build sparse allreduce, param:",
               "\nsend_ind_buf ",
               send_ind_buf,
@@ -81,12 +81,12 @@ void ccl_check_usm_pointers(const ccl_coll_param& param) {
 #endif // CCL_ENABLE_SYCL
 
 void ccl_coll_validate_user_input(const ccl_coll_param& param, const ccl_coll_attr& attr) {
-    CCL_THROW_IF_NOT(ccl::global_data::env().atl_transport == ccl_atl_ofi || !(attr.reduction_fn),
-                     "custom reduction is supported for OFI transport only");
+    CCL_THROW_IF_NOT(ccl::global_data::env().atl_transport != ccl_atl_mpi || !(attr.reduction_fn),
+                     "custom reduction is not supported for MPI transport");
 
     CCL_THROW_IF_NOT(ccl_datatype_storage::is_predefined_datatype(param.dtype.idx()) ||
-                         ccl::global_data::env().atl_transport == ccl_atl_ofi,
-                     "custom datatype is supported for OFI transport only");
+                         ccl::global_data::env().atl_transport != ccl_atl_mpi,
+                     "custom datatype is not supported for MPI transport");
 
     CCL_THROW_IF_NOT((param.ctype != ccl_coll_allreduce && param.ctype != ccl_coll_reduce &&
                       param.ctype != ccl_coll_sparse_allreduce) ||
@@ -92,6 +92,10 @@ std::string ccl_coll_attr::to_string() const {
     }
 #endif // CCL_ENABLE_SYCL
 
+    if (hint_algo.has_value()) {
+        ss << ", hint_algo: " << hint_algo.value;
+    }
+
     ss << " }";
 
     return ss.str();
@@ -99,6 +103,8 @@ std::string ccl_coll_attr::to_string() const {
 
 ccl_coll_param::ccl_coll_param() {
     ctype = ccl_coll_last_value;
+    reduction = ccl::reduction::sum;
+    root = 0;
     send_bufs.reserve(1);
     recv_bufs.reserve(1);
     send_counts.reserve(1);
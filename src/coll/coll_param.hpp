@@ -86,6 +86,9 @@ struct ccl_coll_attr {
     ccl::sparse_allreduce_alloc_fn sparse_allreduce_alloc_fn = nullptr;
     const void* sparse_allreduce_fn_ctx = nullptr;
     ccl::sparse_coalesce_mode sparse_coalesce_mode = ccl::sparse_coalesce_mode::regular;
+
+    /* internal, algorithm to use if it is applicable, e.g. for tuning */
+    ccl_coll_algo hint_algo{};
 };
 
 struct ccl_coll_sparse_param {
@@ -16,6 +16,7 @@
 #include "coll/selection/selection.hpp"
 #include "common/comm/comm.hpp"
 #include "common/global/global.hpp"
+#include "comp/comp.hpp"
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 #include <CL/sycl/backend_types.hpp>
@@ -30,8 +31,14 @@ std::string to_string(const ccl_selector_param& param) {
        << "coll: " << ccl_coll_type_to_str(param.ctype) << ", count: " << param.count
        << ", dt: " << ccl::global_data::get().dtypes->name(param.dtype);
 
+    if (param.ctype == ccl_coll_allreduce || param.ctype == ccl_coll_reduce ||
+        param.ctype == ccl_coll_reduce_scatter) {
+        ss << ", reduction: " << ccl_reduction_to_str(param.reduction);
+    }
+
     if (param.comm) {
-        ss << ", comm: { rank: " << param.comm->rank() << ", size: " << param.comm->size() << " }";
+        ss << ", comm: { rank: " << param.comm->rank() << ", size: " << param.comm->size()
+           << ", local_size: " << param.comm->local_size() << " }";
     }
 
     if (param.stream) {
@@ -94,6 +101,12 @@ bool ccl_is_direct_algo(const ccl_selector_param& param) {
     return res;
 }
 
+bool ccl_is_hierarchical_algo(const ccl_selector_param& param) {
+    return (param.ctype == ccl_coll_allreduce) &&
+           (ccl::global_data::get().algorithm_selector->get<ccl_coll_allreduce>(param) ==
+            ccl_coll_allreduce_hierarchical);
+}
+
 namespace checkers {
 
 bool is_family1_card(const ccl_selector_param& param) {
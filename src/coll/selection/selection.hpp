@@ -19,6 +19,7 @@
 
 bool ccl_is_direct_algo(const ccl_selector_param& param);
 bool ccl_is_device_side_algo(const ccl_selector_param& param);
+bool ccl_is_hierarchical_algo(const ccl_selector_param& param);
 
 bool ccl_can_use_topo_algo(const ccl_selector_param& param);
 
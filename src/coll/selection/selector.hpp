@@ -17,10 +17,12 @@
 
 #include "coll/algorithms/algorithms.hpp"
 #include "coll/coll.hpp"
+#include "coll/selection/selector_rule.hpp"
 #include "common/global/global.hpp"
 
 #include <map>
 #include <string>
+#include <vector>
 
 #define CCL_ALLGATHERV_SHORT_MSG_SIZE 32768
 #define CCL_ALLREDUCE_SHORT_MSG_SIZE  8192
@@ -39,6 +41,7 @@ struct ccl_selector_param {
     ccl_coll_type ctype = ccl_coll_last_value;
     size_t count = 0;
     ccl_datatype dtype = ccl_datatype_int8;
+    ccl::reduction reduction = ccl::reduction::sum;
     ccl_comm* comm = nullptr;
     ccl_stream* stream = nullptr;
     void* buf = nullptr;
@@ -53,6 +56,12 @@ struct ccl_selector_param {
 
     ccl_coll_algo hint_algo = {};
 
+    /*
+       schedule is partial one of regular master schedule (see ccl_sched::is_regular_partial),
+       algorithms bound to start order of schedules can't be used in nested and fused ones
+    */
+    int is_regular_sched = 0;
+
     /* tmp fields to avoid selection of algorithms which don't support all coalesce modes or alloc_fn */
     ccl::sparse_coalesce_mode sparse_coalesce_mode;
     ccl::sparse_allreduce_alloc_fn sparse_allreduce_alloc_fn;
@@ -68,15 +77,33 @@ using ccl_selection_table_t =
 template <typename algo_group_type>
 using ccl_selection_table_iter_t = typename ccl_selection_table_t<algo_group_type>::const_iterator;
 
+/* main table for collectives which match filter, may cover only part of message sizes */
+template <typename algo_group_type>
+struct ccl_selection_rule {
+    ccl_selection_rule_filter filter;
+    ccl_selection_table_t<algo_group_type> table;
+};
+
 #define CCL_SELECTION_DECLARE_ALGO_SELECTOR_BASE() \
     template <typename algo_group_type> \
     struct ccl_algorithm_selector_base { \
         ccl_selection_table_t<algo_group_type> main_table{}; \
         ccl_selection_table_t<algo_group_type> fallback_table{}; \
+        std::vector<ccl_selection_rule<algo_group_type>> rules{}; \
+        ccl_selection_rule_index rule_index{}; \
         ccl_algorithm_selector_base(){}; \
         void init(); \
+        void update(const std::string& str); \
+        void parse(const std::string& str); \
+        void check() const; \
+        void check_table(const ccl_selection_table_t<algo_group_type>& table, \
+                         bool is_full_range) const; \
+        void build_rule_index(); \
         void print() const; \
         algo_group_type get(const ccl_selector_param& param) const; \
+        const ccl_selection_table_t<algo_group_type>& get_main_table( \
+            const ccl_selector_param& param, \
+            size_t size) const; \
         void insert(ccl_selection_table_t<algo_group_type>& table, \
                     size_t left, \
                     size_t right, \
@@ -29,7 +29,7 @@ std::map<ccl_coll_allgatherv_algo, std::string>
     };
 
 ccl_algorithm_selector<ccl_coll_allgatherv>::ccl_algorithm_selector() {
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLGATHERV_SHORT_MSG_SIZE, ccl_coll_allgatherv_naive);
         insert(main_table,
                CCL_ALLGATHERV_SHORT_MSG_SIZE + 1,
@@ -62,7 +62,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_allgatherv_algo>::can_use(
         can_use = false;
     }
     else if (algo == ccl_coll_allgatherv_direct &&
-             ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+             ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         can_use = false;
     }
 
@@ -23,16 +23,18 @@ std::map<ccl_coll_allreduce_algo, std::string>
         std::make_pair(ccl_coll_allreduce_nreduce, "nreduce"),
         std::make_pair(ccl_coll_allreduce_ring, "ring"),
         std::make_pair(ccl_coll_allreduce_ring_rma, "ring_rma"),
+        std::make_pair(ccl_coll_allreduce_ring_pipelined, "ring_pipelined"),
         std::make_pair(ccl_coll_allreduce_double_tree, "double_tree"),
         std::make_pair(ccl_coll_allreduce_recursive_doubling, "recursive_doubling"),
         std::make_pair(ccl_coll_allreduce_2d, "2d"),
+        std::make_pair(ccl_coll_allreduce_hierarchical, "hierarchical"),
         std::make_pair(ccl_coll_allreduce_topo, "topo"),
     };
 
 ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_topo);
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
         insert(
             fallback_table, 0, CCL_ALLREDUCE_SHORT_MSG_SIZE, ccl_coll_allreduce_recursive_doubling);
@@ -41,7 +43,7 @@ ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
         insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_direct);
     }
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
         insert(main_table, 0, CCL_ALLREDUCE_SHORT_MSG_SIZE, ccl_coll_allreduce_recursive_doubling);
         insert(main_table,
@@ -79,8 +81,13 @@ bool ccl_algorithm_selector_helper<ccl_coll_allreduce_algo>::can_use(
     else if (algo == ccl_coll_allreduce_2d &&
              (ccl::global_data::env().atl_transport == ccl_atl_mpi))
         can_use = false;
+    else if (algo == ccl_coll_allreduce_hierarchical &&
+             (!param.is_regular_sched || param.stream ||
+              !param.comm->get_allreduce_hierarchical_builder() ||
+              !param.comm->get_allreduce_hierarchical_builder()->is_enabled()))
+        can_use = false;
     else if (algo == ccl_coll_allreduce_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
     else if (algo == ccl_coll_allreduce_topo && !ccl_can_use_topo_algo(param))
         can_use = false;
@@ -25,7 +25,7 @@ std::map<ccl_coll_alltoall_algo, std::string>
     };
 
 ccl_algorithm_selector<ccl_coll_alltoall>::ccl_algorithm_selector() {
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoall_scatter);
     }
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
@@ -47,7 +47,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoall_algo>::can_use(
     const ccl_selection_table_t<ccl_coll_alltoall_algo>& table) {
     bool can_use = true;
 
-    if (algo == ccl_coll_alltoall_direct && (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+    if (algo == ccl_coll_alltoall_direct && (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
 
     return can_use;
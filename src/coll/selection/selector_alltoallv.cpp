@@ -25,7 +25,7 @@ std::map<ccl_coll_alltoallv_algo, std::string>
     };
 
 ccl_algorithm_selector<ccl_coll_alltoallv>::ccl_algorithm_selector() {
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoallv_scatter);
     }
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
@@ -50,7 +50,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoallv_algo>::can_use(
     if (param.is_vector_buf && algo != ccl_coll_alltoallv_scatter_barrier)
         can_use = false;
     else if (algo == ccl_coll_alltoallv_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
 
     return can_use;
@@ -29,7 +29,7 @@ ccl_algorithm_selector<ccl_coll_bcast>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_naive);
         insert(main_table, 0, CCL_BCAST_SHORT_MSG_SIZE, ccl_coll_bcast_double_tree);
     }
@@ -57,7 +57,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_bcast_algo>::can_use(
         can_use = false;
     }
     else if (algo == ccl_coll_bcast_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi)) {
         can_use = false;
     }
     else if (algo == ccl_coll_bcast_topo && !ccl_can_use_topo_algo(param)) {
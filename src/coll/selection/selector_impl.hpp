@@ -16,8 +16,10 @@
 #pragma once
 
 #include "coll/selection/selector_helper.hpp"
+#include "common/comm/comm.hpp"
 #include "exec/exec.hpp"
 
+#include <algorithm>
 #include <set>
 #include <sstream>
 #include <string>
@@ -53,13 +55,19 @@ void ccl_selection_unpack_elem(size_t& size,
 
 template <typename algo_group_type>
 void ccl_algorithm_selector_base<algo_group_type>::init() {
-    const std::string& str_to_parse =
-        ccl_algorithm_selector_helper<algo_group_type>::get_str_to_parse();
+    parse(ccl_algorithm_selector_helper<algo_group_type>::get_str_to_parse());
+    check();
+}
 
-    size_t elem_size;
-    algo_group_type elem_algo;
-    ccl_selection_border_type elem_border;
+template <typename algo_group_type>
+void ccl_algorithm_selector_base<algo_group_type>::update(const std::string& str) {
+    parse(str);
+    check();
+    print();
+}
 
+template <typename algo_group_type>
+void ccl_algorithm_selector_base<algo_group_type>::parse(const std::string& str_to_parse) {
     std::string block;
     std::string algo_name_str;
     std::string size_str;
@@ -67,11 +75,49 @@ void ccl_algorithm_selector_base<algo_group_type>::init() {
     std::stringstream block_stream;
     size_t left_size, right_size;
 
-    /* format: <algo>:<size1-size2>;<algo>:<size1-size2>; ... */
+    /*
+       format: <algo>:<size1-size2>;<algo>:<size1-size2>; ...
+       block may start with rule filter, e.g. [comm_size:2-8,dtype:bfloat16]<algo>:<size1-size2>,
+       it applies to this and following blocks until next filter, empty filter [] resets to main table
+    */
+
+    ccl_selection_table_t<algo_group_type>* table = &main_table;
 
     full_stream.str(str_to_parse);
     while (std::getline(full_stream, block, CCL_SELECTION_BLOCK_DELIMETER)) {
         LOG_TRACE(block);
+
+        if (!block.empty() && block.front() == CCL_SELECTION_RULE_BEGIN) {
+            size_t filter_end = block.find(CCL_SELECTION_RULE_END);
+            CCL_THROW_IF_NOT(filter_end != std::string::npos,
+                             "can not parse rule filter from string: ",
+                             str_to_parse,
+                             ", block: ",
+                             block);
+
+            auto filter = ccl_selection_rule_filter::from_string(block.substr(0, filter_end + 1));
+            block = block.substr(filter_end + 1);
+
+            if (filter.is_empty()) {
+                table = &main_table;
+            }
+            else {
+                auto rule = std::find_if(rules.begin(),
+                                         rules.end(),
+                                         [&filter](const ccl_selection_rule<algo_group_type>& r) {
+                                             return r.filter == filter;
+                                         });
+                if (rule == rules.end()) {
+                    rules.push_back({ filter, {} });
+                    rule = std::prev(rules.end());
+                }
+                table = &rule->table;
+            }
+
+            if (block.empty())
+                continue;
+        }
+
         block_stream.str(block);
         try {
             if (!std::getline(block_stream, algo_name_str, CCL_SELECTION_ALGO_DELIMETER))
@@ -98,8 +144,8 @@ void ccl_algorithm_selector_base<algo_group_type>::init() {
 
         if (algo_name_str.length() == block.length()) {
             /* set the single algorithm for the whole range */
-            main_table.clear();
-            insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, algo);
+            table->clear();
+            insert(*table, 0, CCL_SELECTION_MAX_COLL_SIZE, algo);
         }
         else {
             try {
@@ -145,50 +191,78 @@ void ccl_algorithm_selector_base<algo_group_type>::init() {
                              right_size,
                              ")");
 
-            insert(main_table, left_size, right_size, algo);
+            insert(*table, left_size, right_size, algo);
         }
         block_stream.clear();
     }
 
-    auto tables_to_check =
-        std::vector<const ccl_selection_table_t<algo_group_type>*>{ &main_table, &fallback_table };
+    build_rule_index();
+}
 
-    for (const auto& table : tables_to_check) {
-        CCL_THROW_IF_NOT(table->size() >= 2, "selection table should have at least 2 entries");
+template <typename algo_group_type>
+void ccl_algorithm_selector_base<algo_group_type>::check() const {
+    check_table(main_table, true);
+    check_table(fallback_table, true);
+    for (const auto& rule : rules) {
+        check_table(rule.table, false);
+    }
+}
+
+template <typename algo_group_type>
+void ccl_algorithm_selector_base<algo_group_type>::check_table(
+    const ccl_selection_table_t<algo_group_type>& table,
+    bool is_full_range) const {
+    size_t elem_size;
+    algo_group_type elem_algo;
+    ccl_selection_border_type elem_border;
+
+    if (is_full_range) {
+        CCL_THROW_IF_NOT(table.size() >= 2, "selection table should have at least 2 entries");
 
         /* ensure that table has entries with size_t::max as key, i.e. able to cover all message sizes */
-        CCL_THROW_IF_NOT(table->find(0) != table->end() &&
-                             table->find(CCL_SELECTION_MAX_COLL_SIZE) != table->end(),
+        CCL_THROW_IF_NOT(table.find(0) != table.end() &&
+                             table.find(CCL_SELECTION_MAX_COLL_SIZE) != table.end(),
                          "selection table should have entries for min and max message sizes");
+    }
 
-        /* check that table has expected left/right/both borders */
-        std::set<ccl_selection_border_type> expected_left_and_both{ ccl_selection_border_left,
-                                                                    ccl_selection_border_both };
-        std::set<ccl_selection_border_type> expected_right{ ccl_selection_border_right };
-
-        std::set<ccl_selection_border_type> expected_set = expected_left_and_both;
-        for (const auto& elem : *table) {
-            elem_size = elem.first;
-            elem_algo = elem.second.first;
-            elem_border = elem.second.second;
-
-            if (expected_set.find(elem_border) == expected_set.end()) {
-                print();
-                CCL_THROW("unexpected elem in table: size ",
-                          elem_size,
-                          ", algo ",
-                          ccl_coll_algorithm_to_str(elem_algo),
-                          ", border_type ",
-                          elem_border);
-            }
-            if (elem_border == ccl_selection_border_left)
-                expected_set = expected_right;
-            else if (elem_border == ccl_selection_border_right)
-                expected_set = expected_left_and_both;
-            else if (elem_border == ccl_selection_border_both)
-                expected_set = expected_left_and_both;
+    /* check that table has expected left/right/both borders */
+    std::set<ccl_selection_border_type> expected_left_and_both{ ccl_selection_border_left,
+                                                                ccl_selection_border_both };
+    std::set<ccl_selection_border_type> expected_right{ ccl_selection_border_right };
+
+    std::set<ccl_selection_border_type> expected_set = expected_left_and_both;
+    for (const auto& elem : table) {
+        elem_size = elem.first;
+        elem_algo = elem.second.first;
+        elem_border = elem.second.second;
+
+        if (expected_set.find(elem_border) == expected_set.end()) {
+            print();
+            CCL_THROW("unexpected elem in table: size ",
+                      elem_size,
+                      ", algo ",
+                      ccl_coll_algorithm_to_str(elem_algo),
+                      ", border_type ",
+                      elem_border);
         }
+        if (elem_border == ccl_selection_border_left)
+            expected_set = expected_right;
+        else if (elem_border == ccl_selection_border_right)
+            expected_set = expected_left_and_both;
+        else if (elem_border == ccl_selection_border_both)
+            expected_set = expected_left_and_both;
     }
+    CCL_THROW_IF_NOT(expected_set != expected_right, "selection table has unclosed range");
+}
+
+template <typename algo_group_type>
+void ccl_algorithm_selector_base<algo_group_type>::build_rule_index() {
+    std::vector<const ccl_selection_rule_filter*> filters;
+    filters.reserve(rules.size());
+    for (const auto& rule : rules) {
+        filters.push_back(&rule.filter);
+    }
+    rule_index.build(filters);
 }
 
 template <typename algo_group_type>
@@ -198,15 +272,21 @@ void ccl_algorithm_selector_base<algo_group_type>::print() const {
     ccl_selection_border_type elem_border;
 
     std::stringstream str;
-    auto tables_to_print =
-        std::vector<const ccl_selection_table_t<algo_group_type>*>{ &main_table, &fallback_table };
+    std::vector<std::pair<std::string, const ccl_selection_table_t<algo_group_type>*>>
+        tables_to_print;
+    for (const auto& rule : rules) {
+        tables_to_print.emplace_back("rule " + rule.filter.to_string(), &rule.table);
+    }
+    tables_to_print.emplace_back("main table", &main_table);
+    tables_to_print.emplace_back("fallback table", &fallback_table);
 
     str << std::endl
         << ccl_coll_type_to_str(ccl_algorithm_selector_helper<algo_group_type>::get_coll_id())
         << " selection" << std::endl;
 
-    for (const auto& table : tables_to_print) {
-        const std::string& table_name = (table == &main_table) ? "main table" : "fallback table";
+    for (const auto& table_to_print : tables_to_print) {
+        const std::string& table_name = table_to_print.first;
+        const auto& table = table_to_print.second;
 
         str << "  " << table_name << std::endl;
 
@@ -273,11 +353,12 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
     }
 
     size_t size = count * param.dtype.size();
-    auto lower_bound = main_table.lower_bound(size);
-    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, main_table);
+    const auto& table = get_main_table(param, size);
+    auto lower_bound = table.lower_bound(size);
+    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, table);
 
-    if (lower_bound == main_table.end() ||
-        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, main_table)) {
+    if (lower_bound == table.end() ||
+        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, table)) {
         CCL_THROW_IF_NOT(ccl::global_data::env().enable_algo_fallback,
                          "can not select algo from main table and fallback is disabled",
                          ", coll ",
@@ -308,6 +389,29 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
     return elem_algo;
 }
 
+template <typename algo_group_type>
+const ccl_selection_table_t<algo_group_type>& ccl_algorithm_selector_base<
+    algo_group_type>::get_main_table(const ccl_selector_param& param, size_t size) const {
+    if (rules.empty() || !param.comm)
+        return main_table;
+
+    /* rule tables may be sparse, pick the latest matching rule which covers the size */
+    for (size_t rule_idx : rule_index.get(param.comm->size(), param.comm->local_size())) {
+        const auto& rule = rules[rule_idx];
+        if (!rule.filter.match(param))
+            continue;
+
+        auto it = rule.table.lower_bound(size);
+        if (it != rule.table.end() &&
+            (it->first == size || it->second.second == ccl_selection_border_right)) {
+            LOG_DEBUG("use selection rule ", rule.filter.to_string());
+            return rule.table;
+        }
+    }
+
+    return main_table;
+}
+
 template <typename algo_group_type>
 void ccl_algorithm_selector_base<algo_group_type>::insert(
     ccl_selection_table_t<algo_group_type>& table,
@@ -29,7 +29,7 @@ ccl_algorithm_selector<ccl_coll_reduce>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_tree);
     }
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
@@ -54,7 +54,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_reduce_algo>::can_use(
     if (algo == ccl_coll_reduce_rabenseifner && (int)param.count < param.comm->pof2())
         can_use = false;
     else if (algo == ccl_coll_reduce_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
     else if (algo == ccl_coll_reduce_topo && !ccl_can_use_topo_algo(param))
         can_use = false;
@@ -24,7 +24,7 @@ std::map<ccl_coll_reduce_scatter_algo, std::string>
     };
 
 ccl_algorithm_selector<ccl_coll_reduce_scatter>::ccl_algorithm_selector() {
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi)
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi)
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_ring);
     else if (ccl::global_data::env().atl_transport == ccl_atl_mpi)
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_reduce_scatter_direct);
@@ -43,7 +43,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_reduce_scatter_algo>::can_use(
         can_use = false;
     }
     else if (algo == ccl_coll_reduce_scatter_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
 
     return can_use;
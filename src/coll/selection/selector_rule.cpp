@@ -0,0 +1,235 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "coll/selection/selector.hpp"
+#include "coll/selection/selector_rule.hpp"
+#include "comp/comp.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+void parse_size_range(const std::string& str, size_t& left, size_t& right) {
+    size_t pos = str.find(CCL_SELECTION_SIZE_DELIMETER);
+    CCL_THROW_IF_NOT(pos != std::string::npos, "can not parse size range from string: ", str);
+
+    auto parse_size = [&str](const std::string& size_str) {
+        if (!size_str.compare(CCL_SELECTION_MAX_COLL_SIZE_STR))
+            return CCL_SELECTION_MAX_COLL_SIZE;
+        CCL_THROW_IF_NOT(!size_str.empty() &&
+                             size_str.find_first_not_of("0123456789") == std::string::npos,
+                         "can not parse size from string: ",
+                         str);
+        return static_cast<size_t>(std::strtoul(size_str.c_str(), nullptr, 10));
+    };
+
+    left = parse_size(str.substr(0, pos));
+    right = parse_size(str.substr(pos + 1));
+
+    CCL_THROW_IF_NOT(left <= right,
+                     "left border should be less or equal to right border (",
+                     left,
+                     ", ",
+                     right,
+                     ")");
+}
+
+std::string size_range_to_string(size_t left, size_t right) {
+    std::stringstream ss;
+    ss << left << CCL_SELECTION_SIZE_DELIMETER
+       << ((right == CCL_SELECTION_MAX_COLL_SIZE) ? CCL_SELECTION_MAX_COLL_SIZE_STR
+                                                  : std::to_string(right));
+    return ss.str();
+}
+
+void add_borders(std::vector<size_t>& borders, size_t left, size_t right) {
+    borders.push_back(left);
+    if (right != CCL_SELECTION_MAX_COLL_SIZE)
+        borders.push_back(right + 1);
+}
+
+void finalize_borders(std::vector<size_t>& borders) {
+    borders.push_back(0);
+    std::sort(borders.begin(), borders.end());
+    borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+}
+
+size_t find_cell(const std::vector<size_t>& borders, size_t value) {
+    /* borders[0] is always 0 so result is valid */
+    return std::upper_bound(borders.begin(), borders.end(), value) - borders.begin() - 1;
+}
+
+} // namespace
+
+bool ccl_selection_rule_filter::is_empty() const {
+    return *this == ccl_selection_rule_filter();
+}
+
+bool ccl_selection_rule_filter::match(const ccl_selector_param& param) const {
+    if (has_dtype && param.dtype != dtype)
+        return false;
+    if (has_reduction && param.reduction != reduction)
+        return false;
+    return true;
+}
+
+std::string ccl_selection_rule_filter::to_string() const {
+    std::stringstream ss;
+    std::string delim;
+
+    ss << CCL_SELECTION_RULE_BEGIN;
+    if (comm_size_left != 0 || comm_size_right != CCL_SELECTION_MAX_COLL_SIZE) {
+        ss << delim << "comm_size" << CCL_SELECTION_ALGO_DELIMETER
+           << size_range_to_string(comm_size_left, comm_size_right);
+        delim = CCL_SELECTION_RULE_FIELD_DELIMETER;
+    }
+    if (local_size_left != 0 || local_size_right != CCL_SELECTION_MAX_COLL_SIZE) {
+        ss << delim << "local_size" << CCL_SELECTION_ALGO_DELIMETER
+           << size_range_to_string(local_size_left, local_size_right);
+        delim = CCL_SELECTION_RULE_FIELD_DELIMETER;
+    }
+    if (has_dtype) {
+        ss << delim << "dtype" << CCL_SELECTION_ALGO_DELIMETER
+           << ccl::global_data::get().dtypes->name(dtype);
+        delim = CCL_SELECTION_RULE_FIELD_DELIMETER;
+    }
+    if (has_reduction) {
+        ss << delim << "reduction" << CCL_SELECTION_ALGO_DELIMETER
+           << ccl_reduction_to_str(reduction);
+    }
+    ss << CCL_SELECTION_RULE_END;
+
+    return ss.str();
+}
+
+ccl_selection_rule_filter ccl_selection_rule_filter::from_string(const std::string& str) {
+    ccl_selection_rule_filter filter;
+
+    CCL_THROW_IF_NOT(str.size() >= 2 && str.front() == CCL_SELECTION_RULE_BEGIN &&
+                         str.back() == CCL_SELECTION_RULE_END,
+                     "unexpected rule filter: ",
+                     str);
+
+    std::string field;
+    std::stringstream stream(str.substr(1, str.size() - 2));
+
+    while (std::getline(stream, field, CCL_SELECTION_RULE_FIELD_DELIMETER)) {
+        size_t pos = field.find(CCL_SELECTION_ALGO_DELIMETER);
+        CCL_THROW_IF_NOT(pos != std::string::npos,
+                         "can not parse rule field '",
+                         field,
+                         "' from filter: ",
+                         str);
+
+        std::string name = field.substr(0, pos);
+        std::string value = field.substr(pos + 1);
+
+        if (name == "comm_size") {
+            parse_size_range(value, filter.comm_size_left, filter.comm_size_right);
+        }
+        else if (name == "local_size") {
+            parse_size_range(value, filter.local_size_left, filter.local_size_right);
+        }
+        else if (name == "dtype") {
+            for (ccl::datatype idx = ccl::datatype::int8; idx <= ccl::datatype::bfloat16; idx++) {
+                if (value == ccl::global_data::get().dtypes->name(idx)) {
+                    filter.dtype = idx;
+                    filter.has_dtype = true;
+                    break;
+                }
+            }
+            CCL_THROW_IF_NOT(filter.has_dtype, "unknown dtype '", value, "' in filter: ", str);
+        }
+        else if (name == "reduction") {
+            for (auto reduction : { ccl::reduction::sum,
+                                    ccl::reduction::prod,
+                                    ccl::reduction::min,
+                                    ccl::reduction::max }) {
+                if (value == ccl_reduction_to_str(reduction)) {
+                    filter.reduction = reduction;
+                    filter.has_reduction = true;
+                    break;
+                }
+            }
+            CCL_THROW_IF_NOT(
+                filter.has_reduction, "unknown reduction '", value, "' in filter: ", str);
+        }
+        else {
+            CCL_THROW("unknown rule field '",
+                      name,
+                      "' in filter: ",
+                      str,
+                      ", expected comm_size, local_size, dtype or reduction");
+        }
+    }
+
+    return filter;
+}
+
+bool operator==(const ccl_selection_rule_filter& lhs, const ccl_selection_rule_filter& rhs) {
+    return (lhs.comm_size_left == rhs.comm_size_left) &&
+           (lhs.comm_size_right == rhs.comm_size_right) &&
+           (lhs.local_size_left == rhs.local_size_left) &&
+           (lhs.local_size_right == rhs.local_size_right) && (lhs.has_dtype == rhs.has_dtype) &&
+           (!lhs.has_dtype || lhs.dtype == rhs.dtype) &&
+           (lhs.has_reduction == rhs.has_reduction) &&
+           (!lhs.has_reduction || lhs.reduction == rhs.reduction);
+}
+
+void ccl_selection_rule_index::build(const std::vector<const ccl_selection_rule_filter*>& filters) {
+    comm_size_borders.clear();
+    local_size_borders.clear();
+    cells.clear();
+
+    if (filters.empty())
+        return;
+
+    for (const auto filter : filters) {
+        add_borders(comm_size_borders, filter->comm_size_left, filter->comm_size_right);
+        add_borders(local_size_borders, filter->local_size_left, filter->local_size_right);
+    }
+    finalize_borders(comm_size_borders);
+    finalize_borders(local_size_borders);
+
+    /* borders include edges of all filters so each cell is either fully covered by filter or not */
+    cells.resize(comm_size_borders.size() * local_size_borders.size());
+    for (size_t comm_idx = 0; comm_idx < comm_size_borders.size(); comm_idx++) {
+        size_t comm_size = comm_size_borders[comm_idx];
+        for (size_t local_idx = 0; local_idx < local_size_borders.size(); local_idx++) {
+            size_t local_size = local_size_borders[local_idx];
+            auto& cell = cells[comm_idx * local_size_borders.size() + local_idx];
+            for (size_t idx = filters.size(); idx > 0; idx--) {
+                const auto filter = filters[idx - 1];
+                if (comm_size >= filter->comm_size_left && comm_size <= filter->comm_size_right &&
+                    local_size >= filter->local_size_left &&
+                    local_size <= filter->local_size_right) {
+                    cell.push_back(idx - 1);
+                }
+            }
+        }
+    }
+}
+
+const std::vector<size_t>& ccl_selection_rule_index::get(size_t comm_size,
+                                                         size_t local_size) const {
+    if (cells.empty())
+        return empty_cell;
+
+    size_t comm_idx = find_cell(comm_size_borders, comm_size);
+    size_t local_idx = find_cell(local_size_borders, local_size);
+
+    return cells[comm_idx * local_size_borders.size() + local_idx];
+}
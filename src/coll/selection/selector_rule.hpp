@@ -0,0 +1,75 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "oneapi/ccl/types.hpp"
+
+struct ccl_selector_param;
+
+#define CCL_SELECTION_RULE_BEGIN           '['
+#define CCL_SELECTION_RULE_END             ']'
+#define CCL_SELECTION_RULE_FIELD_DELIMETER ','
+
+/*
+   restricts selection table to subset of collectives,
+   format: [comm_size:<size1-size2>,local_size:<size1-size2>,dtype:<name>,reduction:<name>]
+   all fields are optional, empty filter matches all collectives
+*/
+struct ccl_selection_rule_filter {
+    size_t comm_size_left = 0;
+    size_t comm_size_right = std::numeric_limits<size_t>::max();
+    size_t local_size_left = 0;
+    size_t local_size_right = std::numeric_limits<size_t>::max();
+
+    bool has_dtype = false;
+    ccl::datatype dtype = ccl::datatype::int8;
+
+    bool has_reduction = false;
+    ccl::reduction reduction = ccl::reduction::sum;
+
+    bool is_empty() const;
+
+    /* checks only dtype and reduction, sizes are handled by ccl_selection_rule_index */
+    bool match(const ccl_selector_param& param) const;
+
+    std::string to_string() const;
+
+    static ccl_selection_rule_filter from_string(const std::string& str);
+};
+
+bool operator==(const ccl_selection_rule_filter& lhs, const ccl_selection_rule_filter& rhs);
+
+/*
+   splits (comm_size x local_size) space into cells using borders of all filters,
+   each cell keeps rules which cover it, so lookup is two binary searches
+*/
+class ccl_selection_rule_index {
+public:
+    void build(const std::vector<const ccl_selection_rule_filter*>& filters);
+
+    /* returns indexes of matching rules, most recently defined first */
+    const std::vector<size_t>& get(size_t comm_size, size_t local_size) const;
+
+private:
+    std::vector<size_t> comm_size_borders;
+    std::vector<size_t> local_size_borders;
+    std::vector<std::vector<size_t>> cells;
+    const std::vector<size_t> empty_cell{};
+};
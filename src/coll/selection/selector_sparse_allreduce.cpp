@@ -20,11 +20,12 @@ std::map<ccl_coll_sparse_allreduce_algo, std::string>
     ccl_algorithm_selector_helper<ccl_coll_sparse_allreduce_algo>::algo_names = {
         std::make_pair(ccl_coll_sparse_allreduce_ring, "ring"),
         std::make_pair(ccl_coll_sparse_allreduce_mask, "mask"),
-        std::make_pair(ccl_coll_sparse_allreduce_3_allgatherv, "allgatherv")
+        std::make_pair(ccl_coll_sparse_allreduce_3_allgatherv, "allgatherv"),
+        std::make_pair(ccl_coll_sparse_allreduce_sharded, "sharded")
     };
 
 ccl_algorithm_selector<ccl_coll_sparse_allreduce>::ccl_algorithm_selector() {
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_sparse_allreduce_3_allgatherv);
         insert(
             fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_sparse_allreduce_3_allgatherv);
@@ -55,7 +56,8 @@ bool ccl_algorithm_selector_helper<ccl_coll_sparse_allreduce_algo>::can_use(
              algo != ccl_coll_sparse_allreduce_3_allgatherv) {
         can_use = false;
     }
-    else if (param.sparse_allreduce_alloc_fn && algo != ccl_coll_sparse_allreduce_3_allgatherv) {
+    else if (param.sparse_allreduce_alloc_fn && algo != ccl_coll_sparse_allreduce_3_allgatherv &&
+             algo != ccl_coll_sparse_allreduce_sharded) {
         can_use = false;
     }
 
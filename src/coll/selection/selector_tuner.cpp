@@ -0,0 +1,367 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "coll/coll.hpp"
+#include "coll/selection/selection.hpp"
+#include "coll/selection/selector_tuner.hpp"
+#include "common/comm/comm.hpp"
+#include "common/global/global.hpp"
+
+std::string ccl_algorithm_tuner::get_key(ccl_comm* comm) {
+    std::stringstream ss;
+    ss << "comm_size:" << comm->size() << ",local_size:" << comm->local_size()
+       << ",transport:"
+       << ccl::env_data::str_by_enum(ccl::env_data::atl_transport_names,
+                                     ccl::global_data::env().atl_transport);
+    return ss.str();
+}
+
+bool ccl_algorithm_tuner::load(const std::string& key, coll_tables_t& tables) const {
+    const std::string& file_name = ccl::global_data::env().tuning_file;
+    if (file_name.empty())
+        return false;
+
+    std::ifstream file(file_name);
+    if (!file.is_open()) {
+        LOG_DEBUG("can not open tuning file ", file_name);
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::stringstream line_stream(line);
+        std::string line_key, coll_name, table;
+        if (!(line_stream >> line_key >> coll_name >> table)) {
+            if (!line.empty())
+                LOG_WARN("unexpected line in tuning file ", file_name, ": ", line);
+            continue;
+        }
+
+        if (line_key != key)
+            continue;
+
+        for (int coll_type = ccl_coll_allgatherv; coll_type <= ccl_coll_last_regular;
+             coll_type++) {
+            if (coll_name == ccl_coll_type_to_str(static_cast<ccl_coll_type>(coll_type))) {
+                tables[static_cast<ccl_coll_type>(coll_type)] = table;
+            }
+        }
+    }
+
+    LOG_DEBUG("loaded ", tables.size(), " tables for key ", key, " from ", file_name);
+
+    return !tables.empty();
+}
+
+void ccl_algorithm_tuner::store(const std::string& key, const coll_tables_t& tables) const {
+    const std::string& file_name = ccl::global_data::env().tuning_file;
+    if (file_name.empty())
+        return;
+
+    std::ofstream file(file_name, std::ios::app);
+    if (!file.is_open()) {
+        LOG_WARN("can not open tuning file ", file_name, " for writing");
+        return;
+    }
+
+    for (const auto& table : tables) {
+        file << key << " " << ccl_coll_type_to_str(table.first) << " " << table.second << "\n";
+    }
+
+    LOG_INFO("stored tuning results for ", key, " to ", file_name);
+}
+
+void ccl_algorithm_tuner::apply(const coll_tables_t& tables) const {
+    const auto& env = ccl::global_data::env();
+
+    /* explicit CCL_<COLL> has priority over tuning results */
+    std::map<ccl_coll_type, const std::string*> env_tables = {
+        { ccl_coll_allgatherv, &env.allgatherv_algo_raw },
+        { ccl_coll_allreduce, &env.allreduce_algo_raw },
+        { ccl_coll_alltoall, &env.alltoall_algo_raw },
+        { ccl_coll_bcast, &env.bcast_algo_raw },
+        { ccl_coll_reduce, &env.reduce_algo_raw },
+        { ccl_coll_reduce_scatter, &env.reduce_scatter_algo_raw }
+    };
+
+    for (const auto& table : tables) {
+        auto it = env_tables.find(table.first);
+        if (it == env_tables.end() || !it->second->empty()) {
+            LOG_DEBUG("skip tuning results for ", ccl_coll_type_to_str(table.first));
+            continue;
+        }
+        LOG_DEBUG(
+            "apply tuning results for ", ccl_coll_type_to_str(table.first), ": ", table.second);
+        ccl::global_data::get().algorithm_selector->update(table.first, table.second);
+    }
+}
+
+double ccl_algorithm_tuner::run(ccl_comm* comm,
+                                std::vector<float>& send_buf,
+                                std::vector<float>& recv_buf,
+                                ccl_coll_type coll_type,
+                                ccl_coll_algo algo,
+                                size_t count) {
+    size_t comm_size = comm->size();
+    size_t bytes = count * sizeof(float);
+    size_t iters =
+        std::max(size_t(CCL_TUNING_MIN_ITERS),
+                 std::min(size_t(CCL_TUNING_MAX_ITERS), size_t(CCL_TUNING_BYTES_PER_SIZE) / bytes));
+
+    ccl_coll_attr attr{};
+    attr.synchronous = 1;
+    attr.hint_algo = algo;
+
+    const ccl::datatype dtype = ccl::datatype::float32;
+    std::vector<size_t> recv_counts(comm_size, count);
+    void* sbuf = send_buf.data();
+    void* rbuf = recv_buf.data();
+
+    auto run_once = [&]() {
+        switch (coll_type) {
+            case ccl_coll_allgatherv:
+                ccl_allgatherv_impl(
+                    sbuf, count, rbuf, recv_counts.data(), dtype, attr, comm, nullptr, {});
+                break;
+            case ccl_coll_allreduce:
+                ccl_allreduce_impl(
+                    sbuf, rbuf, count, dtype, ccl::reduction::sum, attr, comm, nullptr, {});
+                break;
+            case ccl_coll_alltoall:
+                ccl_alltoall_impl(sbuf, rbuf, count, dtype, attr, comm, nullptr, {});
+                break;
+            case ccl_coll_bcast:
+                ccl_broadcast_impl(rbuf, count, dtype, 0, attr, comm, nullptr, {});
+                break;
+            case ccl_coll_reduce:
+                ccl_reduce_impl(
+                    sbuf, rbuf, count, dtype, ccl::reduction::sum, 0, attr, comm, nullptr, {});
+                break;
+            case ccl_coll_reduce_scatter:
+                ccl_reduce_scatter_impl(
+                    sbuf, rbuf, count, dtype, ccl::reduction::sum, attr, comm, nullptr, {});
+                break;
+            default: CCL_THROW("unexpected coll_type ", coll_type);
+        }
+    };
+
+    /* warmup */
+    ccl_barrier_impl(comm, nullptr, {});
+    run_once();
+    ccl_barrier_impl(comm, nullptr, {});
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t iter = 0; iter < iters; iter++) {
+        run_once();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / iters;
+}
+
+template <ccl_coll_type coll_id>
+void ccl_algorithm_tuner::measure(ccl_comm* comm,
+                                  std::vector<float>& send_buf,
+                                  std::vector<float>& recv_buf,
+                                  coll_tables_t& tables) {
+    using algo_group_type = typename ccl_algorithm_selector<coll_id>::type;
+    using helper = ccl_algorithm_selector_helper<algo_group_type>;
+
+    const auto& selector =
+        ccl::global_data::get().algorithm_selector->template get_selector<coll_id>();
+
+    size_t comm_size = comm->size();
+    bool is_vector_coll = (coll_id == ccl_coll_allgatherv || coll_id == ccl_coll_alltoall ||
+                           coll_id == ccl_coll_reduce_scatter);
+
+    std::vector<algo_group_type> algos;
+    for (const auto& name : helper::algo_names) {
+        algos.push_back(name.first);
+    }
+
+    /* pairs of (right border in bytes, fastest algo) */
+    std::vector<std::pair<size_t, algo_group_type>> points;
+
+    for (size_t size = CCL_TUNING_MIN_SIZE; size <= ccl::global_data::env().tuning_max_size;
+         size *= CCL_TUNING_SIZE_FACTOR) {
+        size_t count = size / sizeof(float);
+        if ((is_vector_coll ? count * comm_size : count) > send_buf.size())
+            break;
+
+        std::vector<size_t> recv_counts(comm_size, count);
+
+        ccl_selector_param param;
+        param.ctype = coll_id;
+        param.count = count;
+        param.dtype = ccl::global_data::get().dtypes->get(ccl::datatype::float32);
+        param.comm = comm;
+        param.recv_counts = recv_counts.data();
+        /* measurements run as regular user collectives */
+        param.is_regular_sched = 1;
+
+        std::vector<double> times(algos.size(), DBL_MAX);
+        for (size_t idx = 0; idx < algos.size(); idx++) {
+            if (!helper::can_use(algos[idx], param, selector.main_table))
+                continue;
+            ccl_coll_algo algo;
+            algo.value = algos[idx];
+            times[idx] = run(comm, send_buf, recv_buf, coll_id, algo, count);
+        }
+
+        /* the slowest rank defines time of algorithm, the same decision on all ranks */
+        ccl_coll_attr attr{};
+        attr.synchronous = 1;
+        ccl_allreduce_impl(times.data(),
+                           times.data(),
+                           times.size(),
+                           ccl::datatype::float64,
+                           ccl::reduction::max,
+                           attr,
+                           comm,
+                           nullptr,
+                           {});
+
+        size_t best_idx = std::min_element(times.begin(), times.end()) - times.begin();
+        if (times[best_idx] == DBL_MAX)
+            continue;
+
+        LOG_DEBUG("coll ",
+                  ccl_coll_type_to_str(coll_id),
+                  ", size ",
+                  size,
+                  ", best algo ",
+                  helper::algo_to_str(algos[best_idx]),
+                  ", time ",
+                  times[best_idx],
+                  " usec");
+
+        points.emplace_back(size, algos[best_idx]);
+    }
+
+    if (points.empty())
+        return;
+
+    /* results are valid only for communicators of the same shape */
+    ccl_selection_rule_filter filter;
+    filter.comm_size_left = filter.comm_size_right = comm_size;
+    filter.local_size_left = filter.local_size_right = comm->local_size();
+
+    std::stringstream table;
+    table << filter.to_string();
+    size_t left = 0;
+    for (size_t idx = 0; idx < points.size(); idx++) {
+        /* merge neighbour sizes with the same best algo into single range */
+        if (idx + 1 < points.size() && points[idx + 1].second == points[idx].second)
+            continue;
+
+        table << helper::algo_to_str(points[idx].second) << CCL_SELECTION_ALGO_DELIMETER << left
+              << CCL_SELECTION_SIZE_DELIMETER;
+        if (idx == points.size() - 1) {
+            table << CCL_SELECTION_MAX_COLL_SIZE_STR;
+        }
+        else {
+            table << points[idx].first << CCL_SELECTION_BLOCK_DELIMETER;
+            left = points[idx].first + 1;
+        }
+    }
+
+    tables[coll_id] = table.str();
+}
+
+void ccl_algorithm_tuner::tune(ccl_comm* comm) {
+    const auto& env = ccl::global_data::env();
+    if (!env.enable_tuning && env.tuning_file.empty())
+        return;
+
+    std::string key = get_key(comm);
+    coll_tables_t tables;
+
+    if (!env.enable_tuning) {
+        /* no measurements, so no collectives: tuning file should be readable by all ranks */
+        {
+            std::lock_guard<std::mutex> lock(guard);
+            if (!tuned_keys.insert(key).second)
+                return;
+        }
+        if (load(key, tables)) {
+            LOG_INFO("use tuning results for ", key, " from ", env.tuning_file);
+            apply(tables);
+        }
+        return;
+    }
+
+    /* guard protects tuned_keys only, collectives below are not serialized between comms */
+    int is_tuned = 0;
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        is_tuned = (tuned_keys.find(key) != tuned_keys.end());
+    }
+
+    int is_loaded = is_tuned ? 0 : load(key, tables);
+
+    /*
+       key may be already tuned by another comm on part of ranks
+       and tuning file may be not visible from all nodes,
+       all ranks should take the same decision
+    */
+    int is_ready = (is_tuned || is_loaded);
+    ccl_coll_attr attr{};
+    attr.synchronous = 1;
+    ccl_allreduce_impl(&is_ready,
+                       &is_ready,
+                       1,
+                       ccl::datatype::int32,
+                       ccl::reduction::min,
+                       attr,
+                       comm,
+                       nullptr,
+                       {});
+
+    if (is_ready) {
+        if (is_loaded) {
+            LOG_INFO("use tuning results for ", key, " from ", env.tuning_file);
+        }
+    }
+    else {
+        tables.clear();
+        LOG_INFO("start tuning for ", key);
+
+        size_t buf_count = env.tuning_max_size / sizeof(float);
+        std::vector<float> send_buf(buf_count, 1.0f);
+        std::vector<float> recv_buf(buf_count, 0.0f);
+
+        measure<ccl_coll_allgatherv>(comm, send_buf, recv_buf, tables);
+        measure<ccl_coll_allreduce>(comm, send_buf, recv_buf, tables);
+        measure<ccl_coll_alltoall>(comm, send_buf, recv_buf, tables);
+        measure<ccl_coll_bcast>(comm, send_buf, recv_buf, tables);
+        measure<ccl_coll_reduce>(comm, send_buf, recv_buf, tables);
+        measure<ccl_coll_reduce_scatter>(comm, send_buf, recv_buf, tables);
+
+        if (comm->rank() == 0) {
+            store(key, tables);
+        }
+    }
+
+    apply(tables);
+
+    std::lock_guard<std::mutex> lock(guard);
+    tuned_keys.insert(key);
+}
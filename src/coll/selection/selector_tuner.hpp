@@ -0,0 +1,77 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+
+#define CCL_TUNING_MIN_SIZE       (4)
+#define CCL_TUNING_SIZE_FACTOR    (4)
+#define CCL_TUNING_BYTES_PER_SIZE (64 * 1024 * 1024)
+#define CCL_TUNING_MIN_ITERS      (2)
+#define CCL_TUNING_MAX_ITERS      (32)
+
+class ccl_comm;
+
+/*
+   measures algorithms of collectives on communicator
+   and updates main tables of algorithm selector with the fastest ones,
+   results are stored in tuning file per (comm size, ranks per node, transport)
+   so following runs with the same configuration start with measured tables
+
+   tuning file format, one line per collective:
+   <key> <coll_name> <algo>:<size1-size2>;<algo>:<size1-size2>;...
+*/
+class ccl_algorithm_tuner {
+public:
+    ccl_algorithm_tuner() = default;
+    ccl_algorithm_tuner(const ccl_algorithm_tuner& other) = delete;
+    ccl_algorithm_tuner& operator=(const ccl_algorithm_tuner& other) = delete;
+
+    /* collective over comm, should be called by all ranks of comm */
+    void tune(ccl_comm* comm);
+
+private:
+    using coll_tables_t = std::map<ccl_coll_type, std::string>;
+
+    static std::string get_key(ccl_comm* comm);
+
+    bool load(const std::string& key, coll_tables_t& tables) const;
+    void store(const std::string& key, const coll_tables_t& tables) const;
+    void apply(const coll_tables_t& tables) const;
+
+    template <ccl_coll_type coll_id>
+    void measure(ccl_comm* comm,
+                 std::vector<float>& send_buf,
+                 std::vector<float>& recv_buf,
+                 coll_tables_t& tables);
+
+    double run(ccl_comm* comm,
+               std::vector<float>& send_buf,
+               std::vector<float>& recv_buf,
+               ccl_coll_type coll_type,
+               ccl_coll_algo algo,
+               size_t count);
+
+    /* protects tuned_keys */
+    std::mutex guard;
+    std::set<std::string> tuned_keys;
+};
@@ -18,6 +18,8 @@
 #include "coll/selection/selector.hpp"
 #include "common/utils/tuple.hpp"
 
+#include <memory>
+#include <mutex>
 #include <tuple>
 
 template <ccl_coll_type... registered_coll_id>
@@ -37,22 +39,53 @@ public:
         }
     };
 
+    struct selector_update_functor {
+        ccl_coll_type coll_id;
+        const std::string& str;
+
+        template <typename T>
+        void operator()(T& t) const {
+            if (ccl_algorithm_selector_helper<typename T::type>::get_coll_id() == coll_id) {
+                t.update(str);
+            }
+        }
+    };
+
     void init() {
-        ccl_tuple_for_each(selectors, selector_init_functor());
+        auto new_selectors = std::make_shared<algo_selectors>();
+        ccl_tuple_for_each(*new_selectors, selector_init_functor());
+        std::atomic_store(&selectors, std::shared_ptr<const algo_selectors>(new_selectors));
     }
 
     void print() {
-        ccl_tuple_for_each(selectors, selector_print_functor());
+        ccl_tuple_for_each(*std::atomic_load(&selectors), selector_print_functor());
+    }
+
+    /*
+       replaces ranges of main table, str has the same format as CCL_<COLL> env,
+       readers keep using previous tables until the updated copy is published
+    */
+    void update(ccl_coll_type coll_id, const std::string& str) {
+        std::lock_guard<std::mutex> lock(update_guard);
+        auto new_selectors = std::make_shared<algo_selectors>(*std::atomic_load(&selectors));
+        ccl_tuple_for_each(*new_selectors, selector_update_functor{ coll_id, str });
+        std::atomic_store(&selectors, std::shared_ptr<const algo_selectors>(new_selectors));
+    }
+
+    template <ccl_coll_type coll_id>
+    ccl_algorithm_selector<coll_id> get_selector() const {
+        return std::get<coll_id>(*std::atomic_load(&selectors));
     }
 
     template <ccl_coll_type coll_id>
     typename ccl_algorithm_selector<coll_id>::type get(const ccl_selector_param& param) const {
         CCL_THROW_IF_NOT(
             coll_id == param.ctype, "expected coll_id ", coll_id, ", got ", param.ctype);
-        return std::get<coll_id>(selectors).get(param);
+        return std::get<coll_id>(*std::atomic_load(&selectors)).get(param);
     }
 
 private:
     using algo_selectors = std::tuple<ccl_algorithm_selector<registered_coll_id>...>;
-    algo_selectors selectors;
+    std::shared_ptr<const algo_selectors> selectors;
+    std::mutex update_guard;
 };
@@ -53,6 +53,16 @@ public:
      */
     uint64_t create(int rank, ccl_comm_id_t comm_id, ccl_sched_id_t sched_id, ccl_op_id_t op_id);
 
+    /**
+     * Clears communicator identifier bits of the tag,
+     * used by transports which match messages per communicator on their own
+     * @param tag ATL communication tag
+     * @return tag without comm_id bits
+     */
+    uint64_t strip_comm_id(uint64_t tag) const {
+        return tag & ~comm_id_mask;
+    }
+
 private:
     /**********************************************************************************
      *  atl tag layout                                                                *
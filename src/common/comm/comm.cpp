@@ -19,6 +19,7 @@
 #include "coll/coll.hpp"
 #include "coll/coll_common_attributes.hpp"
 #include "coll/ccl_allgather_op_attr.hpp"
+#include "coll/selection/selector_tuner.hpp"
 #include "common/comm/comm.hpp"
 #include "common/comm/comm_impl.hpp"
 #include "common/global/global.hpp"
@@ -43,6 +44,7 @@ ccl_comm_internal::ccl_comm_internal(int rank,
           m_local2global_map(std::move(rank_map)),
           m_dtree(size, rank) {
     reset(rank, size);
+    set_local_size();
 }
 
 ccl_comm_internal::ccl_comm_internal(const std::vector<int>& local_ranks,
@@ -55,6 +57,11 @@ ccl_comm_internal::ccl_comm_internal(const std::vector<int>& local_ranks,
     atl = atl_comm_manager::create_comm(comm_size, local_ranks, kvs_wrapper);
 
     reset(atl->get_rank(), atl->get_size());
+    set_local_size();
+}
+
+void ccl_comm_internal::set_local_size() {
+    m_local_size = std::max(1, std::min(atl->get_local_size(), m_size));
 }
 
 //TODO: will fix it after OFI refactoring
@@ -153,6 +160,8 @@ ccl_comm::ccl_comm(ccl::unified_device_type&& d,
 
     allocate_resources();
     create_sub_comms(atl);
+
+    ccl::global_data::get().algorithm_tuner->tune(this);
 }
 
 ccl_comm::ccl_comm(std::shared_ptr<atl_base_comm> atl)
@@ -224,6 +233,7 @@ ccl_comm::ccl_comm(const ccl_comm& src, ccl_comm_id_storage::comm_id&& id)
           node_comm(src.node_comm),
           even_comm(src.even_comm),
           pair_comm(src.pair_comm),
+          allreduce_hierarchical_builder(src.allreduce_hierarchical_builder),
           comm_attr(create_comm_split_attr()),
           comm_rank(src.rank()),
           comm_size(src.size()),
@@ -263,6 +273,20 @@ void ccl_comm::create_sub_comms(std::shared_ptr<atl_base_comm> atl) {
         atl->get_host_color() + atl->get_rank() / 2, data.comm_ids.get(), true));
 }
 
+ccl_allreduce_hierarchical_builder* ccl_comm::get_allreduce_hierarchical_builder() {
+    if (!allreduce_hierarchical_builder && !allreduce_hierarchical_builder_pending && node_comm &&
+        r2r_comm && ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+        allreduce_hierarchical_builder_pending = true;
+        allreduce_hierarchical_builder = std::make_shared<ccl_allreduce_hierarchical_builder>(
+            ccl::global_data::env().allreduce_hierarchical_segment_size,
+            this,
+            node_comm,
+            r2r_comm);
+        allreduce_hierarchical_builder_pending = false;
+    }
+    return allreduce_hierarchical_builder.get();
+}
+
 ccl_comm* ccl_comm::create_with_color(int color,
                                       ccl_comm_id_storage* comm_ids,
                                       bool share_resources) const {
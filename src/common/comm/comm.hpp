@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include "atl/atl_base_comm.hpp"
 #include "coll/algorithms/allreduce/allreduce_2d.hpp"
+#include "coll/algorithms/allreduce/allreduce_hierarchical.hpp"
 #include "common/comm/communicator_traits.hpp"
 #include "common/comm/comm_interface.hpp"
 #include "common/comm/comm_id_storage.hpp"
@@ -107,6 +108,10 @@ public:
         return m_pof2;
     }
 
+    int local_size() const noexcept {
+        return m_local_size;
+    }
+
     const ccl_double_tree& dtree() const {
         return m_dtree;
     }
@@ -135,9 +140,12 @@ public:
     std::unique_ptr<ccl_allreduce_2d_builder> allreduce_2d_builder;
 
 private:
+    void set_local_size();
+
     int m_rank;
     int m_size;
     int m_pof2;
+    int m_local_size;
 
     ccl_rank2rank_map m_local2global_map{};
     ccl_double_tree m_dtree;
@@ -291,6 +299,11 @@ public:
         return comm_impl->pof2();
     }
 
+    /* number of ranks of this communicator on the current node */
+    int local_size() const noexcept {
+        return comm_impl->local_size();
+    }
+
     ccl_comm_id_t id() const noexcept {
         return comm_id->value();
     }
@@ -305,6 +318,8 @@ public:
     std::unique_ptr<ccl_allreduce_2d_builder>& get_allreduce_2d_builder() {
         return comm_impl->allreduce_2d_builder;
     }
+    /* created on first use, runs collectives over comm so all ranks call it at the same point */
+    ccl_allreduce_hierarchical_builder* get_allreduce_hierarchical_builder();
 
     ccl_comm* create_with_color(int color,
                                 ccl_comm_id_storage* comm_ids,
@@ -361,6 +376,9 @@ private:
     std::shared_ptr<ccl_comm> node_comm;
     std::shared_ptr<ccl_comm> even_comm;
     std::shared_ptr<ccl_comm> pair_comm;
+    std::shared_ptr<ccl_allreduce_hierarchical_builder> allreduce_hierarchical_builder;
+    /* set while the builder runs its setup collectives over this comm */
+    bool allreduce_hierarchical_builder_pending = false;
     ccl::comm_split_attr comm_attr;
 
     // these fields are duplicate with the ones in ccl_comm_internal, but having them here
@@ -37,11 +37,11 @@ std::map<ccl_priority_mode, std::string> env_data::priority_mode_names = {
 };
 
 std::map<ccl_atl_transport, std::string> env_data::atl_transport_names = {
-    std::make_pair(ccl_atl_ofi, "ofi")
+    std::make_pair(ccl_atl_ofi, "ofi"),
 #ifdef CCL_ENABLE_MPI
-        ,
-    std::make_pair(ccl_atl_mpi, "mpi")
+    std::make_pair(ccl_atl_mpi, "mpi"),
 #endif // CCL_ENABLE_MPI
+    std::make_pair(ccl_atl_sim, "sim")
 };
 
 std::map<ccl_atl_send_proxy, std::string> env_data::atl_send_proxy_names = {
@@ -68,12 +68,16 @@ env_data::env_data()
           queue_dump(0),
           sched_dump(0),
           sched_profile(0),
+          sched_trace_size(65536),
+          enable_metrics(1),
 
           fw_type(ccl_framework_none),
 
           worker_count(1),
           worker_offload(1),
           worker_wait(1),
+          worker_helper_threshold(16 * 1024 * 1024),
+          worker_spin_time(100),
 #ifdef CCL_ENABLE_MPI
           atl_transport(ccl_atl_mpi),
 #else // CCL_ENABLE_MPI
@@ -84,21 +88,35 @@ env_data::env_data()
           enable_hmem(0),
           atl_send_proxy(ccl_atl_send_proxy_none),
           enable_atl_cache(1),
+          atl_cache_capacity(1024),
+          atl_cache_max_bytes(4UL * 1024 * 1024 * 1024),
+          enable_atl_lazy_connect(0),
           enable_sync_coll(0),
           enable_extra_ep(0),
 
+          sim_ranks_per_node(1),
+          sim_latency(2000),
+          sim_bandwidth(12500),
+          sim_intra_latency(300),
+          sim_intra_bandwidth(50000),
+
           mnic_type(ATL_MNIC_NONE),
           mnic_count(CCL_ENV_SIZET_NOT_SPECIFIED),
           mnic_offset(ATL_MNIC_OFFSET_NONE),
+          mnic_stripe_threshold(0),
 
           enable_algo_fallback(1),
           enable_unordered_coll(0),
+          enable_tuning(0),
+          tuning_max_size(16 * 1024 * 1024),
 
           enable_fusion(0),
           fusion_bytes_threshold(16384),
           fusion_count_threshold(256),
           fusion_check_urgent(1),
           fusion_cycle_ms(0.2),
+          fusion_zero_copy(0),
+          fusion_adaptive(0),
 
           priority_mode(ccl_priority_none),
           spin_count(100),
@@ -111,7 +129,9 @@ env_data::env_data()
 #else // CCL_ENABLE_SYCL
           enable_cache_flush(0),
 #endif // CCL_ENABLE_SYCL
+          cache_capacity(0),
           enable_buffer_cache(1),
+          enable_buffer_cache_huge_pages(0),
           enable_strict_order(0),
           staging_buffer(ccl_staging_usm),
           enable_op_sync(0),
@@ -127,6 +147,8 @@ env_data::env_data()
           allreduce_2d_switch_dims(0),
           allreduce_nreduce_buffering(0),
           allreduce_nreduce_segment_size(CCL_ENV_SIZET_NOT_SPECIFIED),
+          allreduce_ring_pipelined_segment_size(4 * 1024 * 1024),
+          allreduce_hierarchical_segment_size(1024 * 1024),
 
           alltoall_scatter_max_ops(CCL_ENV_SIZET_NOT_SPECIFIED),
           alltoall_scatter_plain(0),
@@ -154,7 +176,9 @@ env_data::env_data()
 #endif // CCL_ENABLE_SYCL
 
           bf16_impl_type(ccl_bf16_no_compiler_support),
-          fp16_impl_type(ccl_fp16_no_compiler_support) {
+          fp16_impl_type(ccl_fp16_no_compiler_support),
+          simd_impl_type(ccl_simd_scalar),
+          memcpy_nontemporal_threshold(CCL_ENV_SIZET_NOT_SPECIFIED) {
 }
 
 void env_data::parse() {
@@ -163,6 +187,11 @@ void env_data::parse() {
     env_2_type(CCL_QUEUE_DUMP, queue_dump);
     env_2_type(CCL_SCHED_DUMP, sched_dump);
     env_2_type(CCL_SCHED_PROFILE, sched_profile);
+    env_2_type(CCL_SCHED_TRACE, sched_trace);
+    env_2_type(CCL_SCHED_TRACE_SIZE, sched_trace_size);
+    CCL_THROW_IF_NOT(
+        sched_trace_size >= 1, "incorrect ", CCL_SCHED_TRACE_SIZE, " ", sched_trace_size);
+    env_2_type(CCL_METRICS, enable_metrics);
 
     if (fw_type == ccl_framework_none) {
         /* try to automatically detect framework */
@@ -191,8 +220,14 @@ void env_data::parse() {
     CCL_THROW_IF_NOT(worker_count >= 1, "incorrect ", CCL_WORKER_COUNT, " ", worker_count);
     env_2_type(CCL_WORKER_OFFLOAD, worker_offload);
     env_2_type(CCL_WORKER_WAIT, worker_wait);
+    env_2_type(CCL_WORKER_HELPER_THRESHOLD, worker_helper_threshold);
+    env_2_type(CCL_WORKER_SPIN_TIME, worker_spin_time);
 
     env_2_atl_transport();
+    if (atl_transport == ccl_atl_sim) {
+        /* simulated ranks are threads which oversubscribe cores */
+        yield_type = ccl_yield_sched_yield;
+    }
     env_2_type(CCL_ATL_SHM, enable_shm);
     env_2_type(CCL_ATL_RMA, enable_rma);
     env_2_type(CCL_ATL_HMEM, enable_hmem);
@@ -201,9 +236,23 @@ void env_data::parse() {
     }
     env_2_enum(CCL_ATL_SEND_PROXY, atl_send_proxy_names, atl_send_proxy);
     env_2_type(CCL_ATL_CACHE, enable_atl_cache);
+    env_2_type(CCL_ATL_CACHE_CAPACITY, atl_cache_capacity);
+    env_2_type(CCL_ATL_CACHE_MAX_BYTES, atl_cache_max_bytes);
+    env_2_type(CCL_ATL_LAZY_CONNECT, enable_atl_lazy_connect);
     env_2_type(CCL_ATL_SYNC_COLL, enable_sync_coll);
     env_2_type(CCL_ATL_EXTRA_EP, enable_extra_ep);
 
+    env_2_type(CCL_ATL_SIM_RANKS_PER_NODE, sim_ranks_per_node);
+    CCL_THROW_IF_NOT(sim_ranks_per_node >= 1,
+                     "incorrect ",
+                     CCL_ATL_SIM_RANKS_PER_NODE,
+                     " ",
+                     sim_ranks_per_node);
+    env_2_type(CCL_ATL_SIM_LATENCY, sim_latency);
+    env_2_type(CCL_ATL_SIM_BANDWIDTH, sim_bandwidth);
+    env_2_type(CCL_ATL_SIM_INTRA_LATENCY, sim_intra_latency);
+    env_2_type(CCL_ATL_SIM_INTRA_BANDWIDTH, sim_intra_bandwidth);
+
     env_2_enum(CCL_MNIC, mnic_type_names, mnic_type);
     env_2_type(CCL_MNIC_NAME, mnic_name_raw);
     env_2_type(CCL_MNIC_COUNT, mnic_count);
@@ -211,6 +260,7 @@ void env_data::parse() {
         mnic_count = worker_count;
     }
     env_2_enum(CCL_MNIC_OFFSET, mnic_offset_names, mnic_offset);
+    env_2_type(CCL_MNIC_STRIPE_THRESHOLD, mnic_stripe_threshold);
 
     env_2_type(CCL_ALGO_FALLBACK, enable_algo_fallback);
     env_2_type(CCL_ALLGATHERV, allgatherv_algo_raw);
@@ -222,6 +272,9 @@ void env_data::parse() {
     env_2_type(CCL_REDUCE, reduce_algo_raw);
     env_2_type(CCL_REDUCE_SCATTER, reduce_scatter_algo_raw);
     env_2_type(CCL_SPARSE_ALLREDUCE, sparse_allreduce_algo_raw);
+    env_2_type(CCL_TUNING, enable_tuning);
+    env_2_type(CCL_TUNING_FILE, tuning_file);
+    env_2_type(CCL_TUNING_MAX_SIZE, tuning_max_size);
     env_2_type(CCL_UNORDERED_COLL, enable_unordered_coll);
     if (enable_unordered_coll && atl_transport != ccl_atl_ofi) {
         CCL_THROW("unordered collectives are supported for OFI transport only");
@@ -232,6 +285,8 @@ void env_data::parse() {
     env_2_type(CCL_FUSION_COUNT_THRESHOLD, fusion_count_threshold);
     env_2_type(CCL_FUSION_CHECK_URGENT, fusion_check_urgent);
     env_2_type(CCL_FUSION_CYCLE_MS, fusion_cycle_ms);
+    env_2_type(CCL_FUSION_ZERO_COPY, fusion_zero_copy);
+    env_2_type(CCL_FUSION_ADAPTIVE, fusion_adaptive);
     if (enable_fusion) {
         CCL_THROW_IF_NOT(fusion_bytes_threshold >= 1,
                          "incorrect ",
@@ -258,7 +313,9 @@ void env_data::parse() {
     env_2_type(CCL_BCAST_PART_COUNT, (size_t&)bcast_part_count);
     env_2_enum(CCL_CACHE_KEY, ccl_sched_key::key_type_names, cache_key_type);
     env_2_type(CCL_CACHE_FLUSH, enable_cache_flush);
+    env_2_type(CCL_CACHE_CAPACITY, cache_capacity);
     env_2_type(CCL_BUFFER_CACHE, enable_buffer_cache);
+    env_2_type(CCL_BUFFER_CACHE_HUGE_PAGES, enable_buffer_cache_huge_pages);
     env_2_type(CCL_STRICT_ORDER, enable_strict_order);
     if (enable_unordered_coll && enable_strict_order) {
         LOG_INFO("unordered collectives are requested, disable strict order");
@@ -289,6 +346,18 @@ void env_data::parse() {
     env_2_type(CCL_ALLREDUCE_2D_SWITCH_DIMS, allreduce_2d_switch_dims);
     env_2_type(CCL_ALLREDUCE_NREDUCE_BUFFERING, allreduce_nreduce_buffering);
     env_2_type(CCL_ALLREDUCE_NREDUCE_SEGMENT_SIZE, (size_t&)allreduce_nreduce_segment_size);
+    env_2_type(CCL_ALLREDUCE_RING_PIPELINED_SEGMENT_SIZE, allreduce_ring_pipelined_segment_size);
+    CCL_THROW_IF_NOT(allreduce_ring_pipelined_segment_size > 0,
+                     "incorrect ",
+                     CCL_ALLREDUCE_RING_PIPELINED_SEGMENT_SIZE,
+                     " ",
+                     allreduce_ring_pipelined_segment_size);
+    env_2_type(CCL_ALLREDUCE_HIERARCHICAL_SEGMENT_SIZE, allreduce_hierarchical_segment_size);
+    CCL_THROW_IF_NOT(allreduce_hierarchical_segment_size > 0,
+                     "incorrect ",
+                     CCL_ALLREDUCE_HIERARCHICAL_SEGMENT_SIZE,
+                     " ",
+                     allreduce_hierarchical_segment_size);
 
     env_2_type(CCL_ALLTOALL_SCATTER_MAX_OPS, (size_t&)alltoall_scatter_max_ops);
     env_2_type(CCL_ALLTOALL_SCATTER_PLAIN, alltoall_scatter_plain);
@@ -348,6 +417,20 @@ void env_data::parse() {
     else {
         fp16_impl_type = *fp16_impl_types.rbegin();
     }
+
+    auto simd_impl_types = ccl_simd_get_impl_types();
+    ccl_simd_impl_type simd_env_impl_type;
+    if (env_2_enum(CCL_SIMD, simd_impl_names, simd_env_impl_type)) {
+        CCL_THROW_IF_NOT(simd_impl_types.find(simd_env_impl_type) != simd_impl_types.end(),
+                         "unsupported SIMD impl type: ",
+                         simd_impl_names[simd_env_impl_type]);
+        simd_impl_type = simd_env_impl_type;
+    }
+    else {
+        simd_impl_type = *simd_impl_types.rbegin();
+    }
+
+    env_2_type(CCL_MEMCPY_NONTEMPORAL_THRESHOLD, (size_t&)memcpy_nontemporal_threshold);
 }
 
 void env_data::print(int rank) {
@@ -403,11 +486,18 @@ void env_data::print(int rank) {
     LOG_INFO(CCL_WORKER_COUNT, ": ", worker_count);
     LOG_INFO(CCL_WORKER_OFFLOAD, ": ", worker_offload);
     LOG_INFO(CCL_WORKER_WAIT, ": ", worker_wait);
+    LOG_INFO(CCL_WORKER_HELPER_THRESHOLD, ": ", worker_helper_threshold);
+    LOG_INFO(CCL_WORKER_SPIN_TIME, ": ", worker_spin_time);
 
     LOG_INFO(CCL_LOG_LEVEL, ": ", str_by_enum(ccl_logger::level_names, log_level));
     LOG_INFO(CCL_QUEUE_DUMP, ": ", queue_dump);
     LOG_INFO(CCL_SCHED_DUMP, ": ", sched_dump);
     LOG_INFO(CCL_SCHED_PROFILE, ": ", sched_profile);
+    LOG_INFO(CCL_SCHED_TRACE,
+             ": ",
+             (sched_trace.length()) ? sched_trace : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_SCHED_TRACE_SIZE, ": ", sched_trace_size);
+    LOG_INFO(CCL_METRICS, ": ", enable_metrics);
 
     LOG_INFO(CCL_FRAMEWORK, ": ", str_by_enum(ccl_framework_type_names, fw_type));
 
@@ -417,14 +507,26 @@ void env_data::print(int rank) {
     LOG_INFO(CCL_ATL_HMEM, ": ", enable_hmem);
     LOG_INFO(CCL_ATL_SEND_PROXY, ": ", str_by_enum(atl_send_proxy_names, atl_send_proxy));
     LOG_INFO(CCL_ATL_CACHE, ": ", enable_atl_cache);
+    LOG_INFO(CCL_ATL_CACHE_CAPACITY, ": ", atl_cache_capacity);
+    LOG_INFO(CCL_ATL_CACHE_MAX_BYTES, ": ", atl_cache_max_bytes);
+    LOG_INFO(CCL_ATL_LAZY_CONNECT, ": ", enable_atl_lazy_connect);
     LOG_DEBUG(CCL_ATL_SYNC_COLL, ": ", enable_sync_coll);
     LOG_DEBUG(CCL_ATL_EXTRA_EP, ": ", enable_extra_ep);
 
+    if (atl_transport == ccl_atl_sim) {
+        LOG_INFO(CCL_ATL_SIM_RANKS_PER_NODE, ": ", sim_ranks_per_node);
+        LOG_INFO(CCL_ATL_SIM_LATENCY, ": ", sim_latency);
+        LOG_INFO(CCL_ATL_SIM_BANDWIDTH, ": ", sim_bandwidth);
+        LOG_INFO(CCL_ATL_SIM_INTRA_LATENCY, ": ", sim_intra_latency);
+        LOG_INFO(CCL_ATL_SIM_INTRA_BANDWIDTH, ": ", sim_intra_bandwidth);
+    }
+
     LOG_INFO(CCL_MNIC, ": ", str_by_enum(mnic_type_names, mnic_type));
     LOG_INFO(
         CCL_MNIC_NAME, ": ", (mnic_name_raw.length()) ? mnic_name_raw : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO(CCL_MNIC_COUNT, ": ", mnic_count);
     LOG_INFO(CCL_MNIC_OFFSET, ": ", str_by_enum(mnic_offset_names, mnic_offset));
+    LOG_INFO(CCL_MNIC_STRIPE_THRESHOLD, ": ", mnic_stripe_threshold);
 
     LOG_INFO(CCL_ALGO_FALLBACK, ": ", enable_algo_fallback);
     LOG_INFO(CCL_ALLGATHERV,
@@ -455,12 +557,17 @@ void env_data::print(int rank) {
              (sparse_allreduce_algo_raw.length()) ? sparse_allreduce_algo_raw
                                                   : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO(CCL_UNORDERED_COLL, ": ", enable_unordered_coll);
+    LOG_INFO(CCL_TUNING, ": ", enable_tuning);
+    LOG_INFO(CCL_TUNING_FILE, ": ", (tuning_file.length()) ? tuning_file : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_TUNING_MAX_SIZE, ": ", tuning_max_size);
 
     LOG_INFO(CCL_FUSION, ": ", enable_fusion);
     LOG_INFO(CCL_FUSION_BYTES_THRESHOLD, ": ", fusion_bytes_threshold);
     LOG_INFO(CCL_FUSION_COUNT_THRESHOLD, ": ", fusion_count_threshold);
     LOG_INFO(CCL_FUSION_CHECK_URGENT, ": ", fusion_check_urgent);
     LOG_INFO(CCL_FUSION_CYCLE_MS, ": ", fusion_cycle_ms);
+    LOG_INFO(CCL_FUSION_ZERO_COPY, ": ", fusion_zero_copy);
+    LOG_INFO(CCL_FUSION_ADAPTIVE, ": ", fusion_adaptive);
 
     LOG_INFO(CCL_PRIORITY, ": ", str_by_enum(priority_mode_names, priority_mode));
     LOG_INFO(CCL_SPIN_COUNT, ": ", spin_count);
@@ -472,7 +579,9 @@ void env_data::print(int rank) {
                                                                : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO(CCL_CACHE_KEY, ": ", str_by_enum(ccl_sched_key::key_type_names, cache_key_type));
     LOG_INFO(CCL_CACHE_FLUSH, ": ", enable_cache_flush);
+    LOG_INFO(CCL_CACHE_CAPACITY, ": ", cache_capacity);
     LOG_INFO(CCL_BUFFER_CACHE, ": ", enable_buffer_cache);
+    LOG_INFO(CCL_BUFFER_CACHE_HUGE_PAGES, ": ", enable_buffer_cache_huge_pages);
     LOG_INFO(CCL_STRICT_ORDER, ": ", enable_strict_order);
     LOG_INFO(CCL_STAGING_BUFFER, ": ", str_by_enum(staging_buffer_names, staging_buffer));
     LOG_INFO(CCL_OP_SYNC, ": ", enable_op_sync);
@@ -496,6 +605,8 @@ void env_data::print(int rank) {
              (allreduce_nreduce_segment_size != CCL_ENV_SIZET_NOT_SPECIFIED)
                  ? std::to_string(allreduce_nreduce_segment_size)
                  : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_ALLREDUCE_RING_PIPELINED_SEGMENT_SIZE, ": ", allreduce_ring_pipelined_segment_size);
+    LOG_INFO(CCL_ALLREDUCE_HIERARCHICAL_SEGMENT_SIZE, ": ", allreduce_hierarchical_segment_size);
 
     LOG_INFO(CCL_ALLTOALL_SCATTER_MAX_OPS,
              ": ",
@@ -536,6 +647,12 @@ void env_data::print(int rank) {
 
     LOG_INFO(CCL_BF16, ": ", str_by_enum(bf16_impl_names, bf16_impl_type));
     LOG_INFO(CCL_FP16, ": ", str_by_enum(fp16_impl_names, fp16_impl_type));
+    LOG_INFO(CCL_SIMD, ": ", str_by_enum(simd_impl_names, simd_impl_type));
+    LOG_INFO(CCL_MEMCPY_NONTEMPORAL_THRESHOLD,
+             ": ",
+             (memcpy_nontemporal_threshold != CCL_ENV_SIZET_NOT_SPECIFIED)
+                 ? std::to_string(memcpy_nontemporal_threshold)
+                 : CCL_ENV_STR_NOT_SPECIFIED);
 
     char* ccl_root = getenv("CCL_ROOT");
     LOG_INFO("CCL_ROOT: ", (ccl_root) ? ccl_root : CCL_ENV_STR_NOT_SPECIFIED);
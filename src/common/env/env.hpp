@@ -29,6 +29,7 @@
 #include "common/utils/yield.hpp"
 #include "comp/bf16/bf16_utils.hpp"
 #include "comp/fp16/fp16_utils.hpp"
+#include "comp/simd/simd_utils.hpp"
 #include "sched/cache/cache.hpp"
 
 constexpr const char* CCL_ENV_STR_NOT_SPECIFIED = "<not specified>";
@@ -38,12 +39,17 @@ constexpr const char* CCL_LOG_LEVEL = "CCL_LOG_LEVEL";
 constexpr const char* CCL_QUEUE_DUMP = "CCL_QUEUE_DUMP";
 constexpr const char* CCL_SCHED_DUMP = "CCL_SCHED_DUMP";
 constexpr const char* CCL_SCHED_PROFILE = "CCL_SCHED_PROFILE";
+constexpr const char* CCL_SCHED_TRACE = "CCL_SCHED_TRACE";
+constexpr const char* CCL_SCHED_TRACE_SIZE = "CCL_SCHED_TRACE_SIZE";
+constexpr const char* CCL_METRICS = "CCL_METRICS";
 
 constexpr const char* CCL_FRAMEWORK = "CCL_FRAMEWORK";
 
 constexpr const char* CCL_WORKER_COUNT = "CCL_WORKER_COUNT";
 constexpr const char* CCL_WORKER_OFFLOAD = "CCL_WORKER_OFFLOAD";
 constexpr const char* CCL_WORKER_WAIT = "CCL_WORKER_WAIT";
+constexpr const char* CCL_WORKER_HELPER_THRESHOLD = "CCL_WORKER_HELPER_THRESHOLD";
+constexpr const char* CCL_WORKER_SPIN_TIME = "CCL_WORKER_SPIN_TIME";
 constexpr const char* CCL_WORKER_AFFINITY = "CCL_WORKER_AFFINITY";
 constexpr const char* CCL_WORKER_MEM_AFFINITY = "CCL_WORKER_MEM_AFFINITY";
 
@@ -58,11 +64,20 @@ constexpr const char* CCL_ATL_SEND_PROXY = "CCL_ATL_SEND_PROXY";
 constexpr const char* CCL_ATL_SYNC_COLL = "CCL_ATL_SYNC_COLL";
 constexpr const char* CCL_ATL_EXTRA_EP = "CCL_ATL_EXTRA_EP";
 constexpr const char* CCL_ATL_CACHE = "CCL_ATL_CACHE";
+constexpr const char* CCL_ATL_CACHE_CAPACITY = "CCL_ATL_CACHE_CAPACITY";
+constexpr const char* CCL_ATL_CACHE_MAX_BYTES = "CCL_ATL_CACHE_MAX_BYTES";
+constexpr const char* CCL_ATL_LAZY_CONNECT = "CCL_ATL_LAZY_CONNECT";
+constexpr const char* CCL_ATL_SIM_RANKS_PER_NODE = "CCL_ATL_SIM_RANKS_PER_NODE";
+constexpr const char* CCL_ATL_SIM_LATENCY = "CCL_ATL_SIM_LATENCY";
+constexpr const char* CCL_ATL_SIM_BANDWIDTH = "CCL_ATL_SIM_BANDWIDTH";
+constexpr const char* CCL_ATL_SIM_INTRA_LATENCY = "CCL_ATL_SIM_INTRA_LATENCY";
+constexpr const char* CCL_ATL_SIM_INTRA_BANDWIDTH = "CCL_ATL_SIM_INTRA_BANDWIDTH";
 
 constexpr const char* CCL_MNIC = "CCL_MNIC";
 constexpr const char* CCL_MNIC_NAME = "CCL_MNIC_NAME";
 constexpr const char* CCL_MNIC_COUNT = "CCL_MNIC_COUNT";
 constexpr const char* CCL_MNIC_OFFSET = "CCL_MNIC_OFFSET";
+constexpr const char* CCL_MNIC_STRIPE_THRESHOLD = "CCL_MNIC_STRIPE_THRESHOLD";
 
 constexpr const char* CCL_ALGO_FALLBACK = "CCL_ALGO_FALLBACK";
 constexpr const char* CCL_ALLGATHERV = "CCL_ALLGATHERV";
@@ -75,12 +90,17 @@ constexpr const char* CCL_REDUCE = "CCL_REDUCE";
 constexpr const char* CCL_REDUCE_SCATTER = "CCL_REDUCE_SCATTER";
 constexpr const char* CCL_SPARSE_ALLREDUCE = "CCL_SPARSE_ALLREDUCE";
 constexpr const char* CCL_UNORDERED_COLL = "CCL_UNORDERED_COLL";
+constexpr const char* CCL_TUNING = "CCL_TUNING";
+constexpr const char* CCL_TUNING_FILE = "CCL_TUNING_FILE";
+constexpr const char* CCL_TUNING_MAX_SIZE = "CCL_TUNING_MAX_SIZE";
 
 constexpr const char* CCL_FUSION = "CCL_FUSION";
 constexpr const char* CCL_FUSION_BYTES_THRESHOLD = "CCL_FUSION_BYTES_THRESHOLD";
 constexpr const char* CCL_FUSION_COUNT_THRESHOLD = "CCL_FUSION_COUNT_THRESHOLD";
 constexpr const char* CCL_FUSION_CHECK_URGENT = "CCL_FUSION_CHECK_URGENT";
 constexpr const char* CCL_FUSION_CYCLE_MS = "CCL_FUSION_CYCLE_MS";
+constexpr const char* CCL_FUSION_ZERO_COPY = "CCL_FUSION_ZERO_COPY";
+constexpr const char* CCL_FUSION_ADAPTIVE = "CCL_FUSION_ADAPTIVE";
 
 constexpr const char* CCL_PRIORITY = "CCL_PRIORITY";
 constexpr const char* CCL_SPIN_COUNT = "CCL_SPIN_COUNT";
@@ -89,7 +109,9 @@ constexpr const char* CCL_MAX_SHORT_SIZE = "CCL_MAX_SHORT_SIZE";
 constexpr const char* CCL_BCAST_PART_COUNT = "CCL_BCAST_PART_COUNT";
 constexpr const char* CCL_CACHE_KEY = "CCL_CACHE_KEY";
 constexpr const char* CCL_CACHE_FLUSH = "CCL_CACHE_FLUSH";
+constexpr const char* CCL_CACHE_CAPACITY = "CCL_CACHE_CAPACITY";
 constexpr const char* CCL_BUFFER_CACHE = "CCL_BUFFER_CACHE";
+constexpr const char* CCL_BUFFER_CACHE_HUGE_PAGES = "CCL_BUFFER_CACHE_HUGE_PAGES";
 constexpr const char* CCL_STRICT_ORDER = "CCL_STRICT_ORDER";
 constexpr const char* CCL_STAGING_BUFFER = "CCL_STAGING_BUFFER";
 constexpr const char* CCL_OP_SYNC = "CCL_OP_SYNC";
@@ -106,6 +128,10 @@ constexpr const char* CCL_ALLREDUCE_2D_SWITCH_DIMS = "CCL_ALLREDUCE_2D_SWITCH_DI
 
 constexpr const char* CCL_ALLREDUCE_NREDUCE_BUFFERING = "CCL_ALLREDUCE_NREDUCE_BUFFERING";
 constexpr const char* CCL_ALLREDUCE_NREDUCE_SEGMENT_SIZE = "CCL_ALLREDUCE_NREDUCE_SEGMENT_SIZE";
+constexpr const char* CCL_ALLREDUCE_RING_PIPELINED_SEGMENT_SIZE =
+    "CCL_ALLREDUCE_RING_PIPELINED_SEGMENT_SIZE";
+constexpr const char* CCL_ALLREDUCE_HIERARCHICAL_SEGMENT_SIZE =
+    "CCL_ALLREDUCE_HIERARCHICAL_SEGMENT_SIZE";
 
 constexpr const char* CCL_ALLTOALL_SCATTER_MAX_OPS = "CCL_ALLTOALL_SCATTER_MAX_OPS";
 constexpr const char* CCL_ALLTOALL_SCATTER_PLAIN = "CCL_ALLTOALL_SCATTER_PLAIN";
@@ -132,10 +158,12 @@ constexpr const char* CCL_ZE_CLOSE_IPC_WA = "CCL_ZE_CLOSE_IPC_WA";
 
 constexpr const char* CCL_BF16 = "CCL_BF16";
 constexpr const char* CCL_FP16 = "CCL_FP16";
+constexpr const char* CCL_SIMD = "CCL_SIMD";
+constexpr const char* CCL_MEMCPY_NONTEMPORAL_THRESHOLD = "CCL_MEMCPY_NONTEMPORAL_THRESHOLD";
 
 enum ccl_priority_mode { ccl_priority_none, ccl_priority_direct, ccl_priority_lifo };
 
-enum ccl_atl_transport { ccl_atl_ofi, ccl_atl_mpi };
+enum ccl_atl_transport { ccl_atl_ofi, ccl_atl_mpi, ccl_atl_sim };
 
 enum ccl_atl_send_proxy {
     ccl_atl_send_proxy_none,
@@ -175,12 +203,17 @@ public:
     int queue_dump;
     int sched_dump;
     int sched_profile;
+    std::string sched_trace;
+    size_t sched_trace_size;
+    int enable_metrics;
 
     ccl_framework_type fw_type;
 
     size_t worker_count;
     int worker_offload;
     int worker_wait;
+    size_t worker_helper_threshold;
+    size_t worker_spin_time;
     std::vector<ssize_t> worker_affinity;
     std::vector<ssize_t> worker_mem_affinity;
 
@@ -190,13 +223,24 @@ public:
     int enable_hmem;
     ccl_atl_send_proxy atl_send_proxy;
     int enable_atl_cache;
+    size_t atl_cache_capacity;
+    size_t atl_cache_max_bytes;
+    int enable_atl_lazy_connect;
     int enable_sync_coll;
     int enable_extra_ep;
 
+    /* simulated transport: latencies in nanoseconds, bandwidths in MB/s, 0 means no limit */
+    size_t sim_ranks_per_node;
+    size_t sim_latency;
+    size_t sim_bandwidth;
+    size_t sim_intra_latency;
+    size_t sim_intra_bandwidth;
+
     atl_mnic_t mnic_type;
     std::string mnic_name_raw;
     ssize_t mnic_count;
     atl_mnic_offset_t mnic_offset;
+    size_t mnic_stripe_threshold;
 
     /*
        parsing logic can be quite complex
@@ -214,12 +258,17 @@ public:
     std::string reduce_scatter_algo_raw;
     std::string sparse_allreduce_algo_raw;
     int enable_unordered_coll;
+    int enable_tuning;
+    std::string tuning_file;
+    size_t tuning_max_size;
 
     int enable_fusion;
     int fusion_bytes_threshold;
     int fusion_count_threshold;
     int fusion_check_urgent;
     float fusion_cycle_ms;
+    int fusion_zero_copy;
+    int fusion_adaptive;
 
     ccl_priority_mode priority_mode;
     size_t spin_count;
@@ -228,7 +277,9 @@ public:
     ssize_t bcast_part_count;
     ccl_cache_key_type cache_key_type;
     int enable_cache_flush;
+    size_t cache_capacity;
     int enable_buffer_cache;
+    int enable_buffer_cache_huge_pages;
     int enable_strict_order;
     ccl_staging_buffer staging_buffer;
     int enable_op_sync;
@@ -244,6 +295,8 @@ public:
     int allreduce_2d_switch_dims;
     int allreduce_nreduce_buffering;
     ssize_t allreduce_nreduce_segment_size;
+    size_t allreduce_ring_pipelined_segment_size;
+    size_t allreduce_hierarchical_segment_size;
 
     ssize_t alltoall_scatter_max_ops;
     int alltoall_scatter_plain;
@@ -272,6 +325,8 @@ public:
 
     ccl_bf16_impl_type bf16_impl_type;
     ccl_fp16_impl_type fp16_impl_type;
+    ccl_simd_impl_type simd_impl_type;
+    ssize_t memcpy_nontemporal_threshold;
 
     template <class T>
     static int env_2_type(const char* env_name, T& val) {
@@ -14,17 +14,21 @@
  limitations under the License.
 */
 #include "coll/selection/selection.hpp"
+#include "coll/selection/selector_tuner.hpp"
 #include "common/comm/atl_tag.hpp"
 #include "common/comm/comm_id_storage.hpp"
 #include "common/datatype/datatype.hpp"
 #include "common/global/global.hpp"
+#include "common/metrics/metrics.hpp"
 #include "common/stream/stream.hpp"
+#include "common/utils/memcpy.hpp"
 #include "common/utils/tree.hpp"
 #include "exec/exec.hpp"
 #include "fusion/fusion.hpp"
 #include "parallelizer/parallelizer.hpp"
 #include "sched/buffer/buffer_cache.hpp"
 #include "sched/cache/cache.hpp"
+#include "sched/sched_tracer.hpp"
 
 #ifdef CCL_ENABLE_ZE
 #include "sched/entry/ze/ze_cache.hpp"
@@ -111,7 +115,30 @@ void global_data::init_resize_independent_objects() {
         new ccl_algorithm_selector_wrapper<CCL_COLL_LIST>());
     algorithm_selector->init();
 
+    algorithm_tuner = std::unique_ptr<ccl_algorithm_tuner>(new ccl_algorithm_tuner());
+
     hwloc_wrapper = std::unique_ptr<ccl_hwloc_wrapper>(new ccl_hwloc_wrapper());
+
+    if (!env_object.sched_trace.empty()) {
+        sched_tracer = std::unique_ptr<ccl::sched_tracer>(
+            new ccl::sched_tracer(env_object.sched_trace, env_object.sched_trace_size));
+    }
+
+    if (env_object.enable_metrics) {
+        metrics_collector = std::unique_ptr<ccl::metrics_collector>(new ccl::metrics_collector());
+    }
+
+    init_memcpy();
+}
+
+void global_data::init_memcpy() {
+    size_t threshold = env_object.memcpy_nontemporal_threshold;
+    if (env_object.memcpy_nontemporal_threshold == CCL_ENV_SIZET_NOT_SPECIFIED) {
+        /* copies which don't fit into LLC share of core would evict useful data anyway */
+        size_t llc_size = hwloc_wrapper->get_llc_size_per_core();
+        threshold = (llc_size) ? llc_size : CCL_MEMCPY_DEFAULT_NONTEMPORAL_THRESHOLD;
+    }
+    ccl::memcpy_set_nontemporal_threshold(threshold);
 }
 
 void global_data::reset_resize_dependent_objects() {
@@ -124,8 +151,11 @@ void global_data::reset_resize_dependent_objects() {
 
 void global_data::reset_resize_independent_objects() {
     parallelizer.reset();
+    algorithm_tuner.reset();
     algorithm_selector.reset();
     hwloc_wrapper.reset();
+    sched_tracer.reset();
+    metrics_collector.reset();
 }
 
 #ifdef CCL_ENABLE_ZE
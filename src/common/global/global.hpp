@@ -46,6 +46,7 @@ class ccl_executor;
 class ccl_sched_cache;
 class ccl_parallelizer;
 class ccl_fusion_manager;
+class ccl_algorithm_tuner;
 
 template <ccl_coll_type... registered_types_id>
 class ccl_algorithm_selector_wrapper;
@@ -53,6 +54,8 @@ class ccl_algorithm_selector_wrapper;
 namespace ccl {
 
 class buffer_cache;
+class metrics_collector;
+class sched_tracer;
 
 namespace ze {
 class cache;
@@ -87,7 +90,10 @@ public:
     std::unique_ptr<ccl_parallelizer> parallelizer;
     std::unique_ptr<ccl_fusion_manager> fusion_manager;
     std::unique_ptr<ccl_algorithm_selector_wrapper<CCL_COLL_LIST>> algorithm_selector;
+    std::unique_ptr<ccl_algorithm_tuner> algorithm_tuner;
     std::unique_ptr<ccl_hwloc_wrapper> hwloc_wrapper;
+    std::unique_ptr<ccl::sched_tracer> sched_tracer;
+    std::unique_ptr<ccl::metrics_collector> metrics_collector;
     std::atomic<size_t> kernel_counter;
 
 #ifdef CCL_ENABLE_ZE
@@ -103,6 +109,8 @@ private:
     void init_resize_independent_objects();
     void reset_resize_independent_objects();
 
+    void init_memcpy();
+
 #ifdef CCL_ENABLE_ZE
     void init_gpu();
     void finalize_gpu();
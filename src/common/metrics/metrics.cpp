@@ -0,0 +1,259 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "common/comm/comm.hpp"
+#include "common/global/global.hpp"
+#include "common/metrics/metrics.hpp"
+#include "common/utils/yield.hpp"
+#include "exec/exec.hpp"
+#include "exec/thread/worker.hpp"
+#include "fusion/fusion.hpp"
+#include "sched/buffer/buffer_cache.hpp"
+#include "sched/cache/cache.hpp"
+
+namespace ccl {
+
+static constexpr double ns_per_usec = 1000.0;
+
+void latency_histogram::add(uint64_t value) {
+    counts[get_bucket_idx(value)]++;
+    total_count++;
+}
+
+void latency_histogram::merge(const latency_histogram& other) {
+    for (size_t idx = 0; idx < CCL_METRICS_HIST_BUCKET_COUNT; idx++) {
+        counts[idx] += other.counts[idx];
+    }
+    total_count += other.total_count;
+}
+
+uint64_t latency_histogram::get_percentile(double percentile) const {
+    if (!total_count) {
+        return 0;
+    }
+
+    size_t rank = std::max(size_t(1), size_t(std::ceil(percentile * total_count)));
+    size_t cumulative_count = 0;
+    for (size_t idx = 0; idx < CCL_METRICS_HIST_BUCKET_COUNT; idx++) {
+        cumulative_count += counts[idx];
+        if (cumulative_count >= rank) {
+            return get_bucket_upper_bound(idx);
+        }
+    }
+
+    return get_bucket_upper_bound(CCL_METRICS_HIST_BUCKET_COUNT - 1);
+}
+
+size_t latency_histogram::get_bucket_idx(uint64_t value) {
+    if (value < CCL_METRICS_HIST_SUB_BUCKET_COUNT) {
+        return value;
+    }
+
+    size_t shift = CCL_METRICS_HIST_SUB_BUCKET_SHIFT;
+    while ((value >> (shift + 1)) && (shift + 1 < CCL_METRICS_HIST_MAX_SHIFT)) {
+        shift++;
+    }
+
+    if (value >> (shift + 1)) {
+        /* too large value, account in the last bucket */
+        return CCL_METRICS_HIST_BUCKET_COUNT - 1;
+    }
+
+    size_t sub_idx = (value >> (shift - CCL_METRICS_HIST_SUB_BUCKET_SHIFT)) &
+                     (CCL_METRICS_HIST_SUB_BUCKET_COUNT - 1);
+    return CCL_METRICS_HIST_SUB_BUCKET_COUNT * (shift - CCL_METRICS_HIST_SUB_BUCKET_SHIFT + 1) +
+           sub_idx;
+}
+
+uint64_t latency_histogram::get_bucket_upper_bound(size_t idx) {
+    if (idx < CCL_METRICS_HIST_SUB_BUCKET_COUNT) {
+        return idx + 1;
+    }
+
+    size_t shift = idx / CCL_METRICS_HIST_SUB_BUCKET_COUNT - 1;
+    size_t sub_idx = idx % CCL_METRICS_HIST_SUB_BUCKET_COUNT;
+    return uint64_t(CCL_METRICS_HIST_SUB_BUCKET_COUNT + sub_idx + 1) << shift;
+}
+
+size_t metrics_collector::key_hasher::operator()(const key_t& key) const {
+    size_t hash = std::hash<const void*>()(key.algo);
+    hash ^= (size_t(key.comm_id) << 48) ^ (size_t(key.ctype) << 40) ^ key.size_bucket;
+    /* mix bits as shard is selected by the lowest ones */
+    hash ^= hash >> 29;
+    hash *= 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+void metrics_collector::value_t::merge(const value_t& other) {
+    if (!other.count) {
+        return;
+    }
+
+    min_ns = (count) ? std::min(min_ns, other.min_ns) : other.min_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+    count += other.count;
+    bytes += other.bytes;
+    sum_ns += other.sum_ns;
+    hist.merge(other.hist);
+}
+
+void metrics_collector::record(ccl_comm_id_t comm_id,
+                               ccl_coll_type ctype,
+                               const char* algo,
+                               size_t bytes,
+                               uint64_t time_ns) {
+    key_t key{ comm_id, ctype, algo, get_size_bucket(bytes) };
+    auto& shard = shards[key_hasher()(key) % CCL_METRICS_SHARD_COUNT];
+
+    std::lock_guard<ccl_spinlock> lock{ shard.guard };
+    auto& value = shard.table[key];
+    if (!value.count || time_ns < value.min_ns) {
+        value.min_ns = time_ns;
+    }
+    value.max_ns = std::max(value.max_ns, time_ns);
+    value.count++;
+    value.bytes += bytes;
+    value.sum_ns += time_ns;
+    value.hist.add(time_ns);
+}
+
+void metrics_collector::wait_pending_records() const {
+    while (pending_records.load()) {
+        ccl_yield(ccl::global_data::env().yield_type);
+    }
+}
+
+void metrics_collector::fill_colls(const ccl_comm* comm, ccl::v1::metrics& result) {
+    /* without comm the entries of different communicators are merged */
+    using coll_key_t = std::tuple<int, std::string, size_t>;
+    std::map<coll_key_t, value_t> colls;
+
+    for (auto& shard : shards) {
+        std::lock_guard<ccl_spinlock> lock{ shard.guard };
+        for (const auto& key_value : shard.table) {
+            const key_t& key = key_value.first;
+            if (comm && key.comm_id != comm->id()) {
+                continue;
+            }
+            coll_key_t coll_key(
+                key.ctype, (key.algo) ? std::string(key.algo) : std::string(), key.size_bucket);
+            colls[coll_key].merge(key_value.second);
+        }
+    }
+
+    for (const auto& key_value : colls) {
+        const value_t& value = key_value.second;
+
+        /* histogram buckets are coarse, keep percentiles within observed range */
+        auto get_percentile_usec = [&](double percentile) {
+            uint64_t time_ns = std::min(value.max_ns, value.hist.get_percentile(percentile));
+            return std::max(value.min_ns, time_ns) / ns_per_usec;
+        };
+
+        ccl::v1::coll_metrics coll{};
+        coll.coll_name =
+            ccl_coll_type_to_str(static_cast<ccl_coll_type>(std::get<0>(key_value.first)));
+        coll.algo_name = std::get<1>(key_value.first);
+        coll.size_bucket = std::get<2>(key_value.first);
+        coll.count = value.count;
+        coll.bytes = value.bytes;
+        coll.min_time_usec = value.min_ns / ns_per_usec;
+        coll.max_time_usec = value.max_ns / ns_per_usec;
+        coll.avg_time_usec = value.sum_ns / ns_per_usec / value.count;
+        coll.p50_time_usec = get_percentile_usec(0.5);
+        coll.p90_time_usec = get_percentile_usec(0.9);
+        coll.p99_time_usec = get_percentile_usec(0.99);
+
+        for (size_t idx = 0; idx < CCL_METRICS_HIST_BUCKET_COUNT; idx++) {
+            size_t count = value.hist.get_bucket_count(idx);
+            if (count) {
+                coll.latency_histogram.emplace_back(
+                    latency_histogram::get_bucket_upper_bound(idx) / ns_per_usec, count);
+            }
+        }
+
+        result.colls.push_back(coll);
+    }
+}
+
+ccl::v1::metrics metrics_collector::get(const ccl_comm* comm) {
+    ccl::v1::metrics result{};
+
+    auto& env = ccl::global_data::env();
+    result.transport = ccl::env_data::str_by_enum(ccl::env_data::atl_transport_names,
+                                                  env.atl_transport);
+
+    wait_pending_records();
+    fill_colls(comm, result);
+
+    auto& data = ccl::global_data::get();
+
+    if (data.sched_cache) {
+        result.sched_cache_hits = data.sched_cache->get_hit_count();
+        result.sched_cache_misses = data.sched_cache->get_miss_count();
+        result.sched_cache_evictions = data.sched_cache->get_eviction_count();
+    }
+
+    if (data.buffer_cache) {
+        auto stats = data.buffer_cache->get_stats();
+        result.buffer_cache_hits = stats.hit_count + stats.split_count;
+        result.buffer_cache_misses = stats.miss_count;
+    }
+
+    if (data.fusion_manager) {
+        result.fused_ops = data.fusion_manager->get_fused_ops();
+        result.fused_bytes = data.fusion_manager->get_fused_bytes();
+        result.fused_scheds = data.fusion_manager->get_fused_scheds();
+    }
+
+    if (data.executor) {
+        for (size_t idx = 0; idx < data.executor->get_worker_count(); idx++) {
+            uint64_t busy_time_ns =
+                data.executor->get_worker_stats(idx).busy_time_ns.load(std::memory_order_relaxed);
+            result.worker_busy_time_usec.push_back(busy_time_ns / ns_per_usec);
+        }
+    }
+
+    return result;
+}
+
+void metrics_collector::reset() {
+    wait_pending_records();
+    for (auto& shard : shards) {
+        std::lock_guard<ccl_spinlock> lock{ shard.guard };
+        shard.table.clear();
+    }
+}
+
+size_t metrics_collector::get_size_bucket(size_t bytes) {
+    if (!bytes) {
+        return 0;
+    }
+
+    size_t size_bucket = 1;
+    while (size_bucket < bytes) {
+        size_bucket <<= 1;
+    }
+    return size_bucket;
+}
+
+} // namespace ccl
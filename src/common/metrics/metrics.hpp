@@ -0,0 +1,141 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+#include "common/comm/comm_id_storage.hpp"
+#include "common/utils/spinlock.hpp"
+#include "oneapi/ccl/types.hpp"
+
+class ccl_comm;
+
+namespace ccl {
+
+/*
+   log-linear histogram: each power of two is split into 4 sub-buckets,
+   so relative error of reported percentiles is up to 25%
+*/
+#define CCL_METRICS_HIST_SUB_BUCKET_SHIFT (2)
+#define CCL_METRICS_HIST_SUB_BUCKET_COUNT (1 << CCL_METRICS_HIST_SUB_BUCKET_SHIFT)
+#define CCL_METRICS_HIST_MAX_SHIFT        (40) /* ~18 minutes in nanoseconds */
+#define CCL_METRICS_HIST_BUCKET_COUNT \
+    (CCL_METRICS_HIST_SUB_BUCKET_COUNT * \
+     (CCL_METRICS_HIST_MAX_SHIFT - CCL_METRICS_HIST_SUB_BUCKET_SHIFT + 1))
+
+#define CCL_METRICS_SHARD_COUNT (16)
+
+class latency_histogram {
+public:
+    void add(uint64_t value);
+    void merge(const latency_histogram& other);
+
+    /* upper bound of bucket which contains requested percentile, 0 if histogram is empty */
+    uint64_t get_percentile(double percentile) const;
+
+    size_t get_bucket_count(size_t idx) const {
+        return counts[idx];
+    }
+
+    static size_t get_bucket_idx(uint64_t value);
+    static uint64_t get_bucket_upper_bound(size_t idx);
+
+private:
+    size_t counts[CCL_METRICS_HIST_BUCKET_COUNT] = {};
+    size_t total_count = 0;
+};
+
+/*
+   collects latency and volume of collective operations
+   per communicator, collective type, selected algorithm and message size bucket,
+   records are made by worker threads on completion of collective
+   and are distributed between shards to avoid contention
+*/
+class metrics_collector {
+public:
+    metrics_collector() = default;
+    metrics_collector(const metrics_collector&) = delete;
+    metrics_collector& operator=(const metrics_collector&) = delete;
+
+    void record(ccl_comm_id_t comm_id,
+                ccl_coll_type ctype,
+                const char* algo,
+                size_t bytes,
+                uint64_t time_ns);
+
+    /*
+       record is made right after completion of request,
+       so it is announced in advance to let get/reset wait for it
+       and include every operation which is completed for user
+    */
+    void begin_record() {
+        pending_records.fetch_add(1);
+    }
+    void end_record() {
+        pending_records.fetch_sub(1);
+    }
+
+    /* metrics of single communicator if comm is set, otherwise of all communicators */
+    ccl::v1::metrics get(const ccl_comm* comm = nullptr);
+    void reset();
+
+    static size_t get_size_bucket(size_t bytes);
+
+private:
+    struct key_t {
+        ccl_comm_id_t comm_id;
+        ccl_coll_type ctype;
+        const char* algo; /* points to static string */
+        size_t size_bucket;
+
+        bool operator==(const key_t& other) const {
+            return comm_id == other.comm_id && ctype == other.ctype && algo == other.algo &&
+                   size_bucket == other.size_bucket;
+        }
+    };
+
+    struct key_hasher {
+        size_t operator()(const key_t& key) const;
+    };
+
+    struct value_t {
+        size_t count = 0;
+        size_t bytes = 0;
+        uint64_t sum_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+        latency_histogram hist;
+
+        void merge(const value_t& other);
+    };
+
+    struct shard_t {
+        ccl_spinlock guard{};
+        std::unordered_map<key_t, value_t, key_hasher> table;
+    };
+
+    void fill_colls(const ccl_comm* comm, ccl::v1::metrics& result);
+    void wait_pending_records() const;
+
+    shard_t shards[CCL_METRICS_SHARD_COUNT];
+    std::atomic<size_t> pending_records{ 0 };
+};
+
+} // namespace ccl
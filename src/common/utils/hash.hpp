@@ -15,6 +15,8 @@
 */
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <tuple>
 
 namespace ccl {
@@ -15,13 +15,27 @@
 */
 #include "common/log/log.hpp"
 #include "common/utils/memcpy.hpp"
+#include "comp/simd/simd_utils.hpp"
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <immintrin.h>
 
+/* how far ahead of current position source is prefetched by streaming copy */
+#define CCL_MEMCPY_PREFETCH_DISTANCE (2048)
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+#define CCL_MEMCPY_TARGET_ATTRIBUTE_avx2   __attribute__((target("avx2")))
+#define CCL_MEMCPY_TARGET_ATTRIBUTE_avx512 __attribute__((target("avx512f")))
+#else // CCL_AVX_TARGET_ATTRIBUTES
+#define CCL_MEMCPY_TARGET_ATTRIBUTE_avx2
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
 namespace ccl {
 
+static size_t nontemporal_threshold = CCL_MEMCPY_DEFAULT_NONTEMPORAL_THRESHOLD;
+
 __attribute__((__always_inline__)) inline int is_nts_supported() {
 #ifdef CCL_AVX_COMPILER
     static int is_avx_enabled = -1;
@@ -42,34 +56,29 @@ __attribute__((__always_inline__)) inline int is_nts_supported() {
 #endif // CCL_AVX_COMPILER
 }
 
-void memcpy(void *dst, const void *src, size_t size) {
-    std::copy((char *)(src), (char *)(src) + (size), (char *)(dst));
-}
-
-void memcpy_nontemporal(void *dst, const void *src, size_t size) {
-    char *d = (char *)dst;
-    const char *s = (const char *)src;
-    size_t n = size;
-
-    if (!is_nts_supported()) {
-        LOG_DEBUG("NTS-based memcpy is requested but not supported, use regular memcpy");
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+__attribute__((__always_inline__)) inline int is_avx512_nts_supported() {
+    static int is_avx512_enabled = -1;
+    if (is_avx512_enabled == -1) {
+        std::set<ccl_simd_impl_type> impl_types = ccl_simd_get_impl_types();
+        is_avx512_enabled = (impl_types.find(ccl_simd_avx512) != impl_types.end()) ? 1 : 0;
+        LOG_DEBUG("AVX-512 enabled: ", is_avx512_enabled);
     }
+    return is_avx512_enabled;
+}
+#endif // CCL_AVX_TARGET_ATTRIBUTES
 
 #ifdef CCL_AVX_COMPILER
-    if ((n <= 256) || !is_nts_supported()) {
-        memcpy(d, s, n);
-        return;
-    }
-
-    if (((uintptr_t)d) & 63) {
-        const uintptr_t t = 64 - (((uintptr_t)d) & 63);
-        memcpy(d, s, t);
-        d += t;
-        s += t;
-        n -= t;
-    }
 
+/* d must be 64 bytes aligned, n must be multiple of 64 */
+CCL_MEMCPY_TARGET_ATTRIBUTE_avx2 static void memcpy_nontemporal_avx2(char *d,
+                                                                     const char *s,
+                                                                     size_t n) {
     while (n >= 256) {
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 0), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 1), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 2), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 3), _MM_HINT_T0);
         __m256i ymm0 = _mm256_loadu_si256((__m256i const *)(s + (32 * 0)));
         __m256i ymm1 = _mm256_loadu_si256((__m256i const *)(s + (32 * 1)));
         __m256i ymm2 = _mm256_loadu_si256((__m256i const *)(s + (32 * 2)));
@@ -91,37 +100,141 @@ void memcpy_nontemporal(void *dst, const void *src, size_t size) {
         n -= 256;
     }
 
-    if (n & 128) {
+    while (n >= 64) {
         __m256i ymm0 = _mm256_loadu_si256((__m256i const *)(s + (32 * 0)));
         __m256i ymm1 = _mm256_loadu_si256((__m256i const *)(s + (32 * 1)));
-        __m256i ymm2 = _mm256_loadu_si256((__m256i const *)(s + (32 * 2)));
-        __m256i ymm3 = _mm256_loadu_si256((__m256i const *)(s + (32 * 3)));
         _mm256_stream_si256((__m256i *)(d + (32 * 0)), ymm0);
         _mm256_stream_si256((__m256i *)(d + (32 * 1)), ymm1);
-        _mm256_stream_si256((__m256i *)(d + (32 * 2)), ymm2);
-        _mm256_stream_si256((__m256i *)(d + (32 * 3)), ymm3);
-        d += 128;
-        s += 128;
+        d += 64;
+        s += 64;
+        n -= 64;
     }
+}
 
-    if (n & 64) {
-        __m256i ymm0 = _mm256_loadu_si256((__m256i const *)(s + (32 * 0)));
-        __m256i ymm1 = _mm256_loadu_si256((__m256i const *)(s + (32 * 1)));
-        _mm256_stream_si256((__m256i *)(d + (32 * 0)), ymm0);
-        _mm256_stream_si256((__m256i *)(d + (32 * 1)), ymm1);
+#endif // CCL_AVX_COMPILER
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+
+/* d must be 64 bytes aligned, n must be multiple of 64 */
+CCL_MEMCPY_TARGET_ATTRIBUTE_avx512 static void memcpy_nontemporal_avx512(char *d,
+                                                                         const char *s,
+                                                                         size_t n) {
+    while (n >= 256) {
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 0), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 1), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 2), _MM_HINT_T0);
+        _mm_prefetch(s + CCL_MEMCPY_PREFETCH_DISTANCE + (64 * 3), _MM_HINT_T0);
+        __m512i zmm0 = _mm512_loadu_si512((void const *)(s + (64 * 0)));
+        __m512i zmm1 = _mm512_loadu_si512((void const *)(s + (64 * 1)));
+        __m512i zmm2 = _mm512_loadu_si512((void const *)(s + (64 * 2)));
+        __m512i zmm3 = _mm512_loadu_si512((void const *)(s + (64 * 3)));
+        _mm512_stream_si512((__m512i *)(d + (64 * 0)), zmm0);
+        _mm512_stream_si512((__m512i *)(d + (64 * 1)), zmm1);
+        _mm512_stream_si512((__m512i *)(d + (64 * 2)), zmm2);
+        _mm512_stream_si512((__m512i *)(d + (64 * 3)), zmm3);
+        d += 256;
+        s += 256;
+        n -= 256;
+    }
+
+    while (n >= 64) {
+        __m512i zmm0 = _mm512_loadu_si512((void const *)(s + (64 * 0)));
+        _mm512_stream_si512((__m512i *)(d + (64 * 0)), zmm0);
         d += 64;
         s += 64;
+        n -= 64;
+    }
+}
+
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
+static void memcpy_regular(void *dst, const void *src, size_t size) {
+    std::copy((char *)(src), (char *)(src) + (size), (char *)(dst));
+}
+
+void memcpy(void *dst, const void *src, size_t size) {
+    memcpy_regular(dst, src, size);
+}
+
+void memcpy(void *dst, const void *src, size_t size, memcpy_strategy strategy) {
+    switch (strategy) {
+        case memcpy_strategy::regular: memcpy_regular(dst, src, size); break;
+        case memcpy_strategy::nontemporal: memcpy_nontemporal(dst, src, size); break;
+        case memcpy_strategy::automatic:
+            if (size >= nontemporal_threshold) {
+                memcpy_nontemporal(dst, src, size);
+            }
+            else {
+                memcpy_regular(dst, src, size);
+            }
+            break;
+        default: CCL_THROW("unexpected memcpy strategy ", static_cast<int>(strategy));
+    }
+}
+
+void memcpy_nontemporal(void *dst, const void *src, size_t size) {
+    char *d = (char *)dst;
+    const char *s = (const char *)src;
+    size_t n = size;
+
+    if (!is_nts_supported()) {
+        LOG_DEBUG("NTS-based memcpy is requested but not supported, use regular memcpy");
+    }
+
+#ifdef CCL_AVX_COMPILER
+    if ((n <= 256) || !is_nts_supported()) {
+        memcpy_regular(d, s, n);
+        return;
+    }
+
+    if (((uintptr_t)d) & 63) {
+        const uintptr_t t = 64 - (((uintptr_t)d) & 63);
+        memcpy_regular(d, s, t);
+        d += t;
+        s += t;
+        n -= t;
     }
 
-    if (n & 63) {
-        memcpy(d, s, (n & 63));
+    size_t tail = n & 63;
+    n -= tail;
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+    if (is_avx512_nts_supported()) {
+        memcpy_nontemporal_avx512(d, s, n);
+    }
+    else
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+    {
+        memcpy_nontemporal_avx2(d, s, n);
+    }
+
+    if (tail) {
+        memcpy_regular(d + n, s + n, tail);
     }
 
     _mm_sfence();
 
 #else // CCL_AVX_COMPILER
-    memcpy(d, s, n);
+    memcpy_regular(d, s, n);
 #endif // CCL_AVX_COMPILER
 }
 
+void memcpy_set_nontemporal_threshold(size_t threshold) {
+    LOG_DEBUG("memcpy nontemporal threshold: ", threshold);
+    nontemporal_threshold = threshold;
+}
+
+size_t memcpy_get_nontemporal_threshold() {
+    return nontemporal_threshold;
+}
+
+const char *memcpy_strategy_to_str(memcpy_strategy strategy) {
+    switch (strategy) {
+        case memcpy_strategy::regular: return "regular";
+        case memcpy_strategy::nontemporal: return "nontemporal";
+        case memcpy_strategy::automatic: return "automatic";
+        default: return "unknown";
+    }
+}
+
 } // namespace ccl
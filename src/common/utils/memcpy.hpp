@@ -17,13 +17,27 @@
 
 #include <cstddef>
 
+#define CCL_MEMCPY_DEFAULT_NONTEMPORAL_THRESHOLD (4 * 1024 * 1024)
+
 namespace ccl {
 
+/*
+   automatic selects strategy by size: copies smaller than nontemporal threshold
+   use regular stores, larger ones bypass cache through streaming stores
+*/
+enum class memcpy_strategy { regular, nontemporal, automatic };
+
+/* regular stores, destination stays in cache for callers that read it back */
 void memcpy(void* dst, const void* src, size_t size);
-void memcpy_nontemporal(void* dst, const void* src, size_t size)
-#if CCL_AVX_TARGET_ATTRIBUTES
-    __attribute__((target("avx2")))
-#endif // CCL_AVX_TARGET_ATTRIBUTES
-    ;
+
+void memcpy(void* dst, const void* src, size_t size, memcpy_strategy strategy);
+
+/* streaming stores with software prefetch of source, AVX-512 or AVX2 depending on CPU */
+void memcpy_nontemporal(void* dst, const void* src, size_t size);
+
+void memcpy_set_nontemporal_threshold(size_t threshold);
+size_t memcpy_get_nontemporal_threshold();
+
+const char* memcpy_strategy_to_str(memcpy_strategy strategy);
 
 } // namespace ccl
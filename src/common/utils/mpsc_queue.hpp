@@ -0,0 +1,89 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "common/log/log.hpp"
+#include "common/utils/utils.hpp"
+
+/*
+   lock-free intrusive multi-producer single-consumer queue
+
+   producers link elements through the T::*next_ptr member and publish them with a single CAS,
+   the consumer detaches the whole pending chain with one exchange and restores FIFO order,
+   so there is no ABA issue and no allocation per element
+*/
+template <class T, T* T::*next_ptr>
+class ccl_mpsc_queue {
+public:
+    ccl_mpsc_queue() {
+        CCL_UNUSED(padding);
+    }
+
+    ccl_mpsc_queue(const ccl_mpsc_queue& other) = delete;
+    ccl_mpsc_queue& operator=(const ccl_mpsc_queue& other) = delete;
+
+    /* can be called from any thread */
+    void push(T* elem) {
+        T* old_head = head.load(std::memory_order_relaxed);
+        do {
+            elem->*next_ptr = old_head;
+        } while (!head.compare_exchange_weak(
+            old_head, elem, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool empty() const {
+        return (head.load(std::memory_order_relaxed) == nullptr);
+    }
+
+    /* consumer only, calls fn for each pending elem in push order and returns number of elems */
+    template <class fn_t>
+    size_t drain(fn_t fn) {
+        if (empty())
+            return 0;
+
+        T* elem = head.exchange(nullptr, std::memory_order_acquire);
+
+        T* reversed = nullptr;
+        while (elem) {
+            T* next = elem->*next_ptr;
+            elem->*next_ptr = reversed;
+            reversed = elem;
+            elem = next;
+        }
+
+        size_t count = 0;
+        while (reversed) {
+            T* next = reversed->*next_ptr;
+            reversed->*next_ptr = nullptr;
+            fn(reversed);
+            reversed = next;
+            count++;
+        }
+        return count;
+    }
+
+    /* consumer only, drops pending elems */
+    void clear() {
+        drain([](T*) {});
+    }
+
+private:
+    std::atomic<T*> head{ nullptr };
+    char padding[CACHELINE_SIZE - sizeof(std::atomic<T*>)];
+};
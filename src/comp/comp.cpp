@@ -16,6 +16,7 @@
 #include "comp/bf16/bf16.hpp"
 #include "comp/comp.hpp"
 #include "comp/fp16/fp16.hpp"
+#include "comp/simd/simd.hpp"
 #include "common/log/log.hpp"
 #include "common/global/global.hpp"
 #include "common/utils/enums.hpp"
@@ -57,6 +58,9 @@
         } \
     } while (0)
 
+/* keeps accumulator tile of multi-input reduction in L1/L2 */
+#define CCL_COMP_REDUCE_MULTI_TILE_BYTES (32 * 1024)
+
 ccl::status ccl_comp_copy(const void* in_buf, void* out_buf, size_t bytes, bool use_nontemporal) {
     CCL_ASSERT(in_buf, "in_buf is null");
     CCL_ASSERT(out_buf, "out_buf is null");
@@ -83,6 +87,10 @@ ccl::status ccl_comp_reduce_regular(const void* in_buf,
         return ccl::status::success;
     }
 
+    if (ccl_simd_reduce(in_buf, in_count, inout_buf, dtype.idx(), reduction)) {
+        return ccl::status::success;
+    }
+
     size_t i;
     switch (dtype.idx()) {
         case ccl::datatype::int8: CCL_REDUCE(int8_t); break;
@@ -186,7 +194,8 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
 }
 
 ccl::status ccl_comp_batch_reduce(const void* in_buf,
-                                  const std::vector<size_t>& offsets,
+                                  const size_t* offsets,
+                                  size_t offset_count,
                                   size_t in_count,
                                   void* inout_buf,
                                   size_t* out_count,
@@ -203,7 +212,7 @@ ccl::status ccl_comp_batch_reduce(const void* in_buf,
         /* inout_buf => inout_buffer + offsets[0] */
         ccl_convert_bf16_to_fp32_arrays(inout_buf, acc, in_count);
 
-        for (size_t i = 1; i < offsets.size(); i++) {
+        for (size_t i = 1; i < offset_count; i++) {
             ccl_convert_bf16_to_fp32_arrays(
                 (char*)in_buf + dtype.size() * offsets[i], tmp, in_count);
             ccl_comp_reduce_regular(tmp,
@@ -219,7 +228,7 @@ ccl::status ccl_comp_batch_reduce(const void* in_buf,
         ccl_convert_fp32_to_bf16_arrays(acc, inout_buf, in_count);
     }
     else {
-        for (size_t i = 1; i < offsets.size(); i++) {
+        for (size_t i = 1; i < offset_count; i++) {
             ccl_comp_reduce_regular((char*)in_buf + dtype.size() * offsets[i],
                                     in_count,
                                     inout_buf,
@@ -234,6 +243,99 @@ ccl::status ccl_comp_batch_reduce(const void* in_buf,
     return ccl::status::success;
 }
 
+static void ccl_comp_reduce_multi_copy(ccl_sched* sched,
+                                       const void* in_buf,
+                                       void* out_buf,
+                                       size_t bytes) {
+#ifdef CCL_ENABLE_SYCL
+    ccl_stream* stream = (ccl_stream*)sched->coll_param.stream;
+    if (stream) {
+        sycl::queue* q = stream->get_native_stream(sched->queue->get_idx());
+        CCL_THROW_IF_NOT(q, "null sycl queue");
+        q->memcpy(out_buf, in_buf, bytes).wait();
+        return;
+    }
+#endif // CCL_ENABLE_SYCL
+    ccl_comp_copy(in_buf, out_buf, bytes);
+}
+
+ccl::status ccl_comp_reduce_multi(ccl_sched* sched,
+                                  const void* const* in_bufs,
+                                  size_t in_buf_count,
+                                  size_t in_count,
+                                  void* out_buf,
+                                  size_t* out_count,
+                                  const ccl_datatype& dtype,
+                                  ccl::reduction reduction,
+                                  ccl::reduction_fn reduction_fn,
+                                  const ccl::fn_context* context) {
+    CCL_THROW_IF_NOT(in_bufs && in_buf_count, "unexpected input buffers");
+
+    if (!in_count) {
+        return ccl::status::success;
+    }
+
+    size_t dtype_size = dtype.size();
+
+    /* if output is one of inputs then it already holds its contribution */
+    size_t acc_idx = 0;
+    bool is_inplace = false;
+    for (size_t idx = 0; idx < in_buf_count; idx++) {
+        if (in_bufs[idx] == out_buf) {
+            acc_idx = idx;
+            is_inplace = true;
+            break;
+        }
+    }
+
+    /*
+       custom reduction gets offset of the whole buffer in its context
+       and device buffers are staged through host on each call,
+       so process them as single tile
+    */
+    bool use_tiles = (reduction != ccl::reduction::custom);
+#ifdef CCL_ENABLE_SYCL
+    if (sched->coll_param.stream) {
+        use_tiles = false;
+    }
+#endif // CCL_ENABLE_SYCL
+
+    size_t tile_count = in_count;
+    if (use_tiles) {
+        tile_count = std::max(CCL_COMP_REDUCE_MULTI_TILE_BYTES / dtype_size, size_t(1));
+    }
+
+    for (size_t tile_offset = 0; tile_offset < in_count; tile_offset += tile_count) {
+        size_t count = std::min(tile_count, in_count - tile_offset);
+        size_t byte_offset = tile_offset * dtype_size;
+        char* out_tile = static_cast<char*>(out_buf) + byte_offset;
+
+        if (!is_inplace) {
+            ccl_comp_reduce_multi_copy(sched,
+                                       static_cast<const char*>(in_bufs[acc_idx]) + byte_offset,
+                                       out_tile,
+                                       count * dtype_size);
+        }
+
+        for (size_t idx = 0; idx < in_buf_count; idx++) {
+            if (idx == acc_idx) {
+                continue;
+            }
+            ccl_comp_reduce(sched,
+                            static_cast<const char*>(in_bufs[idx]) + byte_offset,
+                            count,
+                            out_tile,
+                            out_count,
+                            dtype,
+                            reduction,
+                            reduction_fn,
+                            context);
+        }
+    }
+
+    return ccl::status::success;
+}
+
 const char* ccl_reduction_to_str(ccl::reduction type) {
     switch (type) {
         case ccl::reduction::sum: return "sum";
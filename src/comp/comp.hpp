@@ -36,7 +36,8 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const ccl::fn_context* context = nullptr);
 
 ccl::status ccl_comp_batch_reduce(const void* in_buf,
-                                  const std::vector<size_t>& offsets,
+                                  const size_t* offsets,
+                                  size_t offset_count,
                                   size_t in_count,
                                   void* inout_buf,
                                   size_t* out_count,
@@ -48,4 +49,19 @@ ccl::status ccl_comp_batch_reduce(const void* in_buf,
                                   float* tmp,
                                   float* acc);
 
+/*
+   out_buf[i] = reduction(in_bufs[0][i], ..., in_bufs[in_buf_count - 1][i]),
+   out_buf may alias one of in_bufs, in this case copy of that input is skipped
+*/
+ccl::status ccl_comp_reduce_multi(ccl_sched* sched,
+                                  const void* const* in_bufs,
+                                  size_t in_buf_count,
+                                  size_t in_count,
+                                  void* out_buf,
+                                  size_t* out_count,
+                                  const ccl_datatype& dtype,
+                                  ccl::reduction reduction,
+                                  ccl::reduction_fn reduction_fn,
+                                  const ccl::fn_context* context = nullptr);
+
 const char* ccl_reduction_to_str(ccl::reduction type);
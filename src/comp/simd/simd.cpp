@@ -0,0 +1,320 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <immintrin.h>
+
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+#include "comp/simd/simd.hpp"
+
+std::map<ccl_simd_impl_type, std::string> simd_impl_names = {
+    std::make_pair(ccl_simd_scalar, "scalar"),
+    std::make_pair(ccl_simd_avx2, "avx2"),
+    std::make_pair(ccl_simd_avx512, "avx512")
+};
+
+#define CCL_SIMD_DTYPE_COUNT     (static_cast<int>(ccl::datatype::bfloat16) + 1)
+#define CCL_SIMD_REDUCTION_COUNT (static_cast<int>(ccl::reduction::max) + 1)
+
+/* scalar tails, must produce the same result as CCL_REDUCE in comp.cpp */
+
+template <class T>
+__attribute__((__always_inline__)) inline void ccl_simd_tail_sum(const T* in, T* inout, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        inout[i] += in[i];
+}
+
+template <class T>
+__attribute__((__always_inline__)) inline void ccl_simd_tail_prod(const T* in, T* inout, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        inout[i] *= in[i];
+}
+
+template <class T>
+__attribute__((__always_inline__)) inline void ccl_simd_tail_min(const T* in, T* inout, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        inout[i] = std::min(in[i], inout[i]);
+}
+
+template <class T>
+__attribute__((__always_inline__)) inline void ccl_simd_tail_max(const T* in, T* inout, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        inout[i] = std::max(in[i], inout[i]);
+}
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+
+#define SIMD_AVX2_ATTRS   "avx2"
+#define SIMD_AVX512_ATTRS "avx512f,avx512bw,avx512dq"
+
+#define SIMD_TARGET_ATTRIBUTE_avx2   __attribute__((target(SIMD_AVX2_ATTRS)))
+#define SIMD_TARGET_ATTRIBUTE_avx512 __attribute__((target(SIMD_AVX512_ATTRS)))
+#define SIMD_INLINE_TARGET_ATTRIBUTE_avx2 \
+    __attribute__((__always_inline__, target(SIMD_AVX2_ATTRS))) inline
+#define SIMD_INLINE_TARGET_ATTRIBUTE_avx512 \
+    __attribute__((__always_inline__, target(SIMD_AVX512_ATTRS))) inline
+
+#define CCL_SIMD_BYTES_avx2   32
+#define CCL_SIMD_BYTES_avx512 64
+
+/* unaligned loads/stores, integer types share the same vector type */
+
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 __m256 ccl_simd_load_avx2(const float* p) {
+    return _mm256_loadu_ps(p);
+}
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 __m256d ccl_simd_load_avx2(const double* p) {
+    return _mm256_loadu_pd(p);
+}
+template <class T>
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 __m256i ccl_simd_load_avx2(const T* p) {
+    return _mm256_loadu_si256((const __m256i*)p);
+}
+
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 void ccl_simd_store_avx2(float* p, __m256 v) {
+    _mm256_storeu_ps(p, v);
+}
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 void ccl_simd_store_avx2(double* p, __m256d v) {
+    _mm256_storeu_pd(p, v);
+}
+template <class T>
+SIMD_INLINE_TARGET_ATTRIBUTE_avx2 void ccl_simd_store_avx2(T* p, __m256i v) {
+    _mm256_storeu_si256((__m256i*)p, v);
+}
+
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 __m512 ccl_simd_load_avx512(const float* p) {
+    return _mm512_loadu_ps(p);
+}
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 __m512d ccl_simd_load_avx512(const double* p) {
+    return _mm512_loadu_pd(p);
+}
+template <class T>
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 __m512i ccl_simd_load_avx512(const T* p) {
+    return _mm512_loadu_si512((const void*)p);
+}
+
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 void ccl_simd_store_avx512(float* p, __m512 v) {
+    _mm512_storeu_ps(p, v);
+}
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 void ccl_simd_store_avx512(double* p, __m512d v) {
+    _mm512_storeu_pd(p, v);
+}
+template <class T>
+SIMD_INLINE_TARGET_ATTRIBUTE_avx512 void ccl_simd_store_avx512(T* p, __m512i v) {
+    _mm512_storeu_si512((void*)p, v);
+}
+
+/*
+   defines ccl_simd_reduce_<op>_<type>_<impl_type>,
+   the main loop is unrolled by 2 vectors to keep
+   two independent load/op/store chains in flight,
+   vec_op takes inout first: min/max instructions return the second operand
+   if either one is NaN or both are zeros, this matches std::min/max(in, inout)
+*/
+#define CCL_SIMD_DEFINE_REDUCE_FUNC(impl_type, type, op, vec_op) \
+\
+    SIMD_TARGET_ATTRIBUTE_##impl_type void ccl_simd_reduce_##op##_##type##_##impl_type( \
+        const void* in_buf, void* inout_buf, size_t count) { \
+        const type* in = (const type*)in_buf; \
+        type* inout = (type*)inout_buf; \
+        constexpr size_t width = CCL_SIMD_BYTES_##impl_type / sizeof(type); \
+        size_t i = 0; \
+        for (; i + 2 * width <= count; i += 2 * width) { \
+            auto a0 = ccl_simd_load_##impl_type(inout + i); \
+            auto a1 = ccl_simd_load_##impl_type(inout + i + width); \
+            auto b0 = ccl_simd_load_##impl_type(in + i); \
+            auto b1 = ccl_simd_load_##impl_type(in + i + width); \
+            ccl_simd_store_##impl_type(inout + i, vec_op(a0, b0)); \
+            ccl_simd_store_##impl_type(inout + i + width, vec_op(a1, b1)); \
+        } \
+        for (; i + width <= count; i += width) { \
+            auto a = ccl_simd_load_##impl_type(inout + i); \
+            auto b = ccl_simd_load_##impl_type(in + i); \
+            ccl_simd_store_##impl_type(inout + i, vec_op(a, b)); \
+        } \
+        ccl_simd_tail_##op<type>(in + i, inout + i, count - i); \
+    }
+
+/* AVX2: no 8-bit multiplication, no 64-bit multiplication/min/max */
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int8_t, sum, _mm256_add_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int8_t, min, _mm256_min_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int8_t, max, _mm256_max_epi8);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint8_t, sum, _mm256_add_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint8_t, min, _mm256_min_epu8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint8_t, max, _mm256_max_epu8);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int16_t, sum, _mm256_add_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int16_t, prod, _mm256_mullo_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int16_t, min, _mm256_min_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int16_t, max, _mm256_max_epi16);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint16_t, sum, _mm256_add_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint16_t, prod, _mm256_mullo_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint16_t, min, _mm256_min_epu16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint16_t, max, _mm256_max_epu16);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int32_t, sum, _mm256_add_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int32_t, prod, _mm256_mullo_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int32_t, min, _mm256_min_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int32_t, max, _mm256_max_epi32);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint32_t, sum, _mm256_add_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint32_t, prod, _mm256_mullo_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint32_t, min, _mm256_min_epu32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint32_t, max, _mm256_max_epu32);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, int64_t, sum, _mm256_add_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, uint64_t, sum, _mm256_add_epi64);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, float, sum, _mm256_add_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, float, prod, _mm256_mul_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, float, min, _mm256_min_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, float, max, _mm256_max_ps);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, double, sum, _mm256_add_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, double, prod, _mm256_mul_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, double, min, _mm256_min_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx2, double, max, _mm256_max_pd);
+
+/* AVX512: no 8-bit multiplication */
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int8_t, sum, _mm512_add_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int8_t, min, _mm512_min_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int8_t, max, _mm512_max_epi8);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint8_t, sum, _mm512_add_epi8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint8_t, min, _mm512_min_epu8);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint8_t, max, _mm512_max_epu8);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int16_t, sum, _mm512_add_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int16_t, prod, _mm512_mullo_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int16_t, min, _mm512_min_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int16_t, max, _mm512_max_epi16);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint16_t, sum, _mm512_add_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint16_t, prod, _mm512_mullo_epi16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint16_t, min, _mm512_min_epu16);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint16_t, max, _mm512_max_epu16);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int32_t, sum, _mm512_add_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int32_t, prod, _mm512_mullo_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int32_t, min, _mm512_min_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int32_t, max, _mm512_max_epi32);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint32_t, sum, _mm512_add_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint32_t, prod, _mm512_mullo_epi32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint32_t, min, _mm512_min_epu32);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint32_t, max, _mm512_max_epu32);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int64_t, sum, _mm512_add_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int64_t, prod, _mm512_mullo_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int64_t, min, _mm512_min_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, int64_t, max, _mm512_max_epi64);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint64_t, sum, _mm512_add_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint64_t, prod, _mm512_mullo_epi64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint64_t, min, _mm512_min_epu64);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, uint64_t, max, _mm512_max_epu64);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, float, sum, _mm512_add_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, float, prod, _mm512_mul_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, float, min, _mm512_min_ps);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, float, max, _mm512_max_ps);
+
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, double, sum, _mm512_add_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, double, prod, _mm512_mul_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, double, min, _mm512_min_pd);
+CCL_SIMD_DEFINE_REDUCE_FUNC(avx512, double, max, _mm512_max_pd);
+
+#define CCL_SIMD_FN(impl_type, type, op) &ccl_simd_reduce_##op##_##type##_##impl_type
+
+#define CCL_SIMD_ROW(impl_type, type) \
+    { \
+        CCL_SIMD_FN(impl_type, type, sum), CCL_SIMD_FN(impl_type, type, prod), \
+            CCL_SIMD_FN(impl_type, type, min), CCL_SIMD_FN(impl_type, type, max) \
+    }
+
+#define CCL_SIMD_ROW_NO_PROD(impl_type, type) \
+    { \
+        CCL_SIMD_FN(impl_type, type, sum), nullptr, CCL_SIMD_FN(impl_type, type, min), \
+            CCL_SIMD_FN(impl_type, type, max) \
+    }
+
+#define CCL_SIMD_ROW_SUM_ONLY(impl_type, type) \
+    { CCL_SIMD_FN(impl_type, type, sum), nullptr, nullptr, nullptr }
+
+#define CCL_SIMD_ROW_EMPTY { nullptr, nullptr, nullptr, nullptr }
+
+/* indexed by [ccl::datatype][ccl::reduction], float16 and bfloat16 have own kernels */
+
+static const ccl_simd_reduce_fn
+    avx2_reduce_table[CCL_SIMD_DTYPE_COUNT][CCL_SIMD_REDUCTION_COUNT] = {
+    CCL_SIMD_ROW_NO_PROD(avx2, int8_t),    CCL_SIMD_ROW_NO_PROD(avx2, uint8_t),
+    CCL_SIMD_ROW(avx2, int16_t),           CCL_SIMD_ROW(avx2, uint16_t),
+    CCL_SIMD_ROW(avx2, int32_t),           CCL_SIMD_ROW(avx2, uint32_t),
+    CCL_SIMD_ROW_SUM_ONLY(avx2, int64_t),  CCL_SIMD_ROW_SUM_ONLY(avx2, uint64_t),
+    CCL_SIMD_ROW_EMPTY /* float16 */,      CCL_SIMD_ROW(avx2, float),
+    CCL_SIMD_ROW(avx2, double),            CCL_SIMD_ROW_EMPTY /* bfloat16 */
+};
+
+static const ccl_simd_reduce_fn
+    avx512_reduce_table[CCL_SIMD_DTYPE_COUNT][CCL_SIMD_REDUCTION_COUNT] = {
+    CCL_SIMD_ROW_NO_PROD(avx512, int8_t),  CCL_SIMD_ROW_NO_PROD(avx512, uint8_t),
+    CCL_SIMD_ROW(avx512, int16_t),         CCL_SIMD_ROW(avx512, uint16_t),
+    CCL_SIMD_ROW(avx512, int32_t),         CCL_SIMD_ROW(avx512, uint32_t),
+    CCL_SIMD_ROW(avx512, int64_t),         CCL_SIMD_ROW(avx512, uint64_t),
+    CCL_SIMD_ROW_EMPTY /* float16 */,      CCL_SIMD_ROW(avx512, float),
+    CCL_SIMD_ROW(avx512, double),          CCL_SIMD_ROW_EMPTY /* bfloat16 */
+};
+
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
+ccl_simd_reduce_fn ccl_simd_get_reduce_fn(ccl_simd_impl_type impl_type,
+                                          ccl::datatype dtype,
+                                          ccl::reduction reduction) {
+    int dtype_idx = static_cast<int>(dtype);
+    int reduction_idx = static_cast<int>(reduction);
+
+    if (dtype_idx < 0 || dtype_idx >= CCL_SIMD_DTYPE_COUNT || reduction_idx < 0 ||
+        reduction_idx >= CCL_SIMD_REDUCTION_COUNT) {
+        return nullptr;
+    }
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+    if (impl_type == ccl_simd_avx512)
+        return avx512_reduce_table[dtype_idx][reduction_idx];
+    else if (impl_type == ccl_simd_avx2)
+        return avx2_reduce_table[dtype_idx][reduction_idx];
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
+    return nullptr;
+}
+
+bool ccl_simd_reduce(const void* in_buf,
+                     size_t in_count,
+                     void* inout_buf,
+                     ccl::datatype dtype,
+                     ccl::reduction reduction) {
+    ccl_simd_reduce_fn fn =
+        ccl_simd_get_reduce_fn(ccl::global_data::env().simd_impl_type, dtype, reduction);
+
+    if (!fn)
+        return false;
+
+    fn(in_buf, inout_buf, in_count);
+    return true;
+}
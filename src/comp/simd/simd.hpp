@@ -0,0 +1,37 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "comp/simd/simd_utils.hpp"
+#include "oneapi/ccl/types.hpp"
+
+typedef void (*ccl_simd_reduce_fn)(const void* in_buf, void* inout_buf, size_t count);
+
+/* returns nullptr if there is no vector kernel for the requested combination */
+ccl_simd_reduce_fn ccl_simd_get_reduce_fn(ccl_simd_impl_type impl_type,
+                                          ccl::datatype dtype,
+                                          ccl::reduction reduction);
+
+/*
+   inout_buf[i] = reduction(in_buf[i], inout_buf[i]) using
+   kernel of globally selected SIMD impl type,
+   returns false if caller should fallback to scalar reduction
+*/
+bool ccl_simd_reduce(const void* in_buf,
+                     size_t in_count,
+                     void* inout_buf,
+                     ccl::datatype dtype,
+                     ccl::reduction reduction);
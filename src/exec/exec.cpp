@@ -19,6 +19,7 @@
 #include "exec/thread/service_worker.hpp"
 #include "exec/thread/worker.hpp"
 #include "common/env/env.hpp"
+#include "sched/buffer/buffer_cache.hpp"
 #include "sched/extra_sched.hpp"
 
 size_t ccl_executor::get_worker_idx_by_sched_id(ccl_sched* sched) {
@@ -112,10 +113,12 @@ void ccl_executor::start_workers() {
             LOG_DEBUG("create service worker");
             workers.emplace_back(new ccl_service_worker(idx,
                                                         create_sched_queue(idx, ep_per_worker),
+                                                        &helper_queue,
                                                         *ccl::global_data::get().fusion_manager));
         }
         else {
-            workers.emplace_back(new ccl_worker(idx, create_sched_queue(idx, ep_per_worker)));
+            workers.emplace_back(
+                new ccl_worker(idx, create_sched_queue(idx, ep_per_worker), &helper_queue));
         }
 
         if (env.worker_offload) {
@@ -123,6 +126,12 @@ void ccl_executor::start_workers() {
             size_t mem_affinity =
                 env.worker_mem_affinity[get_local_proc_idx() * worker_count + idx];
 
+            if (env.worker_mem_affinity[get_local_proc_idx() * worker_count + idx] !=
+                CCL_UNDEFINED_NUMA_NODE) {
+                /* keep scratch buffers of worker on its NUMA node */
+                ccl::global_data::get().buffer_cache->set_numa_node(idx, int(mem_affinity));
+            }
+
             CCL_THROW_IF_NOT(
                 workers.back()->start(cpu_affinity, mem_affinity) == ccl::status::success,
                 "failed to start worker # ",
@@ -161,6 +170,8 @@ ccl_executor::~ccl_executor() {
                 LOG_DEBUG("stopped worker # ", idx);
         }
 
+        LOG_INFO("worker # ", idx, " stats: ", workers[idx]->get_stats().to_string());
+
         while (!workers[idx]->can_reset()) {
             ccl_yield(ccl::global_data::env().yield_type);
         }
@@ -323,6 +334,22 @@ size_t ccl_executor::get_worker_count() const {
     return workers.size();
 }
 
+const ccl_worker_stats& ccl_executor::get_worker_stats(size_t idx) const {
+    CCL_THROW_IF_NOT(idx < workers.size(), "unexpected worker idx ", idx);
+    return workers[idx]->get_stats();
+}
+
+void ccl_executor::post_helper_task(const std::shared_ptr<ccl_helper_task>& task) {
+    helper_queue.add(task);
+
+    /* wake up sleeping workers to steal tiles */
+    if (ccl::global_data::env().worker_wait) {
+        for (auto& worker : workers) {
+            worker->wait.notify();
+        }
+    }
+}
+
 void ccl_executor::update_wait_condition(size_t idx,
                                          ccl_base_thread::wait_data::update_type type,
                                          size_t delta) {
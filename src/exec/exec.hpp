@@ -19,6 +19,7 @@
 #include "coll/coll.hpp"
 #include "common/global/global.hpp"
 #include "common/request/request.hpp"
+#include "exec/helper_task.hpp"
 #include "exec/thread/listener.hpp"
 #include "sched/extra_sched.hpp"
 #include "internal_types.hpp"
@@ -27,6 +28,7 @@
 #include <vector>
 
 class ccl_worker;
+struct ccl_worker_stats;
 class ccl_service_worker;
 class ccl_master_sched;
 class ccl_extra_sched;
@@ -75,10 +77,13 @@ public:
         return workers_started;
     };
     size_t get_worker_count() const;
+    const ccl_worker_stats& get_worker_stats(size_t idx) const;
     void update_wait_condition(size_t idx,
                                ccl_base_thread::wait_data::update_type type,
                                size_t delta);
 
+    void post_helper_task(const std::shared_ptr<ccl_helper_task>& task);
+
     // TODO: Rework to support listener
     //    ccl::status create_listener(ccl_resize_fn_t resize_func);
     void update_workers();
@@ -104,6 +109,8 @@ private:
     void do_work();
     void set_local_coord(int proc_idx, int proc_count);
 
+    /* declared before workers to outlive them */
+    ccl_helper_task_queue helper_queue;
     std::vector<std::unique_ptr<ccl_worker>> workers;
     // TODO: Rework to support listener
     //  std::unique_ptr<ccl_listener> listener;
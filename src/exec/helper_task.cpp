@@ -0,0 +1,129 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+#include "exec/exec.hpp"
+#include "exec/helper_task.hpp"
+
+#include <algorithm>
+
+ccl_helper_task::ccl_helper_task(size_t count, size_t tile_count, range_fn_t fn)
+        : count(count),
+          tile_count(tile_count),
+          tile_elem_count((count + tile_count - 1) / tile_count),
+          fn(std::move(fn)),
+          next_tile_idx(0),
+          completed_tile_count(0) {
+    CCL_THROW_IF_NOT(count && tile_count, "unexpected count ", count, ", tile_count ", tile_count);
+}
+
+bool ccl_helper_task::run_tile() {
+    size_t tile_idx = next_tile_idx.fetch_add(1, std::memory_order_acq_rel);
+    if (tile_idx >= tile_count) {
+        return false;
+    }
+
+    size_t offset = tile_idx * tile_elem_count;
+    if (offset < count) {
+        fn(offset, std::min(tile_elem_count, count - offset));
+    }
+
+    completed_tile_count.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool ccl_helper_task::progress() {
+    while (run_tile()) {
+    }
+    return is_completed();
+}
+
+bool ccl_helper_task::is_completed() const {
+    return (completed_tile_count.load(std::memory_order_acquire) == tile_count);
+}
+
+void ccl_helper_task::cancel() {
+    size_t claimed_tile_count =
+        std::min(next_tile_idx.exchange(tile_count, std::memory_order_acq_rel), tile_count);
+    while (completed_tile_count.load(std::memory_order_acquire) < claimed_tile_count) {
+        ccl_yield(ccl::global_data::env().yield_type);
+    }
+}
+
+void ccl_helper_task_queue::add(const std::shared_ptr<ccl_helper_task>& task) {
+    std::lock_guard<ccl_spinlock> lock{ guard };
+    tasks.push_back(task);
+    task_count.store(tasks.size(), std::memory_order_relaxed);
+}
+
+void ccl_helper_task_queue::remove(const std::shared_ptr<ccl_helper_task>& task) {
+    std::lock_guard<ccl_spinlock> lock{ guard };
+    auto it = std::find(tasks.begin(), tasks.end(), task);
+    if (it != tasks.end()) {
+        tasks.erase(it);
+    }
+    task_count.store(tasks.size(), std::memory_order_relaxed);
+}
+
+size_t ccl_helper_task_queue::process(size_t max_tiles) {
+    size_t tile_count = 0;
+
+    while ((tile_count < max_tiles) && !empty()) {
+        std::shared_ptr<ccl_helper_task> task;
+        {
+            std::lock_guard<ccl_spinlock> lock{ guard };
+            if (tasks.empty()) {
+                break;
+            }
+            task = tasks.front();
+        }
+
+        if (task->run_tile()) {
+            tile_count++;
+        }
+        else {
+            /* all tiles are claimed, owner will detect completion */
+            remove(task);
+        }
+    }
+
+    return tile_count;
+}
+
+std::shared_ptr<ccl_helper_task> ccl_post_helper_task(size_t count,
+                                                      size_t dtype_size,
+                                                      ccl_helper_task::range_fn_t fn) {
+    auto& env = ccl::global_data::env();
+    size_t bytes = count * dtype_size;
+
+    if (!env.worker_helper_threshold || (bytes < env.worker_helper_threshold) ||
+        !env.worker_offload) {
+        return nullptr;
+    }
+
+    ccl_executor* executor = ccl::global_data::get().executor.get();
+    if (!executor || (executor->get_worker_count() < 2)) {
+        return nullptr;
+    }
+
+    size_t tile_count = std::max(bytes / CCL_HELPER_TASK_TILE_BYTES, size_t(1));
+    auto task = std::make_shared<ccl_helper_task>(count, tile_count, std::move(fn));
+
+    LOG_DEBUG("post helper task: bytes ", bytes, ", tile_count ", tile_count);
+    executor->post_helper_task(task);
+
+    return task;
+}
@@ -0,0 +1,94 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/utils/spinlock.hpp"
+#include "common/utils/utils.hpp"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+
+#define CCL_HELPER_TASK_TILE_BYTES         (256 * 1024)
+#define CCL_HELPER_TASK_MAX_TILES_PER_ITER (16)
+
+/*
+   local copy or reduction over large buffer split into tiles,
+   tiles are executed by owner entry and stolen by idle workers
+*/
+class ccl_helper_task {
+public:
+    /* processes elements [offset, offset + count) */
+    using range_fn_t = std::function<void(size_t offset, size_t count)>;
+
+    ccl_helper_task() = delete;
+    ccl_helper_task(const ccl_helper_task& other) = delete;
+    ccl_helper_task& operator=(const ccl_helper_task& other) = delete;
+
+    ccl_helper_task(size_t count, size_t tile_count, range_fn_t fn);
+
+    /* claims and executes single tile, returns false if there are no unclaimed tiles */
+    bool run_tile();
+
+    /* executes remaining tiles on calling thread, returns true if all tiles are completed */
+    bool progress();
+
+    bool is_completed() const;
+
+    /* prevents claiming of remaining tiles and waits completion of already claimed ones */
+    void cancel();
+
+private:
+    const size_t count;
+    const size_t tile_count;
+    const size_t tile_elem_count;
+    const range_fn_t fn;
+
+    alignas(CACHELINE_SIZE) std::atomic<size_t> next_tile_idx;
+    alignas(CACHELINE_SIZE) std::atomic<size_t> completed_tile_count;
+};
+
+class ccl_helper_task_queue {
+public:
+    ccl_helper_task_queue() : task_count(0) {}
+    ccl_helper_task_queue(const ccl_helper_task_queue& other) = delete;
+    ccl_helper_task_queue& operator=(const ccl_helper_task_queue& other) = delete;
+
+    void add(const std::shared_ptr<ccl_helper_task>& task);
+
+    /* executes up to max_tiles tiles of posted tasks, returns number of executed tiles */
+    size_t process(size_t max_tiles);
+
+    bool empty() const {
+        return (task_count.load(std::memory_order_relaxed) == 0);
+    }
+
+private:
+    void remove(const std::shared_ptr<ccl_helper_task>& task);
+
+    ccl_spinlock guard;
+    std::deque<std::shared_ptr<ccl_helper_task>> tasks;
+    std::atomic<size_t> task_count;
+};
+
+/*
+   posts task to worker pool if count elements of dtype_size
+   are worth to be processed in parallel, returns nullptr otherwise
+*/
+std::shared_ptr<ccl_helper_task> ccl_post_helper_task(size_t count,
+                                                      size_t dtype_size,
+                                                      ccl_helper_task::range_fn_t fn);
@@ -54,8 +54,7 @@ ccl::status ccl_base_thread::stop() {
     should_stop = true;
 
     if (ccl::global_data::env().worker_wait) {
-        std::unique_lock<std::mutex> lock(wait.mtx);
-        wait.var.notify_one();
+        wait.notify();
     }
 
     while (started.load(std::memory_order_relaxed)) {
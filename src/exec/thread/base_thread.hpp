@@ -16,11 +16,11 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
+#include <chrono>
 #include <pthread.h>
 
 #include "common/log/log.hpp"
+#include "common/utils/futex.hpp"
 #include "internal_types.hpp"
 
 class ccl_base_thread {
@@ -75,20 +75,66 @@ public:
     std::atomic<bool> should_stop;
     std::atomic<bool> started;
 
-    struct wait_data {
-        std::mutex mtx;
-        std::condition_variable var;
+    static uint64_t get_time_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
 
+    struct wait_data {
         /*
            wakeup condition
            for worker threads value == active_op_count
            so wakeup will happen if value is > 0
         */
-        size_t value;
+        std::atomic<size_t> value;
+
+        /* futex word, changed on every notify so sleeping thread can't miss it */
+        std::atomic<uint32_t> seq{ 0 };
+        std::atomic<bool> is_sleeping{ false };
+
+        /* time when futex wake was issued, to measure wake latency */
+        std::atomic<uint64_t> wake_time_ns{ 0 };
 
         enum update_type { increment, decrement };
 
         wait_data(size_t value) : value(value) {}
+
+        /* lock-free, issues syscall only if thread is sleeping */
+        void notify() {
+            seq.fetch_add(1);
+            if (is_sleeping.load()) {
+                wake_time_ns.store(get_time_ns(), std::memory_order_relaxed);
+                ccl_futex_wake(&seq, 1);
+            }
+        }
+
+        /*
+           blocks while should_sleep() returns true,
+           returns true if thread was really put to sleep and sets wake latency
+        */
+        template <class pred_t>
+        bool sleep(pred_t should_sleep, uint64_t& wake_latency_ns) {
+            bool slept = false;
+            wake_latency_ns = 0;
+            while (true) {
+                uint32_t cur_seq = seq.load();
+                is_sleeping.store(true);
+                if (!should_sleep()) {
+                    is_sleeping.store(false, std::memory_order_relaxed);
+                    break;
+                }
+                ccl_futex_wait(&seq, cur_seq);
+                is_sleeping.store(false, std::memory_order_relaxed);
+                slept = true;
+
+                uint64_t wake_time = wake_time_ns.exchange(0, std::memory_order_relaxed);
+                uint64_t now = get_time_ns();
+                if (wake_time && now > wake_time)
+                    wake_latency_ns = now - wake_time;
+            }
+            return slept;
+        }
     };
 
     wait_data wait;
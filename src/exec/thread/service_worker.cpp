@@ -17,8 +17,9 @@
 
 ccl_service_worker::ccl_service_worker(size_t idx,
                                        std::unique_ptr<ccl_sched_queue> data_queue,
+                                       ccl_helper_task_queue* helper_queue,
                                        ccl_fusion_manager& fusion_manager)
-        : ccl_worker(idx, std::move(data_queue)),
+        : ccl_worker(idx, std::move(data_queue), helper_queue),
           fusion_manager(fusion_manager) {}
 
 ccl_service_worker::~ccl_service_worker() {
@@ -23,6 +23,7 @@ class ccl_service_worker : public ccl_worker {
 public:
     ccl_service_worker(size_t idx,
                        std::unique_ptr<ccl_sched_queue> data_queue,
+                       ccl_helper_task_queue* helper_queue,
                        ccl_fusion_manager& fusion_manager);
     ~ccl_service_worker();
 
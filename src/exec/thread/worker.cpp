@@ -16,21 +16,31 @@
 #include "common/global/global.hpp"
 #include "exec/exec.hpp"
 #include "exec/thread/worker.hpp"
+#include "sched/sched_tracer.hpp"
 
 #define CCL_WORKER_CHECK_STOP_ITERS     (16384)
 #define CCL_WORKER_CHECK_UPDATE_ITERS   (16384)
 #define CCL_WORKER_CHECK_AFFINITY_ITERS (16384)
 #define CCL_WORKER_PROCESS_ALL_ITERS    (4096)
 
+/* spin for this number of average interarrival times before going to sleep */
+#define CCL_WORKER_SPIN_INTERARRIVAL_FACTOR (2)
+
+/* weight of the previous average in interarrival time estimation, out of 8 */
+#define CCL_WORKER_INTERARRIVAL_HISTORY_WEIGHT (7)
+
 static void* ccl_worker_func(void* args);
 
-ccl_worker::ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue)
+ccl_worker::ccl_worker(size_t idx,
+                       std::unique_ptr<ccl_sched_queue> queue,
+                       ccl_helper_task_queue* helper_queue)
         : ccl_base_thread(idx, ccl_worker_func),
           should_lock(false),
           is_locked(false),
           process_atl(true),
           strict_sched_queue(std::unique_ptr<ccl_strict_sched_queue>(new ccl_strict_sched_queue())),
-          sched_queue(std::move(queue)) {}
+          sched_queue(std::move(queue)),
+          helper_queue(helper_queue) {}
 
 void ccl_worker::add(ccl_sched* sched) {
     LOG_DEBUG("add sched ", sched, ", type ", ccl_coll_type_to_str(sched->coll_param.ctype));
@@ -39,6 +49,18 @@ void ccl_worker::add(ccl_sched* sched) {
     CCL_ASSERT(!sched->bin);
     CCL_ASSERT(sched->get_in_bin_status() != ccl_sched_in_bin_added);
 
+    if (ccl::global_data::env().worker_wait && ccl::global_data::env().worker_spin_time) {
+        uint64_t now = get_time_ns();
+        uint64_t prev = last_add_time_ns.exchange(now, std::memory_order_relaxed);
+        if (prev && now > prev) {
+            /* races between submitters only affect precision of estimation */
+            uint64_t interval = now - prev;
+            uint64_t avg = avg_interarrival_ns.load(std::memory_order_relaxed);
+            avg = (avg) ? (avg * CCL_WORKER_INTERARRIVAL_HISTORY_WEIGHT + interval) / 8 : interval;
+            avg_interarrival_ns.store(avg, std::memory_order_relaxed);
+        }
+    }
+
     update_wait_condition(ccl_base_thread::wait_data::update_type::increment, 1);
 
     if (sched->strict_order) {
@@ -52,6 +74,16 @@ void ccl_worker::add(ccl_sched* sched) {
 }
 
 ccl::status ccl_worker::do_work(size_t& processed_count) {
+    /*
+       without offload application threads call do_work concurrently,
+       queues are consumed by one of them at a time, others just return
+    */
+    std::unique_lock<ccl_spinlock> lock(progress_guard, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        processed_count = 0;
+        return ccl::status::success;
+    }
+
     do_work_counter++;
 
     auto ret = process_strict_sched_queue();
@@ -68,6 +100,10 @@ ccl::status ccl_worker::do_work(size_t& processed_count) {
         sched_queue->dump(std::cout);
     }
 
+    if (helper_queue && !helper_queue->empty()) {
+        helper_queue->process(CCL_HELPER_TASK_MAX_TILES_PER_ITER);
+    }
+
     return ccl::status::success;
 }
 
@@ -100,6 +136,8 @@ ccl::status ccl_worker::process_strict_sched_queue() {
             /* here we add sched from strict_queue to regular queue for real execution */
             LOG_DEBUG("add sched ", sched, " from strict_queue to exec_queue, req ", sched->req);
             sched_queue->add(sched);
+            /* sched is progressed right below so move it into bin immediately */
+            sched_queue->drain();
         }
 
         CCL_THROW_IF_NOT(sched->get_in_bin_status() == ccl_sched_in_bin_added,
@@ -224,6 +262,7 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
 }
 
 void ccl_worker::clear_queue() {
+    std::lock_guard<ccl_spinlock> lock(progress_guard);
     strict_sched_queue->clear();
     sched_queue->clear();
 }
@@ -237,29 +276,79 @@ void ccl_worker::update_wait_condition(ccl_base_thread::wait_data::update_type t
     if (ccl::global_data::env().worker_wait == 0)
         return;
 
-    std::unique_lock<std::mutex> lock(wait.mtx);
-
     if (type == wait_data::update_type::increment) {
-        wait.value += delta;
-        if (wait.value - delta == 0)
-            wait.var.notify_one();
+        if (wait.value.fetch_add(delta) == 0)
+            wait.notify();
     }
     else if (type == wait_data::update_type::decrement) {
-        CCL_THROW_IF_NOT(
-            delta <= wait.value, "decrement ", delta, " should be less or equal to ", wait.value);
-        wait.value -= delta;
+        size_t prev_value = wait.value.load();
+        do {
+            CCL_THROW_IF_NOT(delta <= prev_value,
+                             "decrement ",
+                             delta,
+                             " should be less or equal to ",
+                             prev_value);
+        } while (!wait.value.compare_exchange_weak(prev_value, prev_value - delta));
+    }
+
+    LOG_DEBUG("type ", type, ", delta ", delta, ", new value ", wait.value.load());
+}
+
+void ccl_worker::update_stats(size_t processed_count, uint64_t busy_time_ns) {
+    if (busy_time_ns) {
+        ccl_worker_stats::inc(stats.busy_time_ns, busy_time_ns);
+    }
+
+    if (processed_count) {
+        ccl_worker_stats::inc(stats.busy_iters);
+        idle_start_time_ns = 0;
+    }
+    else {
+        ccl_worker_stats::inc(stats.idle_iters);
     }
+}
 
-    LOG_DEBUG("type ", type, ", delta ", delta, ", new value ", wait.value);
+uint64_t ccl_worker::get_spin_time_ns() const {
+    uint64_t max_spin_time = ccl::global_data::env().worker_spin_time * 1000;
+    uint64_t avg = avg_interarrival_ns.load(std::memory_order_relaxed);
+
+    /* next op is not expected soon, sleeping is cheaper than spinning */
+    if (!avg || avg > max_spin_time)
+        return 0;
+
+    return std::min(max_spin_time, avg * CCL_WORKER_SPIN_INTERARRIVAL_FACTOR);
 }
 
 bool ccl_worker::check_wait_condition(size_t iter) {
-    if (ccl::global_data::env().worker_wait && (wait.value == 0)) {
-        std::unique_lock<std::mutex> lock(wait.mtx);
-        wait.var.wait(lock, [this] {
-            bool cond = ((wait.value == 0) && (check_stop_condition(0) == false));
-            return !cond;
-        });
+    if (ccl::global_data::env().worker_wait && (wait.value.load() == 0)) {
+        /* keep spinning if next op is expected within spin time */
+        uint64_t spin_time = get_spin_time_ns();
+        if (spin_time) {
+            uint64_t now = get_time_ns();
+            if (!idle_start_time_ns)
+                idle_start_time_ns = now;
+            if (now - idle_start_time_ns < spin_time) {
+                ccl_yield(ccl::global_data::env().yield_type);
+                return true;
+            }
+        }
+
+        uint64_t wake_latency = 0;
+        bool slept = wait.sleep(
+            [this] {
+                return ((wait.value.load() == 0) && (check_stop_condition(0) == false) &&
+                        (!helper_queue || helper_queue->empty()));
+            },
+            wake_latency);
+
+        idle_start_time_ns = 0;
+
+        if (slept) {
+            ccl_worker_stats::inc(stats.wakeups);
+            ccl_worker_stats::inc(stats.wake_latency_ns, wake_latency);
+            if (wake_latency > stats.max_wake_latency_ns.load(std::memory_order_relaxed))
+                stats.max_wake_latency_ns.store(wake_latency, std::memory_order_relaxed);
+        }
     }
     else {
         ccl_yield(ccl::global_data::env().yield_type);
@@ -319,7 +408,11 @@ static void* ccl_worker_func(void* args) {
     size_t max_spin_count = ccl::global_data::env().spin_count;
     size_t spin_count = max_spin_count;
 
+    /* busy time is reported by metrics API only */
+    bool measure_busy_time = ccl::global_data::env().enable_metrics;
+
     ccl::global_data::get().is_worker_thread = true;
+    ccl::sched_tracer::set_thread_idx(worker_idx);
 
     worker->started = true;
 
@@ -329,8 +422,17 @@ static void* ccl_worker_func(void* args) {
                 break;
             worker->check_affinity_condition(iter);
 
+            /*
+               wait value is number of active ops, counted until decrement below,
+               clock is read only for iterations which have them
+            */
+            bool is_busy = measure_busy_time && worker->wait.value.load(std::memory_order_relaxed);
+            uint64_t work_start_ns = (is_busy) ? ccl_base_thread::get_time_ns() : 0;
             worker->do_work(processed_count);
 
+            uint64_t busy_time_ns = (is_busy) ? ccl_base_thread::get_time_ns() - work_start_ns : 0;
+            worker->update_stats(processed_count, busy_time_ns);
+
             worker->update_wait_condition(ccl_base_thread::wait_data::update_type::decrement,
                                           processed_count);
         }
@@ -362,3 +464,15 @@ static void* ccl_worker_func(void* args) {
 
     return nullptr;
 }
+
+std::string ccl_worker_stats::to_string() const {
+    std::stringstream ss;
+    uint64_t wakeup_count = wakeups.load(std::memory_order_relaxed);
+    ss << "busy_iters " << busy_iters.load(std::memory_order_relaxed) << ", idle_iters "
+       << idle_iters.load(std::memory_order_relaxed) << ", wakeups " << wakeup_count
+       << ", avg_wake_latency_ns "
+       << (wakeup_count ? wake_latency_ns.load(std::memory_order_relaxed) / wakeup_count : 0)
+       << ", max_wake_latency_ns " << max_wake_latency_ns.load(std::memory_order_relaxed)
+       << ", busy_time_ns " << busy_time_ns.load(std::memory_order_relaxed);
+    return ss.str();
+}
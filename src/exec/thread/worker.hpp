@@ -15,6 +15,8 @@
 */
 #pragma once
 
+#include "exec/helper_task.hpp"
+#include "common/utils/spinlock.hpp"
 #include "exec/thread/base_thread.hpp"
 #include "sched/queue/strict_queue.hpp"
 #include "sched/queue/queue.hpp"
@@ -26,12 +28,31 @@
 
 class ccl_executor;
 
+/* updated by worker thread only, can be read from any thread */
+struct ccl_worker_stats {
+    std::atomic<uint64_t> busy_iters{ 0 }; //!< iterations which completed at least one op
+    std::atomic<uint64_t> idle_iters{ 0 }; //!< iterations which didn't complete any op
+    std::atomic<uint64_t> wakeups{ 0 }; //!< number of returns from sleep
+    std::atomic<uint64_t> wake_latency_ns{ 0 }; //!< total time from wake request to return
+    std::atomic<uint64_t> max_wake_latency_ns{ 0 };
+    std::atomic<uint64_t> busy_time_ns{ 0 }; //!< time spent in iterations with active ops
+
+    static void inc(std::atomic<uint64_t>& counter, uint64_t delta = 1) {
+        /* single writer, no need for RMW */
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    std::string to_string() const;
+};
+
 class ccl_worker : public ccl_base_thread {
 public:
     ccl_worker() = delete;
     ccl_worker(const ccl_worker& other) = delete;
     ccl_worker& operator=(const ccl_worker& other) = delete;
-    ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue);
+    ccl_worker(size_t idx,
+               std::unique_ptr<ccl_sched_queue> queue,
+               ccl_helper_task_queue* helper_queue = nullptr);
 
     virtual ~ccl_worker() {
         strict_sched_queue.reset();
@@ -64,6 +85,11 @@ public:
 
     void update_wait_condition(ccl_base_thread::wait_data::update_type type, size_t delta);
 
+    void update_stats(size_t processed_count, uint64_t busy_time_ns);
+    const ccl_worker_stats& get_stats() const {
+        return stats;
+    }
+
     bool check_wait_condition(size_t iter);
     bool check_affinity_condition(size_t iter);
     bool check_stop_condition(size_t iter);
@@ -73,8 +99,24 @@ private:
     ccl::status process_sched_queue(size_t& processed_count, bool process_all);
     ccl::status process_sched_bin(ccl_sched_bin* bin, size_t& processed_count);
 
+    /* serializes consumers of sched queues */
+    ccl_spinlock progress_guard;
     size_t do_work_counter = 0;
 
     std::unique_ptr<ccl_strict_sched_queue> strict_sched_queue;
     std::unique_ptr<ccl_sched_queue> sched_queue;
+
+    /* shared between workers, holds tiles of large local operations */
+    ccl_helper_task_queue* helper_queue;
+
+    uint64_t get_spin_time_ns() const;
+
+    ccl_worker_stats stats;
+
+    /* moving average of time between submissions, updated by submitting threads */
+    std::atomic<uint64_t> last_add_time_ns{ 0 };
+    std::atomic<uint64_t> avg_interarrival_ns{ 0 };
+
+    /* start of current idle period, 0 if worker is busy */
+    uint64_t idle_start_time_ns = 0;
 };
@@ -13,6 +13,10 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <numeric>
+
+#include "common/utils/hash.hpp"
+#include "common/utils/memcpy.hpp"
 #include "exec/exec.hpp"
 #include "fusion/fusion.hpp"
 #include "sched/buffer/buffer_cache.hpp"
@@ -21,6 +25,16 @@
 
 #define CCL_FUSION_CHECK_SCHEDS_ITERS (1024)
 
+/* weight of the last interval in moving average of inter-arrival time */
+#define CCL_FUSION_ARRIVAL_GAP_WEIGHT (0.125)
+
+/* copy between user buffer of fused operation and fusion buffer */
+struct ccl_fusion_copy {
+    ccl_buffer user_buf;
+    size_t fusion_offset;
+    size_t count;
+};
+
 ccl::status complete_user_request(const void* ctx) {
     ccl_master_sched* sched = (ccl_master_sched*)ctx;
     LOG_DEBUG("complete fusion request: ", static_cast<ccl_request*>(sched));
@@ -41,10 +55,40 @@ ccl::status release_fusion_buf_for_cached_sched(ccl_sched* sched, const void* ct
     return release_fusion_buf(ctx);
 }
 
+/* bytes occupied by operation in fusion buffer */
+static size_t ccl_fusion_get_bytes(const ccl_coll_param& param) {
+    size_t count = 0;
+    switch (param.ctype) {
+        case ccl_coll_allgatherv:
+            count = param.get_send_count() +
+                    std::accumulate(param.recv_counts.begin(), param.recv_counts.end(), size_t(0));
+            break;
+        case ccl_coll_reduce_scatter:
+            count = param.get_send_count() + param.get_recv_count();
+            break;
+        default: count = param.get_send_count(); break;
+    }
+    return count * param.dtype.size();
+}
+
+/* identifies operation across iterations of application */
+static size_t ccl_fusion_get_op_key(const ccl_master_sched* sched) {
+    const ccl_coll_param& param = sched->coll_param;
+    size_t key = std::hash<std::string>()(sched->coll_attr.match_id);
+    key = ccl::utils::calculate_hash(key, param.ctype);
+    key = ccl::utils::calculate_hash(key, static_cast<size_t>(param.dtype.idx()));
+    key = ccl::utils::calculate_hash(key, static_cast<size_t>(param.reduction));
+    key = ccl::utils::calculate_hash(key, param.root);
+    key = ccl::utils::calculate_hash(key, reinterpret_cast<size_t>(param.comm));
+    key = ccl::utils::calculate_hash(key, ccl_fusion_get_bytes(param));
+    return key;
+}
+
 ccl_fusion_manager::ccl_fusion_manager()
         : bytes_threshold(ccl::global_data::env().fusion_bytes_threshold),
           count_threshold(ccl::global_data::env().fusion_count_threshold),
-          buffer_size(bytes_threshold * count_threshold) {
+          buffer_size(bytes_threshold * count_threshold),
+          adaptive(ccl::global_data::env().fusion_adaptive) {
     CCL_THROW_IF_NOT(bytes_threshold >= 1, "unexpected fusion_bytes_threshold ", bytes_threshold);
     CCL_THROW_IF_NOT(count_threshold >= 1, "unexpected fusion_count_threshold ", count_threshold);
     CCL_THROW_IF_NOT(buffer_size >= 1, "unexpected fusion_buffer_size ", buffer_size);
@@ -60,19 +104,36 @@ ccl_fusion_manager::ccl_fusion_manager()
              ", count_threshold ",
              count_threshold,
              ", buffer_size ",
-             buffer_size);
+             buffer_size,
+             ", adaptive ",
+             adaptive);
 }
 
 ccl_fusion_manager::~ccl_fusion_manager() {
     LOG_INFO("fused_bytes ",
-             stat_fused_bytes,
+             stat_fused_bytes.load(),
              ", fused_ops ",
-             stat_fused_ops,
+             stat_fused_ops.load(),
+             ", fused_scheds ",
+             stat_fused_scheds.load(),
              ", empty_exec_calls ",
              stat_empty_exec_calls,
              ", overlapped_exec_calls ",
              stat_overlapped_exec_calls);
 
+    if (adaptive) {
+        LOG_INFO("adaptive fusion: arrival_gap_usec ",
+                 arrival_gap_usec.load(),
+                 ", learned_batches ",
+                 batch_patterns.size(),
+                 ", expected_batch_flushes ",
+                 stat_expected_batch_flushes,
+                 ", avg_added_latency_usec ",
+                 (stat_fused_ops) ? stat_added_latency_usec / stat_fused_ops : 0,
+                 ", max_added_latency_usec ",
+                 stat_max_added_latency_usec);
+    }
+
     reset();
 
     CCL_ASSERT(postponed_queue.empty() && exec_queue.empty() && tracked_scheds.empty(),
@@ -100,12 +161,24 @@ bool ccl_fusion_manager::can_fuse(ccl_master_sched* sched) {
         return false;
     }
 
-    if (sched->coll_param.ctype != ccl_coll_allreduce) {
-        LOG_DEBUG("can't fuse due to coll_type ", ccl_coll_type_to_str(sched->coll_param.ctype));
-        return false;
+    switch (sched->coll_param.ctype) {
+        case ccl_coll_allreduce:
+        case ccl_coll_bcast:
+        case ccl_coll_reduce:
+        case ccl_coll_reduce_scatter: break;
+        case ccl_coll_allgatherv:
+            if (sched->coll_attr.is_vector_buf) {
+                LOG_DEBUG("can't fuse due to vector buffer");
+                return false;
+            }
+            break;
+        default:
+            LOG_DEBUG("can't fuse due to coll_type ",
+                      ccl_coll_type_to_str(sched->coll_param.ctype));
+            return false;
     }
 
-    size_t bytes = sched->coll_param.get_send_count() * sched->coll_param.dtype.size();
+    size_t bytes = ccl_fusion_get_bytes(sched->coll_param);
 
     if (bytes >= bytes_threshold) {
         LOG_DEBUG("can't fuse due to size ", bytes, ", max ", bytes_threshold);
@@ -135,68 +208,169 @@ bool ccl_fusion_manager::add(ccl_master_sched* sched) {
     CCL_THROW_IF_NOT(sched->is_completed(), "incorrect completion counter");
     sched->set_counter(1);
 
+    size_t key = (adaptive) ? ccl_fusion_get_op_key(sched) : 0;
+    auto this_time = std::chrono::steady_clock::now();
+
     {
         std::lock_guard<ccl_fusion_manager::lock_t> lock{ guard };
         postponed_queue.push_back(sched);
+
+        if (adaptive) {
+            op_infos[sched] = { key, this_time };
+            if (arrival_count++) {
+                std::chrono::duration<double, std::micro> gap = this_time - last_arrival_time;
+                arrival_gap_usec = arrival_gap_usec * (1 - CCL_FUSION_ARRIVAL_GAP_WEIGHT) +
+                                   gap.count() * CCL_FUSION_ARRIVAL_GAP_WEIGHT;
+            }
+            last_arrival_time = this_time;
+        }
     }
 
     return true;
 }
 
+bool ccl_fusion_manager::use_zero_copy(ccl_coll_type ctype,
+                                       const ccl_stream* stream __attribute__((unused))) const {
+    if (!ccl::global_data::env().fusion_zero_copy) {
+        return false;
+    }
+
+    /* reduction algorithms need intermediate buffers anyway, take only data movement colls */
+    if (ctype != ccl_coll_bcast && ctype != ccl_coll_allgatherv) {
+        return false;
+    }
+
+#ifdef CCL_ENABLE_SYCL
+    if (stream && stream->is_sycl_device_stream()) {
+        return false;
+    }
+#endif // CCL_ENABLE_SYCL
+
+    return true;
+}
+
 ccl_master_sched* ccl_fusion_manager::build_sched() {
-    size_t sum_count = 0, sum_bytes = 0, dtype_size;
+    size_t sum_count = 0, sum_bytes = 0;
     size_t max_priority = 0;
     bool use_cache = true;
     ccl_comm* comm;
     ccl::reduction reduction;
     ccl_coll_type ctype;
+    int root;
     const ccl_stream* stream __attribute__((unused)) = nullptr;
     void* fusion_buf = nullptr;
-    bool fill_sched = true;
+    bool is_new_sched = true;
 
     CCL_THROW_IF_NOT(exec_queue.size(), "empty queue");
 
     auto first_sched = exec_queue.front();
     auto last_sched = exec_queue.back();
     const ccl_datatype& dtype = first_sched->coll_param.dtype;
-    dtype_size = dtype.size();
     reduction = first_sched->coll_param.reduction;
+    root = first_sched->coll_param.root;
     comm = first_sched->coll_param.comm;
     ctype = first_sched->coll_param.ctype;
     stream = first_sched->coll_param.stream;
     max_priority = first_sched->coll_attr.priority;
 
+    /* per-rank counts of fused allgatherv */
+    std::vector<size_t> recv_counts;
+    if (ctype == ccl_coll_allgatherv) {
+        recv_counts.resize(comm->size(), 0);
+    }
+
     for (const auto& s : exec_queue) {
-        sum_count += s->coll_param.get_send_count();
+        if (ctype == ccl_coll_reduce_scatter) {
+            sum_count += s->coll_param.get_recv_count();
+        }
+        else {
+            sum_count += s->coll_param.get_send_count();
+        }
+        for (size_t idx = 0; idx < recv_counts.size(); idx++) {
+            recv_counts[idx] += s->coll_param.recv_counts[idx];
+        }
+        sum_bytes += ccl_fusion_get_bytes(s->coll_param);
         if (!s->coll_attr.to_cache) {
             use_cache = false;
         }
         max_priority = std::max(s->coll_attr.priority, max_priority);
     }
-    sum_bytes = sum_count * dtype_size;
 
-    LOG_DEBUG("build fused_sched for sum_count ",
+    bool zero_copy = use_zero_copy(ctype, stream);
+
+    LOG_DEBUG("build fused_sched for coll ",
+              ccl_coll_type_to_str(ctype),
+              ", sum_count ",
               sum_count,
               ", sum_bytes ",
               sum_bytes,
               ", sched_count ",
-              exec_queue.size());
+              exec_queue.size(),
+              ", zero_copy ",
+              zero_copy);
 
     ccl_master_sched* sched = nullptr;
-    auto create_fn = [this, ctype, &fusion_buf, sum_count, dtype, reduction, comm, stream]() {
+    auto create_fn = [this,
+                      ctype,
+                      &fusion_buf,
+                      sum_count,
+                      &recv_counts,
+                      dtype,
+                      reduction,
+                      root,
+                      comm,
+                      stream,
+                      zero_copy]() {
+        /*
+           zero copy sched works with user buffers only,
+           fused scheds are built by service worker which is worker 0, so its cache instance is used
+        */
+        if (!zero_copy) {
+            ccl::global_data::get().buffer_cache->get(0, buffer_size, &fusion_buf);
+        }
+        char* buf = static_cast<char*>(fusion_buf);
+        size_t dtype_size = dtype.size();
+
         ccl_master_sched* sched = nullptr;
+        ccl_coll_attr coll_attr;
         switch (ctype) {
+            case ccl_coll_allgatherv: {
+                ccl_coll_param coll_param = ccl_coll_param::create_allgatherv_param(
+                    buf,
+                    sum_count,
+                    (buf) ? buf + sum_count * dtype_size : nullptr,
+                    recv_counts.data(),
+                    dtype.idx(),
+                    coll_attr,
+                    comm,
+                    stream);
+                sched = new ccl_master_sched({ ccl_sched_fusion, coll_param });
+            } break;
             case ccl_coll_allreduce: {
-                ccl::global_data::get().buffer_cache->get(0, buffer_size, &fusion_buf);
-                ccl_coll_attr coll_attr;
-                ccl_coll_param coll_param = ccl_coll_param::create_allreduce_param(fusion_buf,
-                                                                                   fusion_buf,
-                                                                                   sum_count,
-                                                                                   dtype.idx(),
-                                                                                   reduction,
-                                                                                   coll_attr,
-                                                                                   comm,
-                                                                                   stream);
+                ccl_coll_param coll_param = ccl_coll_param::create_allreduce_param(
+                    buf, buf, sum_count, dtype.idx(), reduction, coll_attr, comm, stream);
+                sched = new ccl_master_sched({ ccl_sched_fusion, coll_param });
+            } break;
+            case ccl_coll_bcast: {
+                ccl_coll_param coll_param = ccl_coll_param::create_broadcast_param(
+                    buf, sum_count, dtype.idx(), root, coll_attr, comm, stream);
+                sched = new ccl_master_sched({ ccl_sched_fusion, coll_param });
+            } break;
+            case ccl_coll_reduce: {
+                ccl_coll_param coll_param = ccl_coll_param::create_reduce_param(
+                    buf, buf, sum_count, dtype.idx(), reduction, root, coll_attr, comm, stream);
+                sched = new ccl_master_sched({ ccl_sched_fusion, coll_param });
+            } break;
+            case ccl_coll_reduce_scatter: {
+                ccl_coll_param coll_param = ccl_coll_param::create_reduce_scatter_param(
+                    buf,
+                    buf + comm->size() * sum_count * dtype_size,
+                    sum_count,
+                    dtype.idx(),
+                    reduction,
+                    coll_attr,
+                    comm,
+                    stream);
                 sched = new ccl_master_sched({ ccl_sched_fusion, coll_param });
             } break;
             default: CCL_FATAL("not supported"); break;
@@ -211,16 +385,15 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
         key.f.count2 = exec_queue.size();
         key.f.dtype = dtype.idx();
         key.f.reduction = reduction;
+        key.f.root = root;
         key.f.comm = comm;
+        key.vec1 = recv_counts;
         key.match_id = first_sched->coll_attr.match_id + last_sched->coll_attr.match_id;
         LOG_DEBUG("key.match_id ", key.match_id);
-        bool is_created = false;
-        std::tie(sched, is_created) =
+        std::tie(sched, is_new_sched) =
             ccl::global_data::get().sched_cache->find_or_create(std::move(key), create_fn);
 
-        fill_sched = is_created;
-
-        if (!is_created) {
+        if (!is_new_sched) {
             LOG_DEBUG("found fused_sched in cache");
             if (!sched->is_completed()) {
                 LOG_DEBUG("it is not completed sched");
@@ -252,15 +425,180 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
 
     stat_fused_bytes += sum_bytes;
     stat_fused_ops += exec_queue.size();
+    stat_fused_scheds++;
 
-    if (!fill_sched) {
-        clear_exec_queue();
-        return sched;
+    if (is_new_sched) {
+        if (zero_copy) {
+            fill_zero_copy_sched(sched);
+        }
+        else {
+            fill_sched(sched, fusion_buf, use_cache);
+        }
     }
 
-    sched->commit(ccl::global_data::get().parallelizer.get());
+    clear_exec_queue();
+
+    return sched;
+}
+
+void ccl_fusion_manager::fill_sched(ccl_master_sched* sched, void* fusion_buf, bool use_cache) {
+    const ccl_coll_param& fused_param = sched->coll_param;
+    ccl_coll_type ctype = fused_param.ctype;
+    const ccl_datatype& dtype = fused_param.dtype;
+    size_t dtype_size = dtype.size();
+    ccl_comm* comm = fused_param.comm;
+    int comm_rank = comm->rank();
+    int comm_size = comm->size();
+
+    ccl_coll_param::buf_type buf_type = ccl_coll_param::buf_type::regular;
+    copy_attr in_attr{}, out_attr{};
+#ifdef CCL_ENABLE_SYCL
+    const ccl_stream* stream = fused_param.stream;
+    if (stream && stream->is_sycl_device_stream()) {
+        buf_type = ccl_coll_param::buf_type::device;
+        in_attr = copy_attr(copy_direction::d2h);
+        out_attr = copy_attr(copy_direction::h2d);
+    }
+#endif // CCL_ENABLE_SYCL
 
     size_t exec_queue_size = exec_queue.size();
+
+    /* layout of user buffers in fusion buffer */
+    std::vector<std::vector<ccl_fusion_copy>> copies_in(exec_queue_size);
+    std::vector<std::vector<ccl_fusion_copy>> copies_out(exec_queue_size);
+
+    switch (ctype) {
+        case ccl_coll_allreduce:
+        case ccl_coll_bcast:
+        case ccl_coll_reduce: {
+            size_t offset = 0;
+            for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+                const ccl_coll_param& param = exec_queue[op_idx]->coll_param;
+                size_t count = param.get_send_count();
+                size_t bytes = count * dtype_size;
+                bool is_root = (comm_rank == param.root);
+
+                if (ctype != ccl_coll_bcast || is_root) {
+                    ccl_buffer user_buf(
+                        param.get_send_buf_ptr(0, buf_type), bytes, ccl_buffer_type::INDIRECT);
+                    copies_in[op_idx].push_back({ user_buf, offset, count });
+                }
+
+                if (ctype == ccl_coll_allreduce || (ctype == ccl_coll_bcast && !is_root) ||
+                    (ctype == ccl_coll_reduce && is_root)) {
+                    ccl_buffer user_buf(
+                        param.get_recv_buf_ptr(0, buf_type), bytes, ccl_buffer_type::INDIRECT);
+                    copies_out[op_idx].push_back({ user_buf, offset, count });
+                }
+
+                offset += bytes;
+            }
+            break;
+        }
+        case ccl_coll_reduce_scatter: {
+            /*
+               send part: comm_size blocks of fused recv_count,
+               block of each rank contains the same block from every operation,
+               recv part: results of operations one after another
+            */
+            size_t block_bytes = fused_param.get_recv_count() * dtype_size;
+            size_t offset = 0;
+            for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+                const ccl_coll_param& param = exec_queue[op_idx]->coll_param;
+                size_t count = param.get_recv_count();
+                size_t bytes = count * dtype_size;
+
+                for (int rank = 0; rank < comm_size; rank++) {
+                    copies_in[op_idx].push_back(
+                        { ccl_buffer(param.get_send_buf_ptr(0, buf_type),
+                                     param.get_send_count() * dtype_size,
+                                     rank * bytes,
+                                     ccl_buffer_type::INDIRECT),
+                          rank * block_bytes + offset,
+                          count });
+                }
+
+                copies_out[op_idx].push_back(
+                    { ccl_buffer(
+                          param.get_recv_buf_ptr(0, buf_type), bytes, ccl_buffer_type::INDIRECT),
+                      comm_size * block_bytes + offset,
+                      count });
+
+                offset += bytes;
+            }
+            break;
+        }
+        case ccl_coll_allgatherv: {
+            /*
+               send part: send buffers of operations one after another,
+               recv part: blocks of ranks, block of each rank contains
+               the same block from every operation
+            */
+            std::vector<size_t> rank_offsets(comm_size);
+            rank_offsets[0] = fused_param.get_send_count() * dtype_size;
+            for (int rank = 1; rank < comm_size; rank++) {
+                rank_offsets[rank] =
+                    rank_offsets[rank - 1] + fused_param.recv_counts[rank - 1] * dtype_size;
+            }
+
+            size_t send_offset = 0;
+            for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+                const ccl_coll_param& param = exec_queue[op_idx]->coll_param;
+                size_t count = param.get_send_count();
+                size_t recv_bytes =
+                    std::accumulate(param.recv_counts.begin(), param.recv_counts.end(), size_t(0)) *
+                    dtype_size;
+
+                std::vector<size_t> op_offsets(comm_size);
+                op_offsets[0] = 0;
+                for (int rank = 1; rank < comm_size; rank++) {
+                    op_offsets[rank] =
+                        op_offsets[rank - 1] + param.recv_counts[rank - 1] * dtype_size;
+                }
+
+                /* for in-place case send data is already located in recv_buf */
+                ccl_buffer send_buf = (param.is_inplace(buf_type))
+                                          ? ccl_buffer(param.get_recv_buf_ptr(0, buf_type),
+                                                       recv_bytes,
+                                                       op_offsets[comm_rank],
+                                                       ccl_buffer_type::INDIRECT)
+                                          : ccl_buffer(param.get_send_buf_ptr(0, buf_type),
+                                                       count * dtype_size,
+                                                       ccl_buffer_type::INDIRECT);
+                copies_in[op_idx].push_back({ send_buf, send_offset, count });
+
+                for (int rank = 0; rank < comm_size; rank++) {
+                    copies_out[op_idx].push_back({ ccl_buffer(param.get_recv_buf_ptr(0, buf_type),
+                                                              recv_bytes,
+                                                              op_offsets[rank],
+                                                              ccl_buffer_type::INDIRECT),
+                                                   rank_offsets[rank],
+                                                   param.recv_counts[rank] });
+                    rank_offsets[rank] += param.recv_counts[rank] * dtype_size;
+                }
+
+                send_offset += count * dtype_size;
+            }
+            break;
+        }
+        default: CCL_FATAL("not supported"); break;
+    }
+
+    /* fused data that doesn't fit in cache share is packed and unpacked with streaming stores */
+    if (buf_type == ccl_coll_param::buf_type::regular) {
+        size_t copy_bytes = 0;
+        for (const auto& copies : copies_in) {
+            for (const auto& copy : copies) {
+                copy_bytes += copy.count * dtype_size;
+            }
+        }
+        bool use_nontemporal = (copy_bytes >= ccl::memcpy_get_nontemporal_threshold());
+        in_attr.use_nontemporal = use_nontemporal;
+        out_attr.use_nontemporal = use_nontemporal;
+    }
+
+    sched->commit(ccl::global_data::get().parallelizer.get());
+
     size_t part_count = sched->partial_scheds.size();
     std::vector<std::shared_ptr<ccl_sched>>& part_scheds = sched->partial_scheds;
     size_t copies_per_part = exec_queue_size / part_count;
@@ -268,12 +606,7 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
 
     CCL_THROW_IF_NOT(part_count > 0, "unexpected part_count");
 
-    LOG_DEBUG("part_count ",
-              part_count,
-              ", sum_count ",
-              sum_count,
-              ", exec_queue_size ",
-              exec_queue_size);
+    LOG_DEBUG("part_count ", part_count, ", exec_queue_size ", exec_queue_size);
 
     for (size_t idx = 0; idx < part_count; idx++) {
         part_scheds[idx]->add_barrier();
@@ -281,38 +614,22 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
     }
     sched->sync_partial_scheds();
 
-    size_t offset = 0;
     for (size_t idx = 0; idx < part_count; idx++) {
         size_t copies_count = (idx < part_count - 1) ? copies_per_part : copies_per_last_part;
 
         for (size_t copy_idx = 0; copy_idx < copies_count; copy_idx++) {
             size_t global_copy_idx = idx * copies_per_part + copy_idx;
-#ifdef CCL_ENABLE_SYCL
-            if (stream && stream->is_sycl_device_stream())
+            for (const auto& copy : copies_in[global_copy_idx]) {
+                if (!copy.count)
+                    continue;
                 entry_factory::create<copy_entry>(
                     part_scheds[idx].get(),
-                    ccl_buffer(
-                        exec_queue[global_copy_idx]->coll_param.get_send_buf_ptr(
-                            0, ccl_coll_param::buf_type::device),
-                        exec_queue[global_copy_idx]->coll_param.get_send_count() * dtype_size,
-                        ccl_buffer_type::INDIRECT),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
-                    exec_queue[global_copy_idx]->coll_param.get_send_count(),
+                    copy.user_buf,
+                    ccl_buffer(fusion_buf, buffer_size, copy.fusion_offset),
+                    copy.count,
                     dtype,
-                    copy_attr(copy_direction::d2h));
-            else
-#endif // CCL_ENABLE_SYCL
-                entry_factory::create<copy_entry>(
-                    part_scheds[idx].get(),
-                    ccl_buffer(
-                        exec_queue[global_copy_idx]->coll_param.get_send_buf_ptr(),
-                        exec_queue[global_copy_idx]->coll_param.get_send_count() * dtype_size,
-                        ccl_buffer_type::INDIRECT),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
-                    exec_queue[global_copy_idx]->coll_param.get_send_count(),
-                    dtype);
-
-            offset += exec_queue[global_copy_idx]->coll_param.get_send_count() * dtype_size;
+                    in_attr);
+            }
         }
     }
 
@@ -321,40 +638,25 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
     }
     sched->sync_partial_scheds();
 
-    offset = 0;
     for (size_t idx = 0; idx < part_count; idx++) {
         size_t copies_count = (idx < part_count - 1) ? copies_per_part : copies_per_last_part;
 
         for (size_t copy_idx = 0; copy_idx < copies_count; copy_idx++) {
             size_t global_copy_idx = idx * copies_per_part + copy_idx;
-#ifdef CCL_ENABLE_SYCL
-            if (stream && stream->is_sycl_device_stream())
+            for (const auto& copy : copies_out[global_copy_idx]) {
+                if (!copy.count)
+                    continue;
                 entry_factory::create<copy_entry>(
                     part_scheds[idx].get(),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
-                    ccl_buffer(
-                        exec_queue[global_copy_idx]->coll_param.get_recv_buf_ptr(
-                            0, ccl_coll_param::buf_type::device),
-                        exec_queue[global_copy_idx]->coll_param.get_recv_count() * dtype_size,
-                        ccl_buffer_type::INDIRECT),
-                    exec_queue[global_copy_idx]->coll_param.get_recv_count(),
+                    ccl_buffer(fusion_buf, buffer_size, copy.fusion_offset),
+                    copy.user_buf,
+                    copy.count,
                     dtype,
-                    copy_attr(copy_direction::h2d));
-            else
-#endif // CCL_ENABLE_SYCL
-                entry_factory::create<copy_entry>(
-                    part_scheds[idx].get(),
-                    ccl_buffer(fusion_buf, buffer_size, offset),
-                    ccl_buffer(
-                        exec_queue[global_copy_idx]->coll_param.get_recv_buf_ptr(),
-                        exec_queue[global_copy_idx]->coll_param.get_recv_count() * dtype_size,
-                        ccl_buffer_type::INDIRECT),
-                    exec_queue[global_copy_idx]->coll_param.get_recv_count(),
-                    dtype);
+                    out_attr);
+            }
 
             part_scheds[idx]->add_barrier();
 
-            offset += exec_queue[global_copy_idx]->coll_param.get_recv_count() * dtype_size;
             entry_factory::create<function_entry>(
                 part_scheds[idx].get(), complete_user_request, exec_queue[global_copy_idx]);
             CCL_THROW_IF_NOT(!exec_queue[global_copy_idx]->is_completed(),
@@ -370,15 +672,114 @@ ccl_master_sched* ccl_fusion_manager::build_sched() {
     else {
         entry_factory::create<function_entry>(part_scheds[0].get(), release_fusion_buf, fusion_buf);
     }
+}
 
-    clear_exec_queue();
+/*
+   sends/receives buffers of all fused operations as single message per peer,
+   bypassing fusion buffer
+*/
+void ccl_fusion_manager::fill_zero_copy_sched(ccl_master_sched* sched) {
+    const ccl_coll_param& fused_param = sched->coll_param;
+    ccl_coll_type ctype = fused_param.ctype;
+    const ccl_datatype& dtype = fused_param.dtype;
+    size_t dtype_size = dtype.size();
+    ccl_comm* comm = fused_param.comm;
+    int comm_rank = comm->rank();
+    int comm_size = comm->size();
+    size_t exec_queue_size = exec_queue.size();
 
-    return sched;
+    sched->commit(nullptr);
+
+    ccl_coll_param part_coll_param{};
+    part_coll_param.ctype = ccl_coll_partial;
+    part_coll_param.stream = fused_param.stream;
+    part_coll_param.comm = comm;
+    sched->add_partial_sched(part_coll_param);
+
+    ccl_sched* part_sched = sched->partial_scheds[0].get();
+
+    switch (ctype) {
+        case ccl_coll_bcast: {
+            std::vector<ccl_buffer> bufs;
+            std::vector<size_t> counts;
+            for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+                const ccl_coll_param& param = exec_queue[op_idx]->coll_param;
+                bufs.push_back(ccl_buffer(param.get_recv_buf_ptr(),
+                                          param.get_recv_count() * dtype_size,
+                                          ccl_buffer_type::INDIRECT));
+                counts.push_back(param.get_recv_count());
+            }
+
+            if (comm_rank == fused_param.root) {
+                for (int peer = 0; peer < comm_size; peer++) {
+                    if (peer == comm_rank)
+                        continue;
+                    entry_factory::create<sendv_entry>(part_sched, bufs, counts, dtype, peer, comm);
+                }
+            }
+            else {
+                entry_factory::create<recvv_entry>(
+                    part_sched, bufs, counts, dtype, fused_param.root, comm);
+            }
+            break;
+        }
+        case ccl_coll_allgatherv: {
+            /* per-rank blocks of every operation in its recv_buf */
+            std::vector<std::vector<ccl_buffer>> rank_bufs(comm_size);
+            std::vector<std::vector<size_t>> rank_counts(comm_size);
+
+            for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+                const ccl_coll_param& param = exec_queue[op_idx]->coll_param;
+                size_t recv_bytes =
+                    std::accumulate(param.recv_counts.begin(), param.recv_counts.end(), size_t(0)) *
+                    dtype_size;
+                size_t offset = 0;
+                for (int rank = 0; rank < comm_size; rank++) {
+                    rank_bufs[rank].push_back(ccl_buffer(
+                        param.get_recv_buf_ptr(), recv_bytes, offset, ccl_buffer_type::INDIRECT));
+                    rank_counts[rank].push_back(param.recv_counts[rank]);
+                    offset += param.recv_counts[rank] * dtype_size;
+                }
+
+                if (!param.is_inplace() && param.get_send_count()) {
+                    entry_factory::create<copy_entry>(
+                        part_sched,
+                        ccl_buffer(param.get_send_buf_ptr(),
+                                   param.get_send_count() * dtype_size,
+                                   ccl_buffer_type::INDIRECT),
+                        rank_bufs[comm_rank].back(),
+                        param.get_send_count(),
+                        dtype);
+                }
+            }
+            part_sched->add_barrier();
+
+            for (int idx = 1; idx < comm_size; idx++) {
+                int dst = (comm_rank + idx) % comm_size;
+                int src = (comm_rank - idx + comm_size) % comm_size;
+
+                entry_factory::create<sendv_entry>(
+                    part_sched, rank_bufs[comm_rank], rank_counts[comm_rank], dtype, dst, comm);
+                entry_factory::create<recvv_entry>(
+                    part_sched, rank_bufs[src], rank_counts[src], dtype, src, comm);
+            }
+            break;
+        }
+        default: CCL_FATAL("not supported"); break;
+    }
+
+    part_sched->add_barrier();
+
+    for (size_t op_idx = 0; op_idx < exec_queue_size; op_idx++) {
+        entry_factory::create<function_entry>(
+            part_sched, complete_user_request, exec_queue[op_idx]);
+        CCL_THROW_IF_NOT(!exec_queue[op_idx]->is_completed(), "incorrect completion counter");
+    }
 }
 
 void ccl_fusion_manager::execute() {
     auto this_time = std::chrono::steady_clock::now();
-    auto diff = (last_exec_time + cycle - this_time);
+    auto diff = (last_exec_time + get_cycle() - this_time);
     if (diff > std::chrono::steady_clock::duration::zero()) {
         /* it is too early, do nothing */
         stat_empty_exec_calls++;
@@ -412,18 +813,25 @@ void ccl_fusion_manager::execute() {
                 first_sched = postponed_queue.front();
                 exec_queue.push_back(first_sched);
                 postponed_queue.pop_front();
-                exec_queue_sum_bytes =
-                    first_sched->coll_param.get_send_count() * first_sched->coll_param.dtype.size();
+                exec_queue_sum_bytes = ccl_fusion_get_bytes(first_sched->coll_param);
+
+                if (adaptive) {
+                    exec_queue_key = exec_queue_hash = op_infos[first_sched].key;
+                }
             }
 
-            for (auto it = postponed_queue.begin(); it != postponed_queue.end();) {
+            bool is_batch_complete = (adaptive && is_expected_batch());
+
+            for (auto it = postponed_queue.begin();
+                 it != postponed_queue.end() && !is_batch_complete;) {
                 auto s = *it;
                 if (s->coll_param.dtype == first_sched->coll_param.dtype &&
                     s->coll_param.comm == first_sched->coll_param.comm &&
                     s->coll_param.ctype == first_sched->coll_param.ctype &&
                     s->coll_param.reduction == first_sched->coll_param.reduction &&
+                    s->coll_param.root == first_sched->coll_param.root &&
                     s->coll_param.stream == first_sched->coll_param.stream) {
-                    size_t size = s->coll_param.get_send_count() * s->coll_param.dtype.size();
+                    size_t size = ccl_fusion_get_bytes(s->coll_param);
                     if (exec_queue_sum_bytes + size > buffer_size) {
                         LOG_DEBUG("too much bytes in buffer, flush exec_queue");
                         flush_exec_queue = true;
@@ -447,16 +855,31 @@ void ccl_fusion_manager::execute() {
                         flush_exec_queue = true;
                         break;
                     }
+
+                    if (adaptive) {
+                        exec_queue_hash =
+                            ccl::utils::calculate_hash(exec_queue_hash, op_infos[s].key);
+                        is_batch_complete = is_expected_batch();
+                    }
                 }
                 else {
                     ++it;
                 }
             }
+
+            if (is_batch_complete) {
+                LOG_DEBUG("expected batch is complete, flush exec_queue");
+                stat_expected_batch_flushes++;
+                flush_exec_queue = true;
+            }
         }
     }
 
     if (flush_exec_queue) {
         LOG_DEBUG("exec_queue size ", exec_queue.size(), ", bytes ", exec_queue_sum_bytes);
+        if (adaptive) {
+            learn_batch();
+        }
         ccl_master_sched* sched = build_sched();
         sched->start(ccl::global_data::get().executor.get());
     }
@@ -466,6 +889,52 @@ void ccl_fusion_manager::execute() {
     }
 }
 
+std::chrono::steady_clock::duration ccl_fusion_manager::get_cycle() const {
+    if (!adaptive || !arrival_count) {
+        return cycle;
+    }
+
+    /* check not more often than operations arrive but not later than fixed cycle */
+    auto arrival_gap = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::micro>(arrival_gap_usec.load()));
+    return std::min(cycle, arrival_gap);
+}
+
+bool ccl_fusion_manager::is_expected_batch() const {
+    auto it = batch_patterns.find(exec_queue_key);
+    if (it == batch_patterns.end()) {
+        return false;
+    }
+    return (it->second.count == exec_queue.size() && it->second.hash == exec_queue_hash);
+}
+
+void ccl_fusion_manager::learn_batch() {
+    auto this_time = std::chrono::steady_clock::now();
+
+    std::lock_guard<ccl_fusion_manager::lock_t> lock{ guard };
+
+    /* the latest batch wins, so changed submission pattern is picked up on the next iteration */
+    batch_patterns[exec_queue_key] = { exec_queue.size(), exec_queue_hash };
+
+    for (const auto& s : exec_queue) {
+        auto it = op_infos.find(s);
+        if (it == op_infos.end())
+            continue;
+        double latency =
+            std::chrono::duration<double, std::micro>(this_time - it->second.arrival_time).count();
+        stat_added_latency_usec += latency;
+        stat_max_added_latency_usec = std::max(stat_max_added_latency_usec, latency);
+        op_infos.erase(it);
+    }
+
+    LOG_DEBUG("learned batch: key ",
+              exec_queue_key,
+              ", count ",
+              exec_queue.size(),
+              ", arrival_gap_usec ",
+              arrival_gap_usec.load());
+}
+
 void ccl_fusion_manager::release_buffer(void* buf) {
     ccl::global_data::get().buffer_cache->push(0, buffer_size, buf);
 }
@@ -473,6 +942,8 @@ void ccl_fusion_manager::release_buffer(void* buf) {
 void ccl_fusion_manager::clear_exec_queue() {
     exec_queue.clear();
     exec_queue_sum_bytes = 0;
+    exec_queue_key = 0;
+    exec_queue_hash = 0;
 }
 
 void ccl_fusion_manager::check_tracked_scheds(bool force_release) {
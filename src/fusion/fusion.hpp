@@ -18,9 +18,11 @@
 #include "common/utils/spinlock.hpp"
 #include "sched/master_sched.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <deque>
+#include <unordered_map>
 
 class ccl_fusion_manager {
 public:
@@ -37,8 +39,26 @@ public:
     void execute();
     void release_buffer(void* buf);
 
+    /* can be read from any thread */
+    size_t get_fused_ops() const {
+        return stat_fused_ops.load(std::memory_order_relaxed);
+    }
+    size_t get_fused_bytes() const {
+        return stat_fused_bytes.load(std::memory_order_relaxed);
+    }
+    size_t get_fused_scheds() const {
+        return stat_fused_scheds.load(std::memory_order_relaxed);
+    }
+
 private:
     ccl_master_sched* build_sched();
+    void fill_sched(ccl_master_sched* sched, void* fusion_buf, bool use_cache);
+    void fill_zero_copy_sched(ccl_master_sched* sched);
+    bool use_zero_copy(ccl_coll_type ctype, const ccl_stream* stream) const;
+
+    std::chrono::steady_clock::duration get_cycle() const;
+    bool is_expected_batch() const;
+    void learn_batch();
     void clear_exec_queue();
     void check_tracked_scheds(bool force_release = false);
 
@@ -60,8 +80,36 @@ private:
     std::chrono::steady_clock::duration cycle;
     std::chrono::steady_clock::time_point last_exec_time;
 
-    size_t stat_fused_ops = 0;
-    size_t stat_fused_bytes = 0;
+    /*
+       adaptive policy: batches are remembered by key of their first operation,
+       when the same sequence of operations is collected again it is flushed
+       without waiting for urgent request or thresholds
+    */
+    struct op_info {
+        size_t key;
+        std::chrono::steady_clock::time_point arrival_time;
+    };
+
+    struct batch_pattern {
+        size_t count;
+        size_t hash;
+    };
+
+    const bool adaptive;
+    std::unordered_map<const ccl_master_sched*, op_info> op_infos{};
+    std::unordered_map<size_t, batch_pattern> batch_patterns{};
+    size_t exec_queue_key = 0;
+    size_t exec_queue_hash = 0;
+    std::chrono::steady_clock::time_point last_arrival_time;
+    size_t arrival_count = 0;
+    std::atomic<double> arrival_gap_usec{ 0 };
+
+    std::atomic<size_t> stat_fused_ops{ 0 };
+    std::atomic<size_t> stat_fused_bytes{ 0 };
+    std::atomic<size_t> stat_fused_scheds{ 0 };
     size_t stat_empty_exec_calls = 0;
     size_t stat_overlapped_exec_calls = 0;
+    size_t stat_expected_batch_flushes = 0;
+    double stat_added_latency_usec = 0;
+    double stat_max_added_latency_usec = 0;
 };
@@ -48,7 +48,8 @@ std::string ccl_numa_node::to_string() {
 }
 
 ccl_hwloc_wrapper::ccl_hwloc_wrapper()
-        : membind_thread_supported(false),
+        : llc_size_per_core(0),
+          membind_thread_supported(false),
           bindset(nullptr),
           topology(nullptr) {
     /* mandatory checks */
@@ -109,6 +110,27 @@ ccl_hwloc_wrapper::ccl_hwloc_wrapper()
         numa_nodes.push_back(
             ccl_numa_node(idx, os_idx, mem_in_mb, core_count, cpus, check_membind(idx)));
     }
+
+    hwloc_obj_type_t cache_types[] = { HWLOC_OBJ_L3CACHE, HWLOC_OBJ_L2CACHE };
+    for (auto cache_type : cache_types) {
+        hwloc_obj_t cache_obj =
+            hwloc_get_obj_inside_cpuset_by_type(topology, bindset, cache_type, 0);
+        if (!cache_obj) {
+            cache_obj = hwloc_get_obj_by_type(topology, cache_type, 0);
+        }
+        if (cache_obj && cache_obj->attr) {
+            int core_count = hwloc_get_nbobjs_inside_cpuset_by_type(
+                topology, cache_obj->cpuset, HWLOC_OBJ_CORE);
+            llc_size_per_core = cache_obj->attr->cache.size / std::max(core_count, 1);
+            LOG_DEBUG("LLC: ",
+                      obj_to_string(cache_obj),
+                      ", size ",
+                      cache_obj->attr->cache.size,
+                      ", cores ",
+                      core_count);
+            break;
+        }
+    }
 }
 
 ccl_hwloc_wrapper::~ccl_hwloc_wrapper() {
@@ -214,6 +236,34 @@ void ccl_hwloc_wrapper::membind_thread(int numa_node) {
     hwloc_bitmap_free(nodeset);
 }
 
+bool ccl_hwloc_wrapper::membind_area(const void* ptr, size_t bytes, int numa_node) {
+    if (!is_initialized() || !is_valid_numa_node(numa_node) ||
+        !get_numa_node(numa_node).membind_support) {
+        return false;
+    }
+
+    hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+    hwloc_bitmap_only(nodeset, unsigned(numa_node));
+
+    bool ret = true;
+    if (hwloc_set_area_membind(
+            topology, ptr, bytes, nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_BYNODESET) < 0) {
+        LOG_DEBUG("failed to bind memory area ",
+                  ptr,
+                  ", bytes ",
+                  bytes,
+                  " to NUMA node ",
+                  numa_node,
+                  " (",
+                  strerror(errno),
+                  ")");
+        ret = false;
+    }
+
+    hwloc_bitmap_free(nodeset);
+    return ret;
+}
+
 int ccl_hwloc_wrapper::get_numa_node_by_cpu(int cpu) {
     if (!is_initialized()) {
         LOG_WARN("hwloc is not initialized, can't get numa NUMA for CPU ", cpu);
@@ -249,6 +299,15 @@ ccl_numa_node ccl_hwloc_wrapper::get_numa_node(int numa_node) {
     return numa_nodes[numa_node];
 }
 
+size_t ccl_hwloc_wrapper::get_llc_size_per_core() {
+    if (!is_initialized()) {
+        LOG_WARN("hwloc is not initialized, can't get LLC size");
+        return 0;
+    }
+
+    return llc_size_per_core;
+}
+
 bool ccl_hwloc_wrapper::is_valid_numa_node(int numa_node) {
     if ((numa_node == CCL_UNDEFINED_NUMA_NODE) || (numa_node < 0) ||
         (numa_node >= static_cast<int>(get_numa_node_count()))) {
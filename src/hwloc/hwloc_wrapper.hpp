@@ -50,9 +50,13 @@ public:
     bool is_dev_close_by_pci(int domain, int bus, int dev, int func);
 
     void membind_thread(int numa_node);
+    bool membind_area(const void* ptr, size_t bytes, int numa_node);
     int get_numa_node_by_cpu(int cpu);
     ccl_numa_node get_numa_node(int numa_node);
 
+    /* share of last level cache close to process per core, 0 if unknown */
+    size_t get_llc_size_per_core();
+
 private:
     bool is_valid_numa_node(int numa_node);
     bool check_membind(int numa_node);
@@ -61,6 +65,7 @@ private:
     std::string obj_to_string(hwloc_obj_t obj);
 
     std::vector<ccl_numa_node> numa_nodes;
+    size_t llc_size_per_core;
 
     bool membind_thread_supported;
     hwloc_cpuset_t bindset;
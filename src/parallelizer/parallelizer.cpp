@@ -259,12 +259,14 @@ ccl::status ccl_parallelizer::process_base(ccl_master_sched* sched) {
     selector_param.ctype = coll_type;
     selector_param.count = coll_param.get_send_count();
     selector_param.dtype = dtype;
+    selector_param.reduction = coll_param.reduction;
     selector_param.comm = comm;
     selector_param.stream = coll_param.stream;
     selector_param.is_vector_buf = coll_attr.is_vector_buf;
 #ifdef CCL_ENABLE_SYCL
     selector_param.is_sycl_buf = coll_attr.is_sycl_buf;
 #endif // CCL_ENABLE_SYCL
+    selector_param.hint_algo = sched->hint_algo;
 
     switch (coll_type) {
         case ccl_coll_barrier: part_count = max_data_partition_count; break;
@@ -381,6 +383,7 @@ ccl::status ccl_parallelizer::process_base(ccl_master_sched* sched) {
         /* in this place all coll attributes for partial schedules
          * are taken from master schedule, including priority */
         part_scheds[idx]->coll_attr = coll_attr;
+        part_scheds[idx]->hint_algo = sched->hint_algo;
         part_scheds_vector[idx] = part_scheds[idx].get();
     }
 
@@ -13,16 +13,37 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <sys/mman.h>
+
 #include "common/global/global.hpp"
+#include "hwloc/hwloc_wrapper.hpp"
 #include "sched/buffer/buffer_cache.hpp"
 
 namespace ccl {
 
 buffer_cache::~buffer_cache() {
+    auto total_stats = get_stats();
     for (auto& instance : reg_buffers) {
         instance.clear();
     }
 
+    size_t request_count =
+        total_stats.hit_count + total_stats.split_count + total_stats.miss_count;
+    if (request_count) {
+        LOG_INFO("buffer cache: requests ",
+                 request_count,
+                 ", hits ",
+                 total_stats.hit_count,
+                 ", splits ",
+                 total_stats.split_count,
+                 ", misses ",
+                 total_stats.miss_count,
+                 ", hit rate ",
+                 100.0 * (total_stats.hit_count + total_stats.split_count) / request_count,
+                 "%, held bytes ",
+                 total_stats.held_bytes);
+    }
+
 #ifdef CCL_ENABLE_SYCL
     for (auto& instance : sycl_buffers) {
         instance.clear();
@@ -30,6 +51,18 @@ buffer_cache::~buffer_cache() {
 #endif // CCL_ENABLE_SYCL
 }
 
+regular_buffer_cache_stats buffer_cache::get_stats() {
+    regular_buffer_cache_stats total_stats;
+    for (auto& instance : reg_buffers) {
+        auto stats = instance.get_stats();
+        total_stats.hit_count += stats.hit_count;
+        total_stats.split_count += stats.split_count;
+        total_stats.miss_count += stats.miss_count;
+        total_stats.held_bytes += stats.held_bytes;
+    }
+    return total_stats;
+}
+
 void buffer_cache::get(size_t idx, size_t bytes, void** pptr) {
     reg_buffers.at(idx % reg_buffers.size()).get(bytes, pptr);
 }
@@ -38,6 +71,10 @@ void buffer_cache::push(size_t idx, size_t bytes, void* ptr) {
     reg_buffers.at(idx % reg_buffers.size()).push(bytes, ptr);
 }
 
+void buffer_cache::set_numa_node(size_t idx, int numa_node) {
+    reg_buffers.at(idx % reg_buffers.size()).set_numa_node(numa_node);
+}
+
 #ifdef CCL_ENABLE_SYCL
 void buffer_cache::get(size_t idx, size_t bytes, const sycl::context& ctx, void** pptr) {
     sycl_buffers.at(idx % sycl_buffers.size()).get(bytes, ctx, pptr);
@@ -49,45 +86,171 @@ void buffer_cache::push(size_t idx, size_t bytes, const sycl::context& ctx, void
 #endif // CCL_ENABLE_SYCL
 
 regular_buffer_cache::~regular_buffer_cache() {
-    if (!cache.empty()) {
-        LOG_WARN("buffer cache is not empty, size: ", cache.size());
+    if (!cache.empty() || !chunks.empty()) {
+        LOG_WARN("buffer cache is not empty, size: ", cache.size(), ", chunks: ", chunks.size());
         clear();
     }
 }
 
 void regular_buffer_cache::clear() {
     std::lock_guard<buffer_cache::lock_t> lock{ guard };
-    LOG_DEBUG("clear buffer cache: size: ", cache.size());
+    LOG_DEBUG("clear buffer cache: size: ",
+              cache.size(),
+              ", chunks: ",
+              chunks.size(),
+              ", held bytes: ",
+              stats.held_bytes);
     for (auto& key_value : cache) {
         CCL_FREE(key_value.second);
     }
     cache.clear();
+
+    for (auto& blocks : free_blocks) {
+        blocks.clear();
+    }
+    for (auto& chunk : chunks) {
+        CCL_FREE(chunk.first);
+    }
+    chunks.clear();
+    stats.held_bytes = 0;
+}
+
+void regular_buffer_cache::set_numa_node(int node) {
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    numa_node = node;
+}
+
+regular_buffer_cache_stats regular_buffer_cache::get_stats() {
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    return stats;
+}
+
+size_t regular_buffer_cache::get_class_idx(size_t bytes) {
+    size_t shift = CCL_BUFFER_CACHE_MIN_CLASS_SHIFT;
+    while ((size_t(1) << shift) < bytes) {
+        shift++;
+    }
+    return shift - CCL_BUFFER_CACHE_MIN_CLASS_SHIFT;
+}
+
+size_t regular_buffer_cache::get_class_size(size_t class_idx) {
+    return size_t(1) << (class_idx + CCL_BUFFER_CACHE_MIN_CLASS_SHIFT);
+}
+
+void* regular_buffer_cache::alloc_placed(size_t bytes) {
+    bool use_huge_pages =
+        global_data::env().enable_buffer_cache_huge_pages && (bytes >= CCL_LARGE_MSG_ALIGNMENT);
+    size_t alignment = (use_huge_pages) ? CCL_LARGE_MSG_ALIGNMENT : CCL_REG_MSG_ALIGNMENT;
+    void* ptr = CCL_MEMALIGN(bytes, alignment, "buffer_cache");
+
+    /* both hints have to be applied before the first touch of memory */
+    if (use_huge_pages && madvise(ptr, bytes, MADV_HUGEPAGE)) {
+        LOG_DEBUG("failed to enable huge pages for ", ptr, " (", strerror(errno), ")");
+    }
+
+    if (numa_node != CCL_UNDEFINED_NUMA_NODE) {
+        auto& hwloc_wrapper = global_data::get().hwloc_wrapper;
+        if (!hwloc_wrapper || !hwloc_wrapper->membind_area(ptr, bytes, numa_node)) {
+            LOG_WARN("can not place buffer cache on NUMA node ",
+                     numa_node,
+                     ", use default memory policy");
+            numa_node = CCL_UNDEFINED_NUMA_NODE;
+        }
+    }
+
+    return ptr;
+}
+
+void* regular_buffer_cache::alloc_chunk(size_t bytes) {
+    void* ptr = alloc_placed(bytes);
+    chunks.emplace_back(ptr, bytes);
+    stats.held_bytes += bytes;
+
+    LOG_DEBUG("allocated buffer cache chunk: bytes: ", bytes, ", ptr: ", ptr);
+    return ptr;
 }
 
 void regular_buffer_cache::get(size_t bytes, void** pptr) {
-    if (global_data::env().enable_buffer_cache) {
+    if (!global_data::env().enable_buffer_cache) {
+        *pptr = CCL_MALLOC(bytes, "buffer");
+        return;
+    }
+
+    if (bytes > get_class_size(CCL_BUFFER_CACHE_CLASS_COUNT - 1)) {
         std::lock_guard<buffer_cache::lock_t> lock{ guard };
         key_t key(bytes);
         auto key_value = cache.find(key);
         if (key_value != cache.end()) {
             *pptr = key_value->second;
             cache.erase(key_value);
+            stats.hit_count++;
             LOG_DEBUG("loaded from buffer cache: bytes: ", bytes, ", ptr: ", *pptr);
             return;
         }
+        stats.miss_count++;
+        *pptr = alloc_placed(bytes);
+        return;
+    }
+
+    size_t class_idx = get_class_idx(bytes);
+
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+
+    auto& blocks = free_blocks[class_idx];
+    if (!blocks.empty()) {
+        *pptr = blocks.back();
+        blocks.pop_back();
+        stats.hit_count++;
+        LOG_DEBUG("loaded from buffer cache: bytes: ", bytes, ", ptr: ", *pptr);
+        return;
     }
-    *pptr = CCL_MALLOC(bytes, "buffer");
+
+    /* look for free block of larger class which is not too large to split */
+    size_t src_class_idx = class_idx + 1;
+    size_t max_src_class_idx = std::min(class_idx + CCL_BUFFER_CACHE_MAX_SPLIT_SHIFT,
+                                        size_t(CCL_BUFFER_CACHE_CLASS_COUNT - 1));
+    while (src_class_idx <= max_src_class_idx && free_blocks[src_class_idx].empty()) {
+        src_class_idx++;
+    }
+
+    char* block = nullptr;
+    if (src_class_idx <= max_src_class_idx) {
+        block = static_cast<char*>(free_blocks[src_class_idx].back());
+        free_blocks[src_class_idx].pop_back();
+        stats.split_count++;
+    }
+    else {
+        src_class_idx = std::max(
+            class_idx, size_t(CCL_BUFFER_CACHE_MIN_CHUNK_SHIFT - CCL_BUFFER_CACHE_MIN_CLASS_SHIFT));
+        block = static_cast<char*>(alloc_chunk(get_class_size(src_class_idx)));
+        stats.miss_count++;
+    }
+
+    /* keep the first part of block, upper halves go to free lists of smaller classes */
+    while (src_class_idx > class_idx) {
+        src_class_idx--;
+        free_blocks[src_class_idx].push_back(block + get_class_size(src_class_idx));
+    }
+
+    *pptr = block;
+    LOG_DEBUG("allocated from buffer cache: bytes: ", bytes, ", ptr: ", *pptr);
 }
 
 void regular_buffer_cache::push(size_t bytes, void* ptr) {
-    if (global_data::env().enable_buffer_cache) {
-        std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    if (!global_data::env().enable_buffer_cache) {
+        CCL_FREE(ptr);
+        return;
+    }
+
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    if (bytes > get_class_size(CCL_BUFFER_CACHE_CLASS_COUNT - 1)) {
         key_t key(bytes);
         cache.insert({ std::move(key), ptr });
-        LOG_DEBUG("inserted to buffer cache: bytes: ", bytes, ", ptr: ", ptr);
-        return;
     }
-    CCL_FREE(ptr);
+    else {
+        free_blocks[get_class_idx(bytes)].push_back(ptr);
+    }
+    LOG_DEBUG("inserted to buffer cache: bytes: ", bytes, ", ptr: ", ptr);
 }
 
 #ifdef CCL_ENABLE_SYCL
@@ -24,6 +24,22 @@
 #endif // CCL_ENABLE_SYCL
 
 #include "common/utils/spinlock.hpp"
+#include "common/utils/utils.hpp"
+
+/*
+   power-of-two size classes for regular buffers, from 64 bytes to 1 MB,
+   larger buffers are cached by exact size to not waste up to half of the block
+*/
+#define CCL_BUFFER_CACHE_MIN_CLASS_SHIFT (6)
+#define CCL_BUFFER_CACHE_MAX_CLASS_SHIFT (20)
+#define CCL_BUFFER_CACHE_CLASS_COUNT \
+    (CCL_BUFFER_CACHE_MAX_CLASS_SHIFT - CCL_BUFFER_CACHE_MIN_CLASS_SHIFT + 1)
+
+/* max distance between size classes to split free block instead of new allocation */
+#define CCL_BUFFER_CACHE_MAX_SPLIT_SHIFT (4)
+
+/* smaller buffers are carved from chunk of this size */
+#define CCL_BUFFER_CACHE_MIN_CHUNK_SHIFT (16)
 
 namespace ccl {
 
@@ -32,6 +48,13 @@ class regular_buffer_cache;
 class sycl_buffer_cache;
 #endif // CCL_ENABLE_SYCL
 
+struct regular_buffer_cache_stats {
+    size_t hit_count = 0;
+    size_t split_count = 0;
+    size_t miss_count = 0;
+    size_t held_bytes = 0;
+};
+
 class buffer_cache {
 public:
     buffer_cache(size_t instance_count)
@@ -50,6 +73,11 @@ public:
 
     void push(size_t idx, size_t bytes, void* ptr);
 
+    void set_numa_node(size_t idx, int numa_node);
+
+    /* aggregated over all instances */
+    regular_buffer_cache_stats get_stats();
+
 #ifdef CCL_ENABLE_SYCL
     void get(size_t idx, size_t bytes, const sycl::context& ctx, void** pptr);
 
@@ -65,6 +93,13 @@ private:
 #endif // CCL_ENABLE_SYCL
 };
 
+/*
+   slab allocator for host buffers:
+   small requests are rounded up to power-of-two size class,
+   empty class is refilled by splitting free block of larger class or by new chunk,
+   chunks and large buffers are placed on NUMA node of worker which owns this instance
+   and are released only on clear
+*/
 class regular_buffer_cache {
 public:
     regular_buffer_cache() = default;
@@ -74,12 +109,28 @@ public:
     void get(size_t bytes, void** pptr);
     void push(size_t bytes, void* ptr);
 
+    void set_numa_node(int node);
+    regular_buffer_cache_stats get_stats();
+
 private:
+    static size_t get_class_idx(size_t bytes);
+    static size_t get_class_size(size_t class_idx);
+
+    void* alloc_placed(size_t bytes);
+    void* alloc_chunk(size_t bytes);
+
     buffer_cache::lock_t guard{};
 
+    std::vector<void*> free_blocks[CCL_BUFFER_CACHE_CLASS_COUNT];
+    std::vector<std::pair<void*, size_t>> chunks;
+
+    /* buffers larger than max size class are cached by exact size */
     using key_t = size_t;
     using value_t = void*;
     std::unordered_multimap<key_t, value_t> cache;
+
+    int numa_node = CCL_UNDEFINED_NUMA_NODE;
+    regular_buffer_cache_stats stats;
 };
 
 #ifdef CCL_ENABLE_SYCL
@@ -136,6 +136,11 @@ public:
         instance_idx = idx;
     }
 
+    /* cache instance of worker which executes schedule, buffers are returned to it as well */
+    void set_instance_idx(size_t idx) {
+        instance_idx = idx;
+    }
+
     void clear();
 
     void* alloc(const alloc_param& param);
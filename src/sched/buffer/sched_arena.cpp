@@ -0,0 +1,75 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+
+#include "common/log/log.hpp"
+#include "common/utils/utils.hpp"
+#include "sched/buffer/sched_arena.hpp"
+
+namespace ccl {
+
+sched_arena::~sched_arena() {
+    for (auto& block : blocks) {
+        CCL_FREE(block.ptr);
+    }
+}
+
+void* sched_arena::alloc(size_t bytes, size_t alignment) {
+    CCL_THROW_IF_NOT(alignment && !(alignment & (alignment - 1)) && alignment <= CACHELINE_SIZE,
+                     "unexpected alignment ",
+                     alignment);
+
+    if (!blocks.empty()) {
+        auto& block = blocks.back();
+        size_t aligned_offset = (offset + alignment - 1) & ~(alignment - 1);
+        if (aligned_offset + bytes <= block.size) {
+            offset = aligned_offset + bytes;
+            allocated_bytes += bytes;
+            return block.ptr + aligned_offset;
+        }
+    }
+
+    size_t block_size = std::max(bytes, size_t(CCL_SCHED_ARENA_BLOCK_SIZE));
+    char* ptr = static_cast<char*>(CCL_MEMALIGN(block_size, CACHELINE_SIZE, "sched_arena"));
+    blocks.push_back({ ptr, block_size });
+    offset = bytes;
+    allocated_bytes += bytes;
+
+    LOG_DEBUG("allocated arena block: ptr ", (void*)ptr, ", size ", block_size);
+
+    return ptr;
+}
+
+bool sched_arena::contains(const void* ptr) const {
+    const char* p = static_cast<const char*>(ptr);
+    return std::any_of(blocks.begin(), blocks.end(), [p](const block_t& block) {
+        return (p >= block.ptr) && (p < block.ptr + block.size);
+    });
+}
+
+void sched_arena::reset() {
+    if (blocks.empty())
+        return;
+
+    for (size_t idx = 1; idx < blocks.size(); idx++) {
+        CCL_FREE(blocks[idx].ptr);
+    }
+    blocks.resize(1);
+    offset = 0;
+    allocated_bytes = 0;
+}
+
+} // namespace ccl
@@ -0,0 +1,64 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/* default size of arena block, larger requests get dedicated block */
+#define CCL_SCHED_ARENA_BLOCK_SIZE (8192)
+
+/* max size of managed host buffer placed into schedule arena */
+#define CCL_SCHED_ARENA_MAX_BUFFER_SIZE (1024)
+
+namespace ccl {
+
+/*
+   bump allocator for objects which live as long as schedule or its memory:
+   allocations are placed contiguously in cache-line aligned blocks,
+   objects are never freed one by one, all of them are dropped by reset
+*/
+class sched_arena {
+public:
+    sched_arena() = default;
+    sched_arena(const sched_arena&) = delete;
+    sched_arena& operator=(const sched_arena&) = delete;
+    ~sched_arena();
+
+    void* alloc(size_t bytes, size_t alignment);
+    bool contains(const void* ptr) const;
+
+    /* keeps the first block for reuse */
+    void reset();
+
+    size_t get_allocated_bytes() const {
+        return allocated_bytes;
+    }
+
+private:
+    struct block_t {
+        char* ptr;
+        size_t size;
+    };
+
+    std::vector<block_t> blocks;
+
+    /* offset in the last block */
+    size_t offset = 0;
+    size_t allocated_bytes = 0;
+};
+
+} // namespace ccl
@@ -16,12 +16,54 @@
 #include "common/global/global.hpp"
 #include "sched/cache/cache.hpp"
 
-ccl_master_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
+ccl_sched_cache::ccl_sched_cache() {
+    capacity = ccl::global_data::env().cache_capacity;
+    if (capacity && ccl::global_data::env().enable_fusion) {
+        /* fused schedules keep pointers to schedules of original operations */
+        LOG_WARN("sched cache eviction is not supported together with fusion, ignore capacity ",
+                 capacity);
+        capacity = 0;
+    }
+}
+
+ccl_sched_cache::~ccl_sched_cache() {
+    size_t iter = 0;
+    static const size_t check_period = 1000;
+    while (!try_flush()) {
+        if (iter % check_period) {
+            LOG_DEBUG("can't destruct cache because reference_counter = ",
+                      reference_counter,
+                      ", expected 0");
+        }
+        iter++;
+    }
+
+    if (hit_count || miss_count) {
+        LOG_INFO("sched cache: hits ",
+                 hit_count,
+                 ", misses ",
+                 miss_count,
+                 ", evictions ",
+                 eviction_count,
+                 ", capacity ",
+                 capacity);
+    }
+}
+
+size_t ccl_sched_cache::get_shard_idx(const ccl_sched_key& key) const {
+    /* hasher caches result in key */
+    return ccl_sched_key_hasher{}(key) % CCL_SCHED_CACHE_SHARD_COUNT;
+}
+
+ccl_master_sched* ccl_sched_cache::find_unsafe(sched_shard_t& shard, const ccl_sched_key& key) {
     ccl_master_sched* sched = nullptr;
     {
-        auto it = table.find(key);
-        if (it != table.end()) {
-            sched = it->second;
+        auto it = shard.table.find(key);
+        if (it != shard.table.end()) {
+            sched = it->second.sched;
+            if (capacity && it->second.lru_it != shard.lru.begin()) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_it);
+            }
         }
     }
 
@@ -36,23 +78,77 @@ ccl_master_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
     return sched;
 }
 
+void ccl_sched_cache::insert_unsafe(sched_shard_t& shard,
+                                    ccl_sched_key&& key,
+                                    ccl_master_sched* sched) {
+    auto emplace_result = shard.table.emplace(std::move(key), sched_entry_t{ sched, {} });
+    CCL_THROW_IF_NOT(emplace_result.second);
+
+    auto& it = emplace_result.first;
+    shard.lru.push_front(&it->first);
+    it->second.lru_it = shard.lru.begin();
+    entry_count++;
+}
+
+void ccl_sched_cache::evict_unsafe(sched_shard_t& shard) {
+    if (!capacity)
+        return;
+
+    /* only own shard is visited to avoid lock of other shards on critical path */
+    auto lru_it = shard.lru.end();
+    while ((entry_count > capacity) && (lru_it != shard.lru.begin())) {
+        --lru_it;
+        auto it = shard.table.find(**lru_it);
+        CCL_THROW_IF_NOT(it != shard.table.end());
+
+        ccl_master_sched* sched = it->second.sched;
+        if (sched->cache_ref_count)
+            continue;
+
+        LOG_DEBUG("evict sched ", sched, " from cache");
+        lru_it = shard.lru.erase(lru_it);
+        shard.table.erase(it);
+        delete sched;
+        entry_count--;
+        eviction_count++;
+    }
+}
+
 void ccl_sched_cache::recache(const ccl_sched_key& old_key, ccl_sched_key&& new_key) {
-    {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        auto it = table.find(old_key);
-        if (it == table.end()) {
-            std::string error_message = "old_key wasn't found";
-            CCL_ASSERT(false, error_message, old_key.match_id);
-            throw ccl::exception(error_message + old_key.match_id);
-        }
-        ccl_master_sched* sched = it->second;
-        table.erase(it);
-        auto emplace_result = table.emplace(std::move(new_key), sched);
-        CCL_THROW_IF_NOT(emplace_result.second);
+    size_t old_idx = get_shard_idx(old_key);
+    size_t new_idx = get_shard_idx(new_key);
+    sched_shard_t& old_shard = shards[old_idx];
+    sched_shard_t& new_shard = shards[new_idx];
+
+    /* lock shards in the same order to avoid deadlock */
+    std::unique_lock<sched_cache_lock_t> first_lock{ shards[std::min(old_idx, new_idx)].guard };
+    std::unique_lock<sched_cache_lock_t> second_lock;
+    if (old_idx != new_idx)
+        second_lock = std::unique_lock<sched_cache_lock_t>{
+            shards[std::max(old_idx, new_idx)].guard
+        };
+
+    auto it = old_shard.table.find(old_key);
+    if (it == old_shard.table.end()) {
+        std::string error_message = "old_key wasn't found";
+        CCL_ASSERT(false, error_message, old_key.match_id);
+        throw ccl::exception(error_message + old_key.match_id);
     }
+    ccl_master_sched* sched = it->second.sched;
+    old_shard.lru.erase(it->second.lru_it);
+    old_shard.table.erase(it);
+    entry_count--;
+
+    sched->cache_shard_idx = new_idx;
+    insert_unsafe(new_shard, std::move(new_key), sched);
 }
 
 void ccl_sched_cache::release(ccl_master_sched* sched) {
+    if (capacity) {
+        std::lock_guard<sched_cache_lock_t> lock{ shards[sched->cache_shard_idx].guard };
+        CCL_ASSERT(sched->cache_ref_count);
+        sched->cache_ref_count--;
+    }
     reference_counter--;
     LOG_TRACE("reference_counter=", reference_counter);
 }
@@ -61,16 +157,24 @@ bool ccl_sched_cache::try_flush() {
     if (!ccl::global_data::env().enable_cache_flush)
         return true;
 
-    std::lock_guard<sched_cache_lock_t> lock{ guard };
+    std::vector<std::unique_lock<sched_cache_lock_t>> locks;
+    locks.reserve(CCL_SCHED_CACHE_SHARD_COUNT);
+    for (auto& shard : shards) {
+        locks.emplace_back(shard.guard);
+    }
 
     if (reference_counter == 0) {
-        for (auto it = table.begin(); it != table.end(); ++it) {
-            ccl_master_sched* sched = it->second;
-            CCL_ASSERT(sched);
-            LOG_DEBUG("remove sched ", sched, " from cache");
-            delete sched;
+        for (auto& shard : shards) {
+            for (auto it = shard.table.begin(); it != shard.table.end(); ++it) {
+                ccl_master_sched* sched = it->second.sched;
+                CCL_ASSERT(sched);
+                LOG_DEBUG("remove sched ", sched, " from cache");
+                delete sched;
+            }
+            shard.table.clear();
+            shard.lru.clear();
         }
-        table.clear();
+        entry_count = 0;
         return true;
     }
     else {
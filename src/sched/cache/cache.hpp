@@ -21,26 +21,22 @@
 
 #include <atomic>
 #include <functional>
+#include <list>
 #include <unordered_map>
 #include <utility>
 
 #define CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT (4096)
+#define CCL_SCHED_CACHE_SHARD_COUNT          (16)
 
+/*
+   schedules are distributed between shards by key hash,
+   so lookups from different threads don't serialize on single lock,
+   when capacity is set, unreferenced schedules are evicted in LRU order
+*/
 class ccl_sched_cache {
 public:
-    ccl_sched_cache() : reference_counter(0){};
-    ~ccl_sched_cache() {
-        size_t iter = 0;
-        static const size_t check_period = 1000;
-        while (!try_flush()) {
-            if (iter % check_period) {
-                LOG_DEBUG("can't destruct cache because reference_counter = ",
-                          reference_counter,
-                          ", expected 0");
-            }
-            iter++;
-        }
-    }
+    ccl_sched_cache();
+    ~ccl_sched_cache();
     ccl_sched_cache(const ccl_sched_cache& other) = delete;
     ccl_sched_cache& operator=(const ccl_sched_cache& other) = delete;
     template <class Lambda>
@@ -49,15 +45,51 @@ public:
     void release(ccl_master_sched* sched);
     bool try_flush();
 
+    size_t get_hit_count() const {
+        return hit_count.load(std::memory_order_relaxed);
+    }
+    size_t get_miss_count() const {
+        return miss_count.load(std::memory_order_relaxed);
+    }
+    size_t get_eviction_count() const {
+        return eviction_count.load(std::memory_order_relaxed);
+    }
+
 private:
-    ccl_master_sched* find_unsafe(const ccl_sched_key& key) const;
     using sched_cache_lock_t = ccl_spinlock;
-    mutable sched_cache_lock_t guard{}; //could be changed in constant method
+
+    /* most recently used schedules are in the beginning, points to keys stored in table */
+    using sched_lru_t = std::list<const ccl_sched_key*>;
+
+    struct sched_entry_t {
+        ccl_master_sched* sched;
+        sched_lru_t::iterator lru_it;
+    };
+
     //TODO use smart ptr for ccl_master_sched in table
-    using sched_table_t =
-        std::unordered_map<ccl_sched_key, ccl_master_sched*, ccl_sched_key_hasher>;
-    sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT };
-    std::atomic<size_t> reference_counter;
+    using sched_table_t = std::unordered_map<ccl_sched_key, sched_entry_t, ccl_sched_key_hasher>;
+
+    struct sched_shard_t {
+        sched_cache_lock_t guard{};
+        sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT / CCL_SCHED_CACHE_SHARD_COUNT };
+        sched_lru_t lru{};
+    };
+
+    size_t get_shard_idx(const ccl_sched_key& key) const;
+    ccl_master_sched* find_unsafe(sched_shard_t& shard, const ccl_sched_key& key);
+    void insert_unsafe(sched_shard_t& shard, ccl_sched_key&& key, ccl_master_sched* sched);
+    void evict_unsafe(sched_shard_t& shard);
+
+    sched_shard_t shards[CCL_SCHED_CACHE_SHARD_COUNT];
+    std::atomic<size_t> reference_counter{ 0 };
+
+    /* max number of cached schedules, 0 - unlimited */
+    size_t capacity = 0;
+    std::atomic<size_t> entry_count{ 0 };
+
+    std::atomic<size_t> hit_count{ 0 };
+    std::atomic<size_t> miss_count{ 0 };
+    std::atomic<size_t> eviction_count{ 0 };
 };
 
 template <class Lambda>
@@ -65,30 +97,42 @@ std::pair<ccl_master_sched*, bool> ccl_sched_cache::find_or_create(ccl_sched_key
                                                                    Lambda create_fn) {
     ccl_master_sched* sched = nullptr;
     bool is_created = false;
+
+    /* key hash is calculated once here and reused by table lookup */
+    size_t shard_idx = get_shard_idx(key);
+    sched_shard_t& shard = shards[shard_idx];
     {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        sched = find_unsafe(key);
+        std::lock_guard<sched_cache_lock_t> lock{ shard.guard };
+        sched = find_unsafe(shard, key);
         if (sched) {
-            reference_counter++;
+            hit_count++;
         }
         else {
             LOG_DEBUG("didn't find sched in cache, the new one will be created");
+            miss_count++;
             sched = create_fn();
-            {
-                reference_counter++;
-                auto emplace_result = table.emplace(std::move(key), sched);
-                CCL_ASSERT(emplace_result.second);
-            }
+            sched->cache_shard_idx = shard_idx;
+            insert_unsafe(shard, std::move(key), sched);
             is_created = true;
 
-            LOG_DEBUG("size ",
-                      table.size(),
+            LOG_DEBUG("shard ",
+                      shard_idx,
+                      ", size ",
+                      shard.table.size(),
                       ", bucket_count ",
-                      table.bucket_count(),
+                      shard.table.bucket_count(),
                       ", load_factor ",
-                      table.load_factor(),
+                      shard.table.load_factor(),
                       ", max_load_factor ",
-                      table.max_load_factor());
+                      shard.table.max_load_factor());
+        }
+
+        reference_counter++;
+        if (capacity)
+            sched->cache_ref_count++;
+
+        if (is_created) {
+            evict_unsafe(shard);
         }
     }
     LOG_TRACE("reference_counter=", reference_counter);
@@ -128,6 +128,12 @@ bool ccl_sched_key::check(const ccl_coll_param& param, const ccl_coll_attr& attr
 }
 
 bool ccl_sched_key::operator==(const ccl_sched_key& k) const {
+    /* cheap reject for keys with already calculated and different hashes */
+    if (has_hasher_result && k.has_hasher_result &&
+        (get_hasher_result() != k.get_hasher_result())) {
+        return false;
+    }
+
     bool are_fields_equal = 1;
     if (ccl::global_data::env().cache_key_type == ccl_cache_key_full) {
         are_fields_equal = !memcmp(&f, &(k.f), sizeof(ccl_sched_key_inner_fields));
@@ -44,6 +44,7 @@ public:
         work_sched->renew();
         work_sched->bin = sched->bin;
         work_sched->queue = sched->queue;
+        work_sched->get_memory().buffer_manager.set_instance_idx(sched->queue->get_idx());
         work_sched->sched_id = sched->sched_id;
         status = ccl_sched_entry_status_started;
     }
@@ -35,6 +35,7 @@ public:
         }
         selector_param.recv_counts = param.recv_counts;
         selector_param.dtype = param.dtype;
+        selector_param.reduction = param.reduction;
         selector_param.comm = param.comm;
         selector_param.stream = param.stream;
         selector_param.buf = (param.send_buf) ? param.send_buf.get_ptr() : param.recv_buf.get_ptr();
@@ -43,11 +44,20 @@ public:
         selector_param.is_sycl_buf = sched->coll_attr.is_sycl_buf;
 #endif // CCL_ENABLE_SYCL
         selector_param.hint_algo = param.hint_algo;
+        selector_param.is_regular_sched =
+            sched->is_regular_partial() && !sched->coll_attr.prologue_fn;
 
         if (ccl_is_device_side_algo(selector_param)) {
             sched->strict_order = true;
         }
 
+        if (selector_param.is_regular_sched && ccl_is_hierarchical_algo(selector_param)) {
+            /* takes shm region on start of schedule, so it should be started from user call */
+            auto res = coll_entry_helper::build_schedule(sched, sched, param);
+            CCL_ASSERT(res == ccl::status::success, "error during build_schedule, res ", res);
+            return nullptr;
+        }
+
         if ((ccl::global_data::env().atl_transport == ccl_atl_mpi) &&
             ccl_is_direct_algo(selector_param)) {
             if (sched->coll_attr.prologue_fn) {
@@ -43,6 +43,12 @@ copy_entry::copy_entry(ccl_sched* sched,
     CCL_THROW_IF_NOT(sched, "no sched");
 }
 
+copy_entry::~copy_entry() {
+    if (helper_task) {
+        helper_task->cancel();
+    }
+}
+
 void copy_entry::start() {
     //update_fields();
 
@@ -138,6 +144,14 @@ void copy_entry::start() {
 }
 
 void copy_entry::update() {
+    if (helper_task) {
+        if (helper_task->progress()) {
+            helper_task.reset();
+            status = ccl_sched_entry_status_complete;
+        }
+        return;
+    }
+
 #ifdef CCL_ENABLE_SYCL
     if (ctype == copy_type::sycl) {
         if (copier.is_completed()) {
@@ -154,6 +168,19 @@ void copy_entry::update() {
 
 void copy_entry::do_regular_copy() {
     size_t bytes = dtype.size() * count;
+
+    char* in_ptr = static_cast<char*>(in_buf.get_ptr(bytes));
+    char* out_ptr = static_cast<char*>(out_buf.get_ptr(bytes));
+    bool use_nontemporal = attr.use_nontemporal;
+    helper_task = ccl_post_helper_task(
+        bytes, 1, [in_ptr, out_ptr, use_nontemporal](size_t offset, size_t tile_bytes) {
+            ccl_comp_copy(in_ptr + offset, out_ptr + offset, tile_bytes, use_nontemporal);
+        });
+    if (helper_task) {
+        status = ccl_sched_entry_status_started;
+        return;
+    }
+
     auto comp_status =
         ccl_comp_copy(in_buf.get_ptr(bytes), out_buf.get_ptr(bytes), bytes, attr.use_nontemporal);
     CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
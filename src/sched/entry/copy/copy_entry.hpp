@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "exec/helper_task.hpp"
 #include "sched/entry/copy/copy_helper.hpp"
 #include "sched/entry/entry.hpp"
 
@@ -49,6 +50,7 @@ public:
                size_t count,
                const ccl_datatype& dtype,
                copy_attr attr = {});
+    ~copy_entry();
 
     void start() override;
     void update() override;
@@ -83,6 +85,8 @@ private:
     const ccl_datatype dtype;
     copy_attr attr;
 
+    std::shared_ptr<ccl_helper_task> helper_task;
+
 #ifdef CCL_ENABLE_SYCL
     sycl_copier copier{};
 #ifdef CCL_ENABLE_ZE
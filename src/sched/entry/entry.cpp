@@ -17,6 +17,7 @@
 #include "common/log/log.hpp"
 #include "sched/entry/entry.hpp"
 #include "sched/sched.hpp"
+#include "sched/sched_tracer.hpp"
 
 void sched_entry::do_progress() {
     if (is_completed())
@@ -37,6 +38,9 @@ void sched_entry::do_progress() {
             if (took_credits && ccl::global_data::env().sched_profile) {
                 timer.start();
             }
+            if (took_credits && ccl::global_data::get().sched_tracer) {
+                trace_begin_ns = ccl::sched_tracer::now();
+            }
         }
         else if (status == ccl_sched_entry_status_again) {
             took_credits = true;
@@ -70,6 +74,19 @@ void sched_entry::do_progress() {
             timer.stop();
         }
 
+        auto& tracer = ccl::global_data::get().sched_tracer;
+        if (tracer) {
+            ccl::sched_trace_event event;
+            event.set_name(name());
+            event.category = "entry";
+            event.begin_ns = trace_begin_ns;
+            event.end_ns = ccl::sched_tracer::now();
+            event.sched_id = sched->sched_id;
+            event.peer = get_trace_peer();
+            event.bytes = get_trace_bytes();
+            tracer->record(event);
+        }
+
         if (exec_mode == ccl_sched_entry_exec_once) {
             status = ccl_sched_entry_status_complete_once;
         }
@@ -75,6 +75,15 @@ public:
 
     virtual const char* name() const = 0;
 
+    /* peer rank and payload size reported to sched tracer, -1 and 0 if not applicable */
+    virtual int get_trace_peer() const {
+        return -1;
+    }
+
+    virtual size_t get_trace_bytes() const {
+        return 0;
+    }
+
     static const char* status_to_str(ccl_sched_entry_status status);
 
     ccl::sched_timer timer;
@@ -92,4 +101,5 @@ protected:
     size_t start_idx = 0;
     ccl_sched_entry_status status = ccl_sched_entry_status_not_started;
     ccl_sched_entry_exec_mode exec_mode = ccl_sched_entry_exec_regular;
+    uint64_t trace_begin_ns = 0;
 };
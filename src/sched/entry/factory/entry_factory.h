@@ -21,6 +21,7 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <new>
 
 // declares interface for all entries creations
 namespace entry_factory {
@@ -38,8 +39,10 @@ struct entry_creator {
 
     template <ccl_sched_add_mode mode, class... Arguments>
     static EntryType* make_entry(ccl_sched* sched, Arguments&&... args) {
+        void* entry_mem = sched->entry_arena.alloc(sizeof(EntryType), alignof(EntryType));
         return static_cast<EntryType*>(sched->add_entry(
-            std::unique_ptr<EntryType>(new EntryType(sched, std::forward<Arguments>(args)...)),
+            ccl_sched::sched_entry_ptr(new (entry_mem)
+                                           EntryType(sched, std::forward<Arguments>(args)...)),
             ccl_sched_base::add_entry_mode_t<mode>()));
     }
 };
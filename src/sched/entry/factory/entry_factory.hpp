@@ -37,9 +37,14 @@
 #include "sched/entry/recv_entry.hpp"
 #include "sched/entry/recv_copy_entry.hpp"
 #include "sched/entry/recv_reduce_entry.hpp"
+#include "sched/entry/recv_reduce_multi_entry.hpp"
+#include "sched/entry/recvv_entry.hpp"
 #include "sched/entry/reduce_local_entry.hpp"
+#include "sched/entry/reduce_local_multi_entry.hpp"
 #include "sched/entry/register_entry.hpp"
 #include "sched/entry/send_entry.hpp"
+#include "sched/entry/sendv_entry.hpp"
+#include "sched/entry/shm_entry.hpp"
 #include "sched/entry/sparse_allreduce_completion_entry.hpp"
 #include "sched/entry/subsched_entry.hpp"
 #include "sched/entry/sync_entry.hpp"
@@ -47,6 +47,14 @@ public:
         return class_name();
     }
 
+    int get_trace_peer() const override {
+        return src;
+    }
+
+    size_t get_trace_bytes() const override {
+        return bytes;
+    }
+
 protected:
     void dump_detail(std::stringstream& str) const override {
         ccl_logger::format(str,
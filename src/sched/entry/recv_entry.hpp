@@ -82,6 +82,14 @@ public:
         return class_name();
     }
 
+    int get_trace_peer() const override {
+        return src;
+    }
+
+    size_t get_trace_bytes() const override {
+        return cnt * dtype.size();
+    }
+
     ccl_buffer& get_field_ref(field_id_t<ccl_sched_entry_field_buf> id) {
         return buf;
     }
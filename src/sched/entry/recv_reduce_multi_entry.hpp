@@ -0,0 +1,224 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "comp/comp.hpp"
+#include "sched/entry/entry.hpp"
+#include "sched/queue/queue.hpp"
+
+#include <vector>
+
+/*
+   receives chunks from several peers and reduces them with local chunk into output buffer,
+   chunks are reduced as soon as they arrive, all chunks arrived since previous check
+   are reduced together in single pass over output buffer
+*/
+class recv_reduce_multi_entry final : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "RECV_REDUCE_MULTI";
+    }
+
+    recv_reduce_multi_entry() = delete;
+    recv_reduce_multi_entry(ccl_sched* sched,
+                            ccl_buffer local_buf,
+                            ccl_buffer out_buf,
+                            size_t cnt,
+                            const ccl_datatype& dtype,
+                            ccl::reduction reduction_op,
+                            const std::vector<int>& srcs,
+                            const std::vector<ccl_buffer>& recv_bufs,
+                            ccl_comm* comm)
+            : sched_entry(sched),
+              local_buf(local_buf),
+              out_buf(out_buf),
+              cnt(cnt),
+              dtype(dtype),
+              op(reduction_op),
+              srcs(srcs),
+              recv_bufs(recv_bufs),
+              comm(comm),
+              fn(sched->coll_attr.reduction_fn),
+              reqs(srcs.size()),
+              is_received(srcs.size(), false) {
+        CCL_THROW_IF_NOT(!srcs.empty(), "empty source list");
+        CCL_THROW_IF_NOT(srcs.size() == recv_bufs.size(),
+                         "unexpected recv_bufs size ",
+                         recv_bufs.size(),
+                         ", expected ",
+                         srcs.size());
+        CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                         "custom reduction requires user provided callback",
+                         ", op ",
+                         ccl_reduction_to_str(op),
+                         ", fn ",
+                         fn);
+    }
+
+    ~recv_reduce_multi_entry() override {
+        if (status == ccl_sched_entry_status_started) {
+            for (size_t idx = 0; idx < posted_count; idx++) {
+                if (is_received[idx])
+                    continue;
+                LOG_DEBUG("cancel RECV in RECV_REDUCE_MULTI entry, src ",
+                          srcs[idx],
+                          ", req ",
+                          &reqs[idx]);
+                comm->get_atl_comm()->cancel(sched->bin->get_atl_ep(), &reqs[idx]);
+            }
+        }
+    }
+
+    void start() override {
+        size_t bytes = cnt * dtype.size();
+
+        /* continue from the first recv which was not posted if previous start returned again */
+        for (; posted_count < srcs.size(); posted_count++) {
+            int src = srcs[posted_count];
+            uint64_t atl_tag = comm->get_atl_comm()->tag->create(
+                src, sched->get_comm_id(), sched->sched_id, sched->get_op_id());
+
+            LOG_DEBUG("starting RECV in RECV_REDUCE_MULTI entry, src ",
+                      src,
+                      ", tag ",
+                      atl_tag,
+                      ", req ",
+                      &reqs[posted_count],
+                      ", bytes ",
+                      bytes);
+
+            atl_status_t atl_status =
+                comm->get_atl_comm()->recv(sched->bin->get_atl_ep(),
+                                           recv_bufs[posted_count].get_ptr(bytes),
+                                           bytes,
+                                           src,
+                                           atl_tag,
+                                           &reqs[posted_count]);
+
+            update_status(atl_status);
+            if (status == ccl_sched_entry_status_again)
+                return;
+        }
+    }
+
+    void update() override {
+        size_t bytes = cnt * dtype.size();
+
+        std::vector<const void*> in_ptrs;
+        in_ptrs.push_back((reduced_count == 0) ? local_buf.get_ptr(bytes)
+                                               : out_buf.get_ptr(bytes));
+
+        for (size_t idx = 0; idx < srcs.size(); idx++) {
+            if (is_received[idx])
+                continue;
+
+            atl_status_t atl_status =
+                comm->get_atl_comm()->check(sched->bin->get_atl_ep(), &reqs[idx]);
+
+            if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
+                CCL_THROW("RECV_REDUCE_MULTI entry failed. atl_status: ",
+                          atl_status_to_str(atl_status));
+            }
+
+            if (reqs[idx].is_completed) {
+                is_received[idx] = true;
+                in_ptrs.push_back(recv_bufs[idx].get_ptr(bytes));
+            }
+        }
+
+        if (in_ptrs.size() == 1) {
+            return;
+        }
+
+        LOG_DEBUG("REDUCE in RECV_REDUCE_MULTI entry, arrived ",
+                  in_ptrs.size() - 1,
+                  ", reduced ",
+                  reduced_count,
+                  " of ",
+                  srcs.size());
+
+        const ccl::fn_context context = { sched->coll_attr.match_id.c_str(),
+                                          out_buf.get_offset() };
+        ccl::status comp_status = ccl_comp_reduce_multi(sched,
+                                                        in_ptrs.data(),
+                                                        in_ptrs.size(),
+                                                        cnt,
+                                                        out_buf.get_ptr(bytes),
+                                                        nullptr,
+                                                        dtype,
+                                                        op,
+                                                        fn,
+                                                        &context);
+        CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+
+        reduced_count += in_ptrs.size() - 1;
+        if (reduced_count == srcs.size()) {
+            status = ccl_sched_entry_status_complete;
+            LOG_DEBUG("completed REDUCE in RECV_REDUCE_MULTI entry");
+        }
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+    size_t get_trace_bytes() const override {
+        return cnt * dtype.size() * srcs.size();
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", local_buf ",
+                           local_buf,
+                           ", out_buf ",
+                           out_buf,
+                           ", cnt ",
+                           cnt,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", red_fn ",
+                           fn,
+                           ", src_count ",
+                           srcs.size(),
+                           ", posted ",
+                           posted_count,
+                           ", reduced ",
+                           reduced_count,
+                           ", comm_id ",
+                           sched->get_comm_id(),
+                           "\n");
+    }
+
+private:
+    ccl_buffer local_buf;
+    ccl_buffer out_buf;
+    size_t cnt;
+    ccl_datatype dtype;
+    ccl::reduction op;
+    std::vector<int> srcs;
+    std::vector<ccl_buffer> recv_bufs;
+    ccl_comm* comm;
+    ccl::reduction_fn fn;
+
+    std::vector<atl_req_t> reqs;
+    std::vector<bool> is_received;
+    size_t posted_count = 0;
+    size_t reduced_count = 0;
+};
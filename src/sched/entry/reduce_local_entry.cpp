@@ -91,8 +91,40 @@ reduce_local_entry::reduce_local_entry(ccl_sched* sched,
                      fn);
 }
 
+reduce_local_entry::~reduce_local_entry() {
+    if (helper_task) {
+        helper_task->cancel();
+    }
+}
+
 void reduce_local_entry::start_on_host() {
     size_t bytes = in_cnt * dtype.size();
+
+    /* user callback may be not thread-safe, device buffers are staged through host on each call */
+    if (!fn && !sched->coll_param.stream) {
+        char* in_ptr = static_cast<char*>(in_buf.get_ptr(bytes));
+        char* inout_ptr = static_cast<char*>(inout_buf.get_ptr(bytes));
+        size_t dtype_size = dtype.size();
+        helper_task = ccl_post_helper_task(
+            in_cnt, dtype_size, [this, in_ptr, inout_ptr, dtype_size](size_t offset, size_t count) {
+                ccl_comp_reduce(sched,
+                                in_ptr + offset * dtype_size,
+                                count,
+                                inout_ptr + offset * dtype_size,
+                                nullptr,
+                                dtype,
+                                op,
+                                fn);
+            });
+        if (helper_task) {
+            if (out_cnt) {
+                *const_cast<size_t*>(out_cnt) = in_cnt;
+            }
+            status = ccl_sched_entry_status_started;
+            return;
+        }
+    }
+
     size_t offset = inout_buf.get_offset();
     const fn_context context = { sched->coll_attr.match_id.c_str(), offset };
     ccl::status comp_status = ccl_comp_reduce(sched,
@@ -109,6 +141,20 @@ void reduce_local_entry::start_on_host() {
     status = ccl_sched_entry_status_complete;
 }
 
+void reduce_local_entry::update() {
+    if (helper_task) {
+        if (helper_task->progress()) {
+            helper_task.reset();
+            status = ccl_sched_entry_status_complete;
+        }
+        return;
+    }
+
+#if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
+    ze_reduce_local_entry::update();
+#endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
+}
+
 void reduce_local_entry::start() {
     check_use_device();
     if (use_device) {
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "common/global/global.hpp"
+#include "exec/helper_task.hpp"
 #include "sched/entry/entry.hpp"
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
@@ -44,6 +45,7 @@ public:
                                 size_t* out_cnt,
                                 const ccl_datatype& dtype,
                                 ccl::reduction op);
+    ~reduce_local_entry();
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     void check_use_device();
@@ -55,6 +57,7 @@ public:
 
     void start_on_host();
     void start() override;
+    void update() override;
 
 protected:
     void dump_detail(std::stringstream& str) const override {
@@ -86,4 +89,5 @@ private:
     const ccl::reduction_fn fn;
 
     bool use_device{};
+    std::shared_ptr<ccl_helper_task> helper_task;
 };
@@ -0,0 +1,159 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "comp/comp.hpp"
+#include "exec/helper_task.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <vector>
+
+/* reduces several input buffers into output buffer in single pass over output */
+class reduce_local_multi_entry final : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "REDUCE_LOCAL_MULTI";
+    }
+
+    const char* name() const noexcept override {
+        return class_name();
+    }
+
+    reduce_local_multi_entry() = delete;
+    reduce_local_multi_entry(ccl_sched* sched,
+                             const std::vector<ccl_buffer>& in_bufs,
+                             size_t cnt,
+                             ccl_buffer out_buf,
+                             size_t* out_cnt,
+                             const ccl_datatype& dtype,
+                             ccl::reduction op)
+            : sched_entry(sched),
+              in_bufs(in_bufs),
+              cnt(cnt),
+              out_buf(out_buf),
+              out_cnt(out_cnt),
+              dtype(dtype),
+              op(op),
+              fn(sched->coll_attr.reduction_fn) {
+        CCL_THROW_IF_NOT(!in_bufs.empty(), "empty input buffer list");
+        CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
+                         "custom reduction requires user provided callback",
+                         ", op ",
+                         ccl_reduction_to_str(op),
+                         ", fn ",
+                         fn);
+    }
+
+    ~reduce_local_multi_entry() {
+        if (helper_task) {
+            helper_task->cancel();
+        }
+    }
+
+    void start() override {
+        size_t bytes = cnt * dtype.size();
+
+        in_ptrs.resize(in_bufs.size());
+        for (size_t idx = 0; idx < in_bufs.size(); idx++) {
+            in_ptrs[idx] = in_bufs[idx].get_ptr(bytes);
+        }
+
+        /* user callback may be not thread-safe, device buffers are staged through host on each call */
+        if (!fn && !sched->coll_param.stream) {
+            char* out_ptr = static_cast<char*>(out_buf.get_ptr(bytes));
+            helper_task = ccl_post_helper_task(
+                cnt, dtype.size(), [this, out_ptr](size_t offset, size_t count) {
+                    size_t byte_offset = offset * dtype.size();
+                    std::vector<const void*> tile_in_ptrs(in_ptrs.size());
+                    for (size_t idx = 0; idx < in_ptrs.size(); idx++) {
+                        tile_in_ptrs[idx] = static_cast<const char*>(in_ptrs[idx]) + byte_offset;
+                    }
+                    ccl_comp_reduce_multi(sched,
+                                          tile_in_ptrs.data(),
+                                          tile_in_ptrs.size(),
+                                          count,
+                                          out_ptr + byte_offset,
+                                          nullptr,
+                                          dtype,
+                                          op,
+                                          fn);
+                });
+            if (helper_task) {
+                if (out_cnt) {
+                    *out_cnt = cnt;
+                }
+                status = ccl_sched_entry_status_started;
+                return;
+            }
+        }
+
+        size_t offset = out_buf.get_offset();
+        const ccl::fn_context context = { sched->coll_attr.match_id.c_str(), offset };
+        ccl::status comp_status = ccl_comp_reduce_multi(sched,
+                                                        in_ptrs.data(),
+                                                        in_ptrs.size(),
+                                                        cnt,
+                                                        out_buf.get_ptr(bytes),
+                                                        out_cnt,
+                                                        dtype,
+                                                        op,
+                                                        fn,
+                                                        &context);
+        CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
+
+        status = ccl_sched_entry_status_complete;
+    }
+
+    void update() override {
+        if (helper_task->progress()) {
+            helper_task.reset();
+            status = ccl_sched_entry_status_complete;
+        }
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "dt ",
+                           ccl::global_data::get().dtypes->name(dtype),
+                           ", in_buf_count ",
+                           in_bufs.size(),
+                           ", cnt ",
+                           cnt,
+                           ", out_buf ",
+                           out_buf,
+                           ", out_cnt ",
+                           out_cnt,
+                           ", op ",
+                           ccl_reduction_to_str(op),
+                           ", red_fn ",
+                           fn,
+                           "\n");
+    }
+
+private:
+    const std::vector<ccl_buffer> in_bufs;
+    const size_t cnt;
+    const ccl_buffer out_buf;
+    size_t* out_cnt;
+    const ccl_datatype dtype;
+    const ccl::reduction op;
+    const ccl::reduction_fn fn;
+
+    std::vector<const void*> in_ptrs;
+    std::shared_ptr<ccl_helper_task> helper_task;
+};
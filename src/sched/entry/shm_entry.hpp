@@ -0,0 +1,217 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/global/global.hpp"
+#include "common/utils/yield.hpp"
+#include "sched/entry/entry.hpp"
+
+#include <atomic>
+
+struct alignas(CACHELINE_SIZE) ccl_shm_flag {
+    std::atomic<uint64_t> value;
+};
+
+/*
+   part of node-local shared memory segment,
+   serving_ticket and epoch are process-local, flags and data are shared by all local ranks
+*/
+struct ccl_shm_region {
+    std::atomic<uint64_t> serving_ticket{ 0 };
+    uint64_t epoch = 0;
+    ccl_shm_flag* flags = nullptr;
+    char* data = nullptr;
+};
+
+/*
+   region used by current run of schedule,
+   data is referenced by indirect buffers of entries which access the region
+*/
+struct ccl_shm_binding {
+    ccl_shm_region* region = nullptr;
+    char* data = nullptr;
+    uint64_t ticket = 0;
+};
+
+/*
+   takes ticket on schedule start and waits until region of the ticket is released,
+   schedules take tickets in the order they are started by user, which is the same on all ranks,
+   so all local ranks use the same region for the same operation and in the same order
+*/
+class shm_acquire_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "SHM_ACQUIRE";
+    }
+
+    shm_acquire_entry() = delete;
+    shm_acquire_entry(ccl_sched* sched,
+                      ccl_shm_region* regions,
+                      size_t region_count,
+                      std::atomic<uint64_t>* next_ticket)
+            : sched_entry(sched, true),
+              regions(regions),
+              region_count(region_count),
+              next_ticket(next_ticket) {}
+
+    void reset(size_t idx) override {
+        sched_entry::reset(idx);
+        binding.ticket = next_ticket->fetch_add(1);
+        binding.region = &regions[binding.ticket % region_count];
+        binding.data = binding.region->data;
+    }
+
+    void start() override {
+        status = ccl_sched_entry_status_started;
+        update();
+    }
+
+    void update() override {
+        if (binding.region->serving_ticket.load(std::memory_order_acquire) == binding.ticket) {
+            status = ccl_sched_entry_status_complete;
+        }
+        else {
+            ccl_yield(ccl::global_data::env().yield_type);
+        }
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+    ccl_shm_binding* get_binding() {
+        return &binding;
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "region ",
+                           binding.region,
+                           ", ticket ",
+                           binding.ticket,
+                           ", serving ticket ",
+                           (binding.region) ? binding.region->serving_ticket.load() : 0,
+                           "\n");
+    }
+
+private:
+    ccl_shm_region* regions;
+    size_t region_count;
+    std::atomic<uint64_t>* next_ticket;
+    ccl_shm_binding binding{};
+};
+
+class shm_release_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "SHM_RELEASE";
+    }
+
+    shm_release_entry() = delete;
+    shm_release_entry(ccl_sched* sched, const ccl_shm_binding* binding, size_t region_count)
+            : sched_entry(sched, true),
+              binding(binding),
+              region_count(region_count) {}
+
+    void start() override {
+        ccl_shm_region* region = binding->region;
+        CCL_THROW_IF_NOT(region->serving_ticket.load() == binding->ticket,
+                         "unexpected serving ticket of shm region ",
+                         region->serving_ticket.load(),
+                         ", sched ticket ",
+                         binding->ticket);
+        region->serving_ticket.store(binding->ticket + region_count, std::memory_order_release);
+        status = ccl_sched_entry_status_complete;
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str, "region ", binding->region, ", ticket ", binding->ticket, "\n");
+    }
+
+private:
+    const ccl_shm_binding* binding;
+    size_t region_count;
+};
+
+/*
+   barrier over local ranks which share the region,
+   region and target epoch are taken on start to keep cached schedules valid
+*/
+class shm_barrier_entry : public sched_entry {
+public:
+    static constexpr const char* class_name() noexcept {
+        return "SHM_BARRIER";
+    }
+
+    shm_barrier_entry() = delete;
+    shm_barrier_entry(ccl_sched* sched,
+                      const ccl_shm_binding* binding,
+                      int local_rank,
+                      int local_size)
+            : sched_entry(sched, true),
+              binding(binding),
+              local_rank(local_rank),
+              local_size(local_size) {}
+
+    void start() override {
+        region = binding->region;
+        epoch = ++region->epoch;
+        region->flags[local_rank].value.store(epoch, std::memory_order_release);
+        status = ccl_sched_entry_status_started;
+        update();
+    }
+
+    void update() override {
+        for (int idx = 0; idx < local_size; idx++) {
+            if (region->flags[idx].value.load(std::memory_order_acquire) < epoch) {
+                ccl_yield(ccl::global_data::env().yield_type);
+                return;
+            }
+        }
+        status = ccl_sched_entry_status_complete;
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "region ",
+                           region,
+                           ", local_rank ",
+                           local_rank,
+                           ", local_size ",
+                           local_size,
+                           ", epoch ",
+                           epoch,
+                           "\n");
+    }
+
+private:
+    const ccl_shm_binding* binding;
+    ccl_shm_region* region = nullptr;
+    int local_rank;
+    int local_size;
+    uint64_t epoch = 0;
+};
@@ -78,6 +78,7 @@ public:
         subsched->renew();
         subsched->bin = sched->bin;
         subsched->queue = sched->queue;
+        subsched->get_memory().buffer_manager.set_instance_idx(sched->queue->get_idx());
         subsched->sched_id = sched->sched_id;
         status = ccl_sched_entry_status_started;
     }
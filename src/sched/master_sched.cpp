@@ -23,6 +23,7 @@
 #include "sched/entry/factory/entry_factory.hpp"
 #include "sched/extra_sched.hpp"
 #include "sched/master_sched.hpp"
+#include "sched/sched_tracer.hpp"
 #include "sched/queue/queue.hpp"
 
 #ifdef CCL_ENABLE_SYCL
@@ -156,6 +157,10 @@ ccl_request* ccl_master_sched::start(ccl_executor* exec, bool reset_sched) {
 
     LOG_DEBUG("starting schedule ", this, ", type ", ccl_coll_type_to_str(coll_param.ctype));
 
+    if (ccl::global_data::get().sched_tracer || ccl::global_data::get().metrics_collector) {
+        start_time_ns = ccl::sched_tracer::now();
+    }
+
 #ifdef CCL_ENABLE_SYCL
     if (ccl::global_data::env().enable_kernel_profile) {
         get_kernel_timer().set_operation_start_time(ccl::kernel_timer::get_current_time());
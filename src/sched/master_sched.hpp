@@ -50,6 +50,16 @@ public:
     // TODO encapsulate it in private.
     std::vector<std::shared_ptr<ccl_sched>> partial_scheds;
 
+    /* start time of collective, reported to sched tracer and metrics collector */
+    uint64_t start_time_ns = 0;
+
+    /* algorithm is selected in partial or coll entry sub-schedule, propagated on its completion */
+    std::atomic<const char*> coll_algo_name{ nullptr };
+
+    /* state of cached schedule, protected by lock of ccl_sched_cache shard */
+    size_t cache_shard_idx = 0;
+    size_t cache_ref_count = 0;
+
     // TODO: wrap into smart-pointer
     using ccl_master_sched_ptr = ccl_master_sched*;
     static ccl_master_sched_ptr create(const ccl_coll_param& param, const ccl_coll_attr& attr);
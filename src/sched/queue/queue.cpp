@@ -36,23 +36,12 @@ void ccl_sched_bin::add(ccl_sched* sched) {
 }
 
 size_t ccl_sched_bin::erase(size_t idx, size_t& next_idx) {
-    ccl_sched* sched = nullptr;
-    size_t size = 0;
-    {
-        std::lock_guard<sched_queue_lock_t> lock(sched_list.elem_guard);
-        size = sched_list.elems.size();
-        CCL_THROW_IF_NOT(size > 0, "unexpected sched_list size ", size);
-        CCL_ASSERT(idx < size);
-        sched = sched_list.elems[idx];
-        sched->set_in_bin_status(ccl_sched_in_bin_erased);
-        sched->bin = nullptr;
-        size--;
-        std::swap(sched_list.elems[size], sched_list.elems[idx]);
-        sched_list.elems.resize(size);
-        CCL_ASSERT(sched_list.elems.size() == (size));
-        next_idx = idx;
-    }
-    return size;
+    size_t size = sched_list.size();
+    CCL_THROW_IF_NOT(size > 0, "unexpected sched_list size ", size);
+    ccl_sched* sched = sched_list.remove(idx, next_idx);
+    sched->set_in_bin_status(ccl_sched_in_bin_erased);
+    sched->bin = nullptr;
+    return sched_list.size();
 }
 
 ccl_sched_queue::ccl_sched_queue(size_t idx, std::vector<size_t> atl_eps)
@@ -101,6 +90,22 @@ void ccl_sched_queue::add(ccl_sched* sched) {
     CCL_ASSERT(sched);
     CCL_ASSERT(!sched->bin);
 
+    sched->queue = this;
+    sched->get_memory().buffer_manager.set_instance_idx(idx);
+    sched->set_in_bin_status(ccl_sched_in_bin_added);
+
+    LOG_DEBUG("add to intake: sched ", sched);
+
+    intake.push(sched);
+}
+
+size_t ccl_sched_queue::drain() {
+    return intake.drain([this](ccl_sched* sched) {
+        add_to_bin(sched);
+    });
+}
+
+void ccl_sched_queue::add_to_bin(ccl_sched* sched) {
     size_t priority = sched->get_priority();
     if (ccl::global_data::env().priority_mode != ccl_priority_none) {
         if (sched->coll_param.ctype == ccl_coll_barrier) {
@@ -109,14 +114,10 @@ void ccl_sched_queue::add(ccl_sched* sched) {
         }
     }
 
-    sched->set_in_bin_status(ccl_sched_in_bin_added);
-
     LOG_DEBUG("add to bin: sched ", sched, ", priority ", priority);
 
     ccl_sched_bin* bin = nullptr;
 
-    std::lock_guard<sched_queue_lock_t> lock(bins_guard);
-
     sched_bin_list_t::iterator it = bins.find(priority);
     if (it != bins.end()) {
         bin = &(it->second);
@@ -158,31 +159,22 @@ size_t ccl_sched_queue::erase(ccl_sched_bin* bin, size_t idx) {
     LOG_DEBUG("queue ", this, ", bin ", bin);
     size_t next_idx = 0;
 
-    // erase sched and check bin size after
-    // no need to lock whole `bins` for single erase
     if (!bin->erase(idx, next_idx)) {
-        // 'bin 'looks like empty, we can erase it from 'bins'.
-        // double check on bin.empty(), before remove it from whole table
-        std::lock_guard<sched_queue_lock_t> lock{ bins_guard };
-        {
-            // no need to lock 'bin' here, because all adding are under bins_guard protection
-            if (bin->sched_list.elems.empty() /* && (bins.size() > 1)*/) {
-                bins.erase(bin_priority);
-
-                // change priority
-                if (bins.empty()) {
-                    max_priority = 0;
-                    cached_max_priority_bin = nullptr;
-                }
-                else if (bin_priority == max_priority) {
-                    max_priority--;
-                    sched_bin_list_t::iterator it;
-                    while ((it = bins.find(max_priority)) == bins.end()) {
-                        max_priority--;
-                    }
-                    cached_max_priority_bin = &(it->second);
-                }
-            } // or do nothing, because somebody added new element in bin while we getting a lock
+        // bin is empty, remove it from 'bins'
+        bins.erase(bin_priority);
+
+        // change priority
+        if (bins.empty()) {
+            max_priority = 0;
+            cached_max_priority_bin = nullptr;
+        }
+        else if (bin_priority == max_priority) {
+            max_priority--;
+            sched_bin_list_t::iterator it;
+            while ((it = bins.find(max_priority)) == bins.end()) {
+                max_priority--;
+            }
+            cached_max_priority_bin = &(it->second);
         }
     }
 
@@ -190,11 +182,12 @@ size_t ccl_sched_queue::erase(ccl_sched_bin* bin, size_t idx) {
 }
 
 ccl_sched_bin* ccl_sched_queue::peek() {
+    drain();
     return cached_max_priority_bin;
 }
 
 std::vector<ccl_sched_bin*> ccl_sched_queue::peek_all() {
-    std::lock_guard<sched_queue_lock_t> lock{ bins_guard };
+    drain();
     std::vector<ccl_sched_bin*> result;
     result.reserve(bins.size());
     for (auto& bin : bins) {
@@ -204,6 +197,7 @@ std::vector<ccl_sched_bin*> ccl_sched_queue::peek_all() {
 }
 
 void ccl_sched_queue::clear() {
+    intake.clear();
     cached_max_priority_bin = nullptr;
     bins.clear();
     max_priority = 0;
@@ -15,7 +15,7 @@
 */
 #pragma once
 
-#include "common/utils/spinlock.hpp"
+#include "common/utils/mpsc_queue.hpp"
 #include "exec/exec.hpp"
 #include "sched/sched.hpp"
 
@@ -26,7 +26,7 @@
 
 using sched_container_t = std::vector<ccl_sched*>;
 using sched_bin_list_t = std::unordered_map<size_t, ccl_sched_bin>; // key - priority
-using sched_queue_lock_t = ccl_spinlock;
+using sched_intake_t = ccl_mpsc_queue<ccl_sched, &ccl_sched::intake_next>;
 
 /* ATL EP is limited resource, each priority bucket consumes single ATL EP and uses it for all bins in bucket */
 #define CCL_PRIORITY_BUCKET_COUNT (1)
@@ -35,6 +35,7 @@ using sched_queue_lock_t = ccl_spinlock;
 #define CCL_PRIORITY_BUCKET_SIZE (8)
 
 #define CCL_BUCKET_INITIAL_ELEMS_COUNT (1024)
+/* accessed by the queue consumer only, user threads submit through the intake of ccl_sched_queue */
 class ccl_sched_list {
 public:
     friend class ccl_sched_bin;
@@ -64,87 +65,52 @@ public:
 
     ccl_sched_list& operator=(const ccl_sched_list& other) = delete;
 
-    ccl_sched_list(ccl_sched_list&& src) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(src.elem_guard);
-            elems = std::move(src.elems);
-        }
-    }
-    ccl_sched_list& operator=(ccl_sched_list&& other) {
-        if (this != &other) {
-            std::lock(this->elem_guard, other.elem_guard);
-            elems = std::move(other.elems);
-            // make sure both already-locked mutexes are unlocked at the end of scope
-            std::lock_guard<ccl_spinlock> own_lock(this->elem_guard, std::adopt_lock);
-            std::lock_guard<ccl_spinlock> other_lock(other.elem_guard, std::adopt_lock);
-        }
-        return *this;
-    }
+    ccl_sched_list(ccl_sched_list&& src) = default;
+    ccl_sched_list& operator=(ccl_sched_list&& other) = default;
 
     void add(ccl_sched* sched) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            elems.emplace_back(sched);
-        }
+        elems.emplace_back(sched);
     }
 
     size_t size() const {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            return elems.size();
-        }
+        return elems.size();
     }
 
-    bool empty() {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            return elems.empty();
-        }
+    bool empty() const {
+        return elems.empty();
     }
 
-    ccl_sched* get(size_t idx) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            CCL_ASSERT(idx < elems.size());
-            return elems[idx];
-        }
+    ccl_sched* get(size_t idx) const {
+        CCL_ASSERT(idx < elems.size());
+        return elems[idx];
     }
 
     ccl_sched* remove(size_t idx, size_t& next_idx) {
-        ccl_sched* ret = nullptr;
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            size_t size = elems.size();
-            CCL_ASSERT(idx < size);
-            ret = elems[idx];
-            std::swap(elems[size - 1], elems[idx]);
-            elems.resize(size - 1);
-            CCL_ASSERT(elems.size() == (size - 1));
-            next_idx = idx;
-        }
+        size_t size = elems.size();
+        CCL_ASSERT(idx < size);
+        ccl_sched* ret = elems[idx];
+        std::swap(elems[size - 1], elems[idx]);
+        elems.resize(size - 1);
+        next_idx = idx;
         return ret;
     }
 
     void dump(std::ostream& out) const {
-        {
-            auto sched_dump = ccl::global_data::env().sched_dump;
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            if (sched_dump) {
-                for (auto& e : elems) {
-                    e->dump(out);
-                }
+        auto sched_dump = ccl::global_data::env().sched_dump;
+        if (sched_dump) {
+            for (auto& e : elems) {
+                e->dump(out);
             }
-            else {
-                for (size_t idx = 0; idx < elems.size(); idx++) {
-                    out << "    [" << idx
-                        << "]: " << ccl_coll_type_to_str(elems[idx]->coll_param.ctype) << "\n";
-                }
+        }
+        else {
+            for (size_t idx = 0; idx < elems.size(); idx++) {
+                out << "    [" << idx << "]: " << ccl_coll_type_to_str(elems[idx]->coll_param.ctype)
+                    << "\n";
             }
         }
     }
 
 private:
-    mutable sched_queue_lock_t elem_guard{};
     sched_container_t elems;
     char padding_queue[CACHELINE_SIZE];
 };
@@ -203,6 +169,12 @@ private:
     size_t priority{}; //!< the single priority for all elems
 };
 
+/*
+   schedules are submitted from any thread through lock-free intake,
+   the consumer moves them into priority bins on drain,
+   there is a single consumer at a time: ccl_worker::do_work holds progress_guard
+   around drain/peek/erase, so bins don't need own locks
+*/
 class ccl_sched_queue {
 public:
     ccl_sched_queue(size_t idx, std::vector<size_t> atl_eps);
@@ -214,13 +186,17 @@ public:
 
     size_t get_idx() const;
 
+    /* can be called from any thread */
     void add(ccl_sched* sched);
+
+    /* consumer only, moves submitted schedules into bins */
+    size_t drain();
+
     size_t erase(ccl_sched_bin* bin, size_t idx);
     void clear();
 
     /**
-     * Retrieve a pointer to the bin with the highest priority and number of its elements
-     * @param bin_size[out] the current number of elements in bin. May have a zero if the queue has no bins with elements
+     * Retrieve a pointer to the bin with the highest priority
      * @return a pointer to the bin with the highest priority or nullptr if there is no bins with content
      */
     ccl_sched_bin* peek();
@@ -228,26 +204,25 @@ public:
     std::vector<ccl_sched_bin*> peek_all();
 
     void dump(std::ostream& out) const {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(bins_guard);
-            out << "{\n";
-            out << "  sched_queue: idx: " << idx << " size: " << bins.size() << "\n";
-            size_t idx = 0;
-            for (auto& bin : bins) {
-                out << "   bin: idx: " << idx << " priority: " << bin.first
-                    << " size: " << bin.second.size() << "\n";
-                bin.second.dump(out);
-            }
-            out << "}\n";
+        out << "{\n";
+        out << "  sched_queue: idx: " << idx << " size: " << bins.size() << "\n";
+        size_t idx = 0;
+        for (auto& bin : bins) {
+            out << "   bin: idx: " << idx << " priority: " << bin.first
+                << " size: " << bin.second.size() << "\n";
+            bin.second.dump(out);
         }
+        out << "}\n";
     }
 
 private:
-    mutable sched_queue_lock_t bins_guard{};
+    void add_to_bin(ccl_sched* sched);
+
+    sched_intake_t intake{};
 
     size_t idx;
     std::vector<size_t> atl_eps;
     sched_bin_list_t bins{ CCL_SCHED_QUEUE_INITIAL_BIN_COUNT };
     size_t max_priority = 0;
-    std::atomic<ccl_sched_bin*> cached_max_priority_bin{};
+    ccl_sched_bin* cached_max_priority_bin = nullptr;
 };
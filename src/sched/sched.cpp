@@ -13,12 +13,17 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <numeric>
+
 #include "common/global/global.hpp"
+#include "common/metrics/metrics.hpp"
 #include "common/utils/sync_object.hpp"
 #include "parallelizer/parallelizer.hpp"
 #include "sched/extra_sched.hpp"
+#include "sched/master_sched.hpp"
 #include "sched/queue/queue.hpp"
 #include "sched/sched.hpp"
+#include "sched/sched_tracer.hpp"
 
 ccl_sched::ccl_sched(const ccl_sched_create_param& param,
                      ccl_request* master_request,
@@ -144,7 +149,84 @@ void ccl_sched::complete() {
     }
 #endif // CCL_ENABLE_SYCL
 
-    req->complete();
+    auto& tracer = ccl::global_data::get().sched_tracer;
+    auto& metrics = ccl::global_data::get().metrics_collector;
+    if (!tracer && !metrics) {
+        req->complete();
+        return;
+    }
+
+    if (master_sched && algo_name) {
+        master_sched->coll_algo_name.store(algo_name, std::memory_order_relaxed);
+    }
+
+    /* partial scheds have own coll type, the original one is kept in master sched */
+    ccl_coll_type ctype = (master_sched) ? master_sched->coll_param.ctype : coll_param.ctype;
+    uint64_t end_ns = ccl::sched_tracer::now();
+
+    ccl::sched_trace_event event;
+    if (tracer) {
+        event.set_name(ccl_coll_type_to_str(ctype));
+        event.category = "sched";
+        event.algo = algo_name;
+        event.begin_ns = trace_begin_ns;
+        event.end_ns = end_ns;
+        event.sched_id = sched_id;
+        tracer->record(event);
+    }
+
+    /*
+       the last completed partial sched closes span of the whole collective,
+       master sched can be released right after completion so its fields are read in advance
+    */
+    bool is_partial = (master_sched && req == master_sched);
+    const char* coll_algo_name = nullptr;
+    bool record_metrics = false;
+    ccl_comm_id_t comm_id = 0;
+    uint64_t coll_time_ns = 0;
+    size_t coll_bytes = 0;
+    if (is_partial) {
+        const ccl_coll_param& master_param = master_sched->coll_param;
+        coll_algo_name = master_sched->coll_algo_name.load(std::memory_order_relaxed);
+        coll_bytes = std::accumulate(master_param.send_counts.begin(),
+                                     master_param.send_counts.end(),
+                                     size_t(0)) *
+                     master_param.dtype.size();
+
+        if (tracer) {
+            event.category = "coll";
+            event.algo = coll_algo_name;
+            event.begin_ns = master_sched->start_time_ns;
+            event.bytes = coll_bytes;
+            if (master_param.comm) {
+                tracer->set_rank(
+                    master_param.comm->get_global_rank(master_param.comm->rank(), true));
+            }
+        }
+
+        if (metrics && master_param.comm && master_sched->start_time_ns) {
+            record_metrics = true;
+            comm_id = master_param.comm->id();
+            coll_time_ns = end_ns - std::min(end_ns, master_sched->start_time_ns);
+        }
+    }
+
+    if (record_metrics) {
+        metrics->begin_record();
+    }
+
+    if (req->complete() && is_partial) {
+        if (tracer) {
+            tracer->record(event);
+        }
+        if (record_metrics) {
+            metrics->record(comm_id, ctype, coll_algo_name, coll_bytes, coll_time_ns);
+        }
+    }
+
+    if (record_metrics) {
+        metrics->end_record();
+    }
 }
 
 void ccl_sched::renew(bool need_update_id) {
@@ -158,6 +240,10 @@ void ccl_sched::renew(bool need_update_id) {
         timer.start();
     }
 
+    if (ccl::global_data::get().sched_tracer) {
+        trace_begin_ns = ccl::sched_tracer::now();
+    }
+
     for (size_t idx = 0; idx < entries.size(); idx++) {
         entries[idx].get()->reset(idx);
     }
@@ -232,6 +318,11 @@ size_t ccl_sched::entries_count() const {
     return entries.size();
 }
 
+bool ccl_sched::is_regular_partial() const {
+    return (sched_type == ccl_sched_regular) && master_sched &&
+           (req == static_cast<ccl_request*>(master_sched));
+}
+
 ccl_comm_id_t ccl_sched::get_comm_id() {
     return coll_param.comm->id();
 }
@@ -95,7 +95,15 @@ public:
     using ccl_sched_base::add_entry_back_t;
     using add_entry_default_t = add_entry_mode_t<ccl_sched_add_mode_last_value>;
 
-    sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry) {
+    /* entries are placed in arena of schedule, so only destructor is called */
+    struct sched_entry_deleter {
+        void operator()(sched_entry* entry) const {
+            entry->~sched_entry();
+        }
+    };
+    using sched_entry_ptr = std::unique_ptr<sched_entry, sched_entry_deleter>;
+
+    sched_entry* add_entry(sched_entry_ptr&& entry) {
         entry->set_exec_mode(exec_mode);
 
         sched_entry* raw_ptr = entry.get();
@@ -112,12 +120,12 @@ public:
     /**
      * Policy-based add_entry
      */
-    sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry,
+    sched_entry* add_entry(sched_entry_ptr&& entry,
                            add_entry_mode_t<ccl_sched_add_mode_last_value>) {
         return add_entry(std::move(entry));
     }
 
-    sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry, add_entry_front_t) {
+    sched_entry* add_entry(sched_entry_ptr&& entry, add_entry_front_t) {
         entry->set_exec_mode(exec_mode);
 
         sched_entry* raw_ptr = entry.get();
@@ -125,7 +133,7 @@ public:
         return raw_ptr;
     }
 
-    sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry, add_entry_back_t) {
+    sched_entry* add_entry(sched_entry_ptr&& entry, add_entry_back_t) {
         entry->set_exec_mode(exec_mode);
 
         sched_entry* raw_ptr = entry.get();
@@ -145,6 +153,7 @@ public:
 
     ccl_sched_bin* bin = nullptr; /* valid only during execution */
     ccl_sched_queue* queue = nullptr; /* cached pointer to queue, valid even after execution */
+    ccl_sched* intake_next = nullptr; /* link in intake of sched_queue, owned by the queue */
     size_t start_idx = 0; /* index to start */
 
     /*
@@ -153,10 +162,15 @@ public:
     */
     ccl_op_id_t op_id = 0;
 
+    /* selected algorithm and start time of schedule, reported to sched tracer */
+    const char* algo_name = nullptr;
+    uint64_t trace_begin_ns = 0;
+
     /* to track status of schedule wrt execution bin, not atomic as updated by single thread in time */
     ccl_sched_in_bin_status in_bin_status = ccl_sched_in_bin_none;
 
-    using sched_entry_ptr = std::unique_ptr<sched_entry>;
+    /* holds memory of entries, so it has to be declared before them */
+    ccl::sched_arena entry_arena;
     std::deque<sched_entry_ptr> entries{};
 
     /* whether sched should be executed in the same order as in user code */
@@ -184,6 +198,9 @@ public:
     void dump(std::ostream& out) const;
     size_t entries_count() const;
 
+    /* partial schedule of regular master schedule, built and started from user call */
+    bool is_regular_partial() const;
+
 private:
     ccl_sched_finalize_fn_t finalize_fn = nullptr;
     void* finalize_fn_ctx = nullptr;
@@ -54,6 +54,7 @@ ccl_sched_base::~ccl_sched_base() {
 
 void ccl_sched_base::set_coll_attr(const ccl_coll_attr& attr) {
     coll_attr = attr;
+    hint_algo = attr.hint_algo;
 }
 
 void ccl_sched_base::update_coll_param_and_attr(const ccl_coll_param& param,
@@ -153,6 +154,11 @@ ccl_buffer ccl_sched_base::alloc_buffer(const ccl::alloc_param& user_param) {
         param.buf_place = ccl::buffer_place::host;
     }
 
+    if (param.buf_type == ccl::buffer_type::regular && param.is_managed && param.bytes &&
+        param.bytes <= CCL_SCHED_ARENA_MAX_BUFFER_SIZE) {
+        return ccl_buffer(memory.arena.alloc(param.bytes, CACHELINE_SIZE), param.bytes);
+    }
+
     return ccl_buffer(memory.buffer_manager.alloc(param), param.bytes);
 }
 
@@ -165,11 +171,17 @@ void ccl_sched_base::dealloc_buffer(const ccl::dealloc_param& user_param) {
     }
 #endif // CCL_ENABLE_SYCL
 
+    if (memory.arena.contains(param.ptr)) {
+        /* released together with the rest of arena */
+        return;
+    }
+
     memory.buffer_manager.dealloc(param);
 }
 
 void ccl_sched_base::clear_memory() {
     memory.buffer_manager.clear();
+    memory.arena.reset();
 #ifdef CCL_ENABLE_ZE
     if (coll_param.stream &&
         coll_param.stream->get_backend() == ccl::utils::get_level_zero_backend()) {
@@ -25,6 +25,7 @@
 #include "common/request/request.hpp"
 #include "common/utils/buffer.hpp"
 #include "sched/buffer/buffer_manager.hpp"
+#include "sched/buffer/sched_arena.hpp"
 #include "sched/entry/entry.hpp"
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
@@ -51,6 +52,8 @@ std::string to_string(ccl_sched_add_mode mode);
 
 struct ccl_sched_memory {
     ccl::buffer_manager buffer_manager;
+    /* small managed host buffers, dropped together in clear_memory */
+    ccl::sched_arena arena;
 #ifdef CCL_ENABLE_ZE
     ccl::ze::ipc_handle_manager handle_manager;
     ccl::ze::ipc_event_pool_manager ipc_event_pool_manager;
@@ -0,0 +1,178 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+#include "common/log/log.hpp"
+#include "sched/sched_tracer.hpp"
+
+namespace ccl {
+
+/* thread-local ring is bound to tracer instance, it becomes stale after re-initialization */
+static std::atomic<uint64_t> tracer_instance_counter{ 0 };
+
+static thread_local int trace_thread_idx = -1;
+static thread_local uint64_t trace_ring_instance_id = 0;
+static thread_local void* trace_ring = nullptr;
+
+/* user threads get their tracks after workers */
+#define CCL_SCHED_TRACE_USER_TID_BASE (1000)
+
+void sched_trace_event::set_name(const char* value) {
+    strncpy(name, value, CCL_SCHED_TRACE_NAME_SIZE - 1);
+    name[CCL_SCHED_TRACE_NAME_SIZE - 1] = '\0';
+}
+
+sched_tracer::sched_tracer(const std::string& file_prefix, size_t ring_size)
+        : file_prefix(file_prefix),
+          ring_size(ring_size),
+          instance_id(++tracer_instance_counter) {
+    LOG_INFO("sched tracer is enabled, file prefix ", file_prefix, ", ring size ", ring_size);
+}
+
+sched_tracer::~sched_tracer() {
+    dump();
+}
+
+uint64_t sched_tracer::now() noexcept {
+    /* wall clock to align timelines of ranks from different nodes */
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void sched_tracer::set_thread_idx(int idx) {
+    trace_thread_idx = idx;
+}
+
+void sched_tracer::set_rank(int value) {
+    int expected = -1;
+    rank.compare_exchange_strong(expected, value);
+}
+
+sched_tracer::ring_t* sched_tracer::get_ring() {
+    if (trace_ring && trace_ring_instance_id == instance_id) {
+        return static_cast<ring_t*>(trace_ring);
+    }
+
+    std::unique_ptr<ring_t> ring(new ring_t);
+    ring->events.resize(ring_size);
+
+    std::lock_guard<std::mutex> lock(guard);
+    if (trace_thread_idx >= 0) {
+        ring->tid = trace_thread_idx;
+        ring->thread_name = "worker " + std::to_string(trace_thread_idx);
+    }
+    else {
+        ring->tid = CCL_SCHED_TRACE_USER_TID_BASE + static_cast<int>(rings.size());
+        ring->thread_name = "user thread " + std::to_string(ring->tid);
+    }
+    rings.push_back(std::move(ring));
+
+    trace_ring = rings.back().get();
+    trace_ring_instance_id = instance_id;
+    return rings.back().get();
+}
+
+void sched_tracer::record(const sched_trace_event& event) {
+    /* single producer per ring, no locks on hot path */
+    ring_t* ring = get_ring();
+    size_t idx = ring->write_idx.load(std::memory_order_relaxed);
+    ring->begin_idx.store(idx + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->events[idx % ring_size] = event;
+    ring->write_idx.store(idx + 1, std::memory_order_release);
+}
+
+void sched_tracer::dump() {
+    int pid = rank.load();
+    if (pid < 0) {
+        pid = getpid();
+    }
+
+    std::string file_name = file_prefix + "." + std::to_string(pid) + ".json";
+    std::ofstream file(file_name);
+    if (!file.is_open()) {
+        LOG_WARN("can not open sched trace file ", file_name);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(guard);
+
+    size_t event_count = 0;
+    size_t dropped_count = 0;
+
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+         << ",\"args\":{\"name\":\"rank " << pid << "\"}}";
+    file << std::fixed << std::setprecision(3);
+
+    for (auto& ring : rings) {
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+             << ",\"tid\":" << ring->tid << ",\"args\":{\"name\":\"" << ring->thread_name
+             << "\"}}";
+
+        /* owner thread can still record, so events are copied and then validated */
+        size_t write_idx = ring->write_idx.load(std::memory_order_acquire);
+        size_t copy_idx = (write_idx > ring_size) ? write_idx - ring_size : 0;
+        std::vector<sched_trace_event> events(write_idx - copy_idx);
+        for (size_t idx = copy_idx; idx < write_idx; idx++) {
+            events[idx - copy_idx] = ring->events[idx % ring_size];
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t begin_idx = ring->begin_idx.load(std::memory_order_relaxed);
+
+        /* slots of older events could be overwritten during copy */
+        size_t first_idx = (begin_idx > ring_size) ? begin_idx - ring_size : 0;
+        first_idx = std::min(std::max(first_idx, copy_idx), write_idx);
+        dropped_count += first_idx;
+
+        for (size_t idx = first_idx; idx < write_idx; idx++) {
+            const sched_trace_event& event = events[idx - copy_idx];
+            file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                 << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << ring->tid
+                 << ",\"ts\":" << event.begin_ns / 1000.0
+                 << ",\"dur\":" << (event.end_ns - event.begin_ns) / 1000.0
+                 << ",\"args\":{\"sched\":" << event.sched_id;
+            if (event.algo) {
+                file << ",\"algo\":\"" << event.algo << "\"";
+            }
+            if (event.peer >= 0) {
+                file << ",\"peer\":" << event.peer;
+            }
+            if (event.bytes) {
+                file << ",\"bytes\":" << event.bytes;
+            }
+            file << "}}";
+            event_count++;
+        }
+    }
+
+    file << "\n]}\n";
+
+    LOG_INFO("dumped ",
+             event_count,
+             " sched trace events to ",
+             file_name,
+             (dropped_count) ? ", dropped " : "",
+             (dropped_count) ? std::to_string(dropped_count) : "");
+}
+
+} // namespace ccl
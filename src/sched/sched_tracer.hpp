@@ -0,0 +1,93 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ccl {
+
+#define CCL_SCHED_TRACE_NAME_SIZE (32)
+
+struct sched_trace_event {
+    /* name is copied as entry can be destroyed before dump */
+    char name[CCL_SCHED_TRACE_NAME_SIZE] = {};
+
+    /* category and algo point to static strings */
+    const char* category = nullptr;
+    const char* algo = nullptr;
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+    uint64_t sched_id = 0;
+    int peer = -1;
+    size_t bytes = 0;
+
+    void set_name(const char* value);
+};
+
+/*
+   records timeline of collectives, schedules and entries
+   into per-thread rings (the oldest events are overwritten)
+   and dumps it in Chrome trace format to <prefix>.<rank>.json,
+   the file can be opened in chrome://tracing or Perfetto UI
+*/
+class sched_tracer {
+public:
+    sched_tracer(const std::string& file_prefix, size_t ring_size);
+    sched_tracer(const sched_tracer&) = delete;
+    sched_tracer& operator=(const sched_tracer&) = delete;
+    ~sched_tracer();
+
+    static uint64_t now() noexcept;
+
+    /* called by worker thread to get its own track in timeline */
+    static void set_thread_idx(int idx);
+
+    void set_rank(int rank);
+    void record(const sched_trace_event& event);
+    void dump();
+
+private:
+    /*
+       seqlock over ring: writer bumps begin_idx before it overwrites the slot
+       and write_idx after, reader drops the events which were overwritten while it copied them
+    */
+    struct ring_t {
+        std::vector<sched_trace_event> events;
+        std::atomic<size_t> begin_idx{ 0 };
+        std::atomic<size_t> write_idx{ 0 };
+        int tid;
+        std::string thread_name;
+    };
+
+    ring_t* get_ring();
+
+    const std::string file_prefix;
+    const size_t ring_size;
+    const uint64_t instance_id;
+
+    std::atomic<int> rank{ -1 };
+
+    std::mutex guard;
+    std::vector<std::unique_ptr<ring_t>> rings;
+};
+
+} // namespace ccl
@@ -0,0 +1,118 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <vector>
+
+#include "transport.hpp"
+#include "utils.hpp"
+
+#define METRICS_OP_COUNT 5
+
+/* power-of-two message sizes, each of them is the upper bound of its own size bucket */
+static const size_t metrics_elem_counts[] = { 16, 8192 };
+
+static std::vector<ccl::coll_metrics> get_allreduce_metrics(const ccl::metrics& metrics,
+                                                            size_t bytes) {
+    std::vector<ccl::coll_metrics> result;
+    for (const auto& coll : metrics.colls) {
+        if (coll.coll_name == "allreduce" && coll.size_bucket == bytes) {
+            result.push_back(coll);
+        }
+    }
+    return result;
+}
+
+static size_t get_allreduce_count(const ccl::metrics& metrics, size_t bytes) {
+    size_t count = 0;
+    for (const auto& coll : get_allreduce_metrics(metrics, bytes)) {
+        count += coll.count;
+    }
+    return count;
+}
+
+static void run_allreduces(ccl::communicator& comm, size_t elem_count) {
+    std::vector<float> send_buf(elem_count, 1.0f);
+    std::vector<float> recv_buf(elem_count, 0.0f);
+
+    for (size_t op_idx = 0; op_idx < METRICS_OP_COUNT; op_idx++) {
+        ccl::allreduce(send_buf.data(), recv_buf.data(), elem_count, ccl::reduction::sum, comm)
+            .wait();
+    }
+}
+
+TEST(metrics_test, allreduce_counts_and_histograms) {
+    auto& comm = transport_data::instance().get_comm();
+
+    ccl::preview::reset_metrics();
+
+    for (size_t elem_count : metrics_elem_counts) {
+        run_allreduces(comm, elem_count);
+    }
+
+    /* operation is in metrics as soon as it is completed for user */
+    ccl::metrics comm_metrics = ccl::preview::get_metrics(comm);
+    ccl::metrics all_metrics = ccl::preview::get_metrics();
+
+    EXPECT_GT(comm_metrics.transport.length(), size_t(0));
+    EXPECT_EQ(comm_metrics.transport, all_metrics.transport);
+
+    for (size_t elem_count : metrics_elem_counts) {
+        size_t bytes = elem_count * sizeof(float);
+        auto colls = get_allreduce_metrics(comm_metrics, bytes);
+        ASSERT_FALSE(colls.empty()) << "no allreduce metrics for " << bytes << " bytes";
+
+        EXPECT_EQ(size_t(METRICS_OP_COUNT), get_allreduce_count(comm_metrics, bytes));
+        EXPECT_LE(get_allreduce_count(comm_metrics, bytes),
+                  get_allreduce_count(all_metrics, bytes));
+
+        for (const auto& coll : colls) {
+            EXPECT_GT(coll.algo_name.length(), size_t(0));
+            EXPECT_EQ(coll.count * bytes, coll.bytes);
+
+            EXPECT_LE(coll.min_time_usec, coll.avg_time_usec);
+            EXPECT_LE(coll.avg_time_usec, coll.max_time_usec);
+            EXPECT_LE(coll.min_time_usec, coll.p50_time_usec);
+            EXPECT_LE(coll.p50_time_usec, coll.p90_time_usec);
+            EXPECT_LE(coll.p90_time_usec, coll.p99_time_usec);
+            EXPECT_LE(coll.p99_time_usec, coll.max_time_usec);
+
+            /* every operation is in exactly one bucket, buckets are sorted by upper bound */
+            size_t hist_count = 0;
+            double prev_bound = 0;
+            for (const auto& bucket : coll.latency_histogram) {
+                EXPECT_LT(prev_bound, bucket.first);
+                EXPECT_GT(bucket.second, size_t(0));
+                prev_bound = bucket.first;
+                hist_count += bucket.second;
+            }
+            EXPECT_EQ(coll.count, hist_count);
+        }
+    }
+
+    ccl::preview::reset_metrics();
+
+    comm_metrics = ccl::preview::get_metrics(comm);
+    for (size_t elem_count : metrics_elem_counts) {
+        EXPECT_EQ(size_t(0), get_allreduce_count(comm_metrics, elem_count * sizeof(float)));
+    }
+
+    /* metrics are collected again after reset */
+    run_allreduces(comm, metrics_elem_counts[0]);
+    comm_metrics = ccl::preview::get_metrics(comm);
+    EXPECT_EQ(size_t(METRICS_OP_COUNT),
+              get_allreduce_count(comm_metrics, metrics_elem_counts[0] * sizeof(float)));
+}
+
+MAIN_FUNCTION();
@@ -0,0 +1,210 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "comp/simd/simd.hpp"
+
+/*
+   checks vector reduction kernels against scalar reference
+   which follows CCL_REDUCE from comp.cpp
+*/
+
+namespace {
+
+/* cover empty buffer, pure tails, one and two full vectors of any width, mixed */
+const std::vector<size_t> elem_counts = { 0,  1,   3,   7,   15,  16,  31,  32,
+                                          63, 64, 65, 127, 128, 129, 255, 1000 };
+
+const std::vector<ccl::reduction> reductions = { ccl::reduction::sum,
+                                                 ccl::reduction::prod,
+                                                 ccl::reduction::min,
+                                                 ccl::reduction::max };
+
+template <class T>
+T reference_reduce(T in, T inout, ccl::reduction reduction) {
+    switch (reduction) {
+        case ccl::reduction::sum: inout += in; break;
+        case ccl::reduction::prod: inout *= in; break;
+        case ccl::reduction::min: inout = std::min(in, inout); break;
+        case ccl::reduction::max: inout = std::max(in, inout); break;
+        default: break;
+    }
+    return inout;
+}
+
+template <class T>
+bool is_same_value(T expected, T actual) {
+    return std::memcmp(&expected, &actual, sizeof(T)) == 0;
+}
+
+template <>
+bool is_same_value<float>(float expected, float actual) {
+    /* NaN payload is not specified, sign of zero is */
+    if (std::isnan(expected) || std::isnan(actual))
+        return std::isnan(expected) && std::isnan(actual);
+    return std::memcmp(&expected, &actual, sizeof(float)) == 0;
+}
+
+template <>
+bool is_same_value<double>(double expected, double actual) {
+    if (std::isnan(expected) || std::isnan(actual))
+        return std::isnan(expected) && std::isnan(actual);
+    return std::memcmp(&expected, &actual, sizeof(double)) == 0;
+}
+
+/* small values keep signed products in range */
+template <class T>
+void fill(std::vector<T>& buf, std::mt19937& gen) {
+    std::uniform_int_distribution<int> dist(std::is_signed<T>::value ? -100 : 0, 100);
+    for (auto& v : buf)
+        v = static_cast<T>(dist(gen));
+}
+
+template <class T>
+void fill_fp(std::vector<T>& buf, std::mt19937& gen) {
+    std::uniform_real_distribution<T> dist(-100, 100);
+    const T special[] = { std::numeric_limits<T>::quiet_NaN(),
+                          std::numeric_limits<T>::infinity(),
+                          -std::numeric_limits<T>::infinity(),
+                          T(0),
+                          -T(0) };
+    std::uniform_int_distribution<size_t> special_dist(0, sizeof(special) / sizeof(T) - 1);
+    for (auto& v : buf) {
+        /* every 4th value on average is special */
+        v = (gen() % 4 == 0) ? special[special_dist(gen)] : dist(gen);
+    }
+}
+
+template <>
+void fill<float>(std::vector<float>& buf, std::mt19937& gen) {
+    fill_fp(buf, gen);
+}
+
+template <>
+void fill<double>(std::vector<double>& buf, std::mt19937& gen) {
+    fill_fp(buf, gen);
+}
+
+template <class T>
+void check_reduce(ccl::datatype dtype) {
+    std::mt19937 gen(static_cast<unsigned>(dtype) + 1);
+
+    for (auto impl_type : ccl_simd_get_impl_types()) {
+        if (impl_type == ccl_simd_scalar)
+            continue;
+
+        for (auto reduction : reductions) {
+            ccl_simd_reduce_fn fn = ccl_simd_get_reduce_fn(impl_type, dtype, reduction);
+            if (!fn) {
+                /* no kernel, comp.cpp uses scalar loop */
+                continue;
+            }
+
+            for (auto count : elem_counts) {
+                std::vector<T> in(count), inout(count), expected(count);
+                fill(in, gen);
+                fill(inout, gen);
+
+                for (size_t idx = 0; idx < count; idx++)
+                    expected[idx] = reference_reduce(in[idx], inout[idx], reduction);
+
+                fn(in.data(), inout.data(), count);
+
+                for (size_t idx = 0; idx < count; idx++) {
+                    ASSERT_TRUE(is_same_value(expected[idx], inout[idx]))
+                        << "impl " << static_cast<int>(impl_type) << ", dtype "
+                        << static_cast<int>(dtype) << ", reduction "
+                        << static_cast<int>(reduction) << ", count " << count << ", idx "
+                        << idx << ", in " << +in[idx] << ", expected " << +expected[idx]
+                        << ", actual " << +inout[idx];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(simd_reduce, isa_detection) {
+    auto impl_types = ccl_simd_get_impl_types();
+    ASSERT_TRUE(impl_types.count(ccl_simd_scalar));
+    for (auto impl_type : { ccl_simd_avx2, ccl_simd_avx512 }) {
+        if (!impl_types.count(impl_type)) {
+            std::cout << "[  SKIPPED ] impl " << static_cast<int>(impl_type)
+                      << " is not supported by host\n";
+        }
+    }
+}
+
+TEST(simd_reduce, no_kernel_for_scalar_and_lp_types) {
+    for (auto reduction : reductions) {
+        EXPECT_EQ(ccl_simd_get_reduce_fn(ccl_simd_scalar, ccl::datatype::float32, reduction),
+                  nullptr);
+        for (auto impl_type : ccl_simd_get_impl_types()) {
+            EXPECT_EQ(ccl_simd_get_reduce_fn(impl_type, ccl::datatype::float16, reduction),
+                      nullptr);
+            EXPECT_EQ(ccl_simd_get_reduce_fn(impl_type, ccl::datatype::bfloat16, reduction),
+                      nullptr);
+        }
+    }
+}
+
+TEST(simd_reduce, int8) {
+    check_reduce<int8_t>(ccl::datatype::int8);
+}
+
+TEST(simd_reduce, uint8) {
+    check_reduce<uint8_t>(ccl::datatype::uint8);
+}
+
+TEST(simd_reduce, int16) {
+    check_reduce<int16_t>(ccl::datatype::int16);
+}
+
+TEST(simd_reduce, uint16) {
+    check_reduce<uint16_t>(ccl::datatype::uint16);
+}
+
+TEST(simd_reduce, int32) {
+    check_reduce<int32_t>(ccl::datatype::int32);
+}
+
+TEST(simd_reduce, uint32) {
+    check_reduce<uint32_t>(ccl::datatype::uint32);
+}
+
+TEST(simd_reduce, int64) {
+    check_reduce<int64_t>(ccl::datatype::int64);
+}
+
+TEST(simd_reduce, uint64) {
+    check_reduce<uint64_t>(ccl::datatype::uint64);
+}
+
+TEST(simd_reduce, float32) {
+    check_reduce<float>(ccl::datatype::float32);
+}
+
+TEST(simd_reduce, float64) {
+    check_reduce<double>(ccl::datatype::float64);
+}